@@ -0,0 +1,377 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <iterator>
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/CodeGenHelpers.h>
+#include <Kodgen/Misc/ILogger.h>
+#include <Kodgen/Misc/FundamentalTypes.h>
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Number every reflected struct/class of a project with a pre-order [begin, end) interval of the project class hierarchy,
+*	so that checking whether an object is an instance of a class is two integer comparisons, without dynamic_cast or walking parents:
+*		kodgen_hierarchy::isA<Base>(object);
+*
+*	The interval of a class depends on classes declared in other files, so the generated code only references
+*	KODGEN_HIERARCHY_BEGIN_<class> / KODGEN_HIERARCHY_END_<class> macros. They are defined in the KodgenClassHierarchy.h file
+*	written in the output directory by generateHierarchyFile, which must be called once the whole project is generated.
+*
+*	The hierarchy follows the first reflected parent of each class. A class is still an instance of its other parents,
+*	but isA only reports the first one.
+*	The index of a polymorphic object is read through a virtual method, which is only declared virtual by classes having a reflected
+*	virtual method (and overridden by their children), so that the layout of non-polymorphic classes is not changed.
+*	The generated members keep the access in effect at the class footer macro, they are only read by kodgen_hierarchy.
+*
+*	The classes of the files which are not parsed again by an incremental run are read from a manifest saved by the previous run.
+*	If it is missing, the project must be regenerated with forceRegenerateAll (see isManifestValid).
+*/
+class ClassHierarchyCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		/** Reflected struct/class as saved in the hierarchy manifest. */
+		struct ClassRecord
+		{
+			/** Identifier used to name the class interval macros. */
+			std::string					identifier;
+
+			/** Full name of the class. */
+			std::string					name;
+
+			/** Canonical names of the class parents, in declaration order. */
+			std::vector<std::string>	parents;
+
+			/** Read a record written by write, parents are the remaining words of the stream. */
+			bool read(std::istream& stream) noexcept
+			{
+				if (!(stream >> identifier >> name))
+				{
+					return false;
+				}
+
+				parents.assign(std::istream_iterator<std::string>(stream), std::istream_iterator<std::string>());
+
+				return true;
+			}
+
+			/** Write the record as "<identifier> <name> <parents...>". */
+			void write(std::ostream& stream) const noexcept
+			{
+				stream << identifier << " " << name;
+
+				for (std::string const& parent : parents)
+				{
+					stream << " " << parent;
+				}
+			}
+		};
+
+		/** Name of the header defining the interval of all classes, written in the generated files output directory. */
+		static constexpr char const*	_hierarchyFilename	= "KodgenClassHierarchy.h";
+
+		/** Classes of the project files, shared with the clones of this module since they generate the files of the project. */
+		GeneratorHelpers::AggregatedOutput<ClassRecord>	_classes{ "KodgenClassHierarchy.txt", "KodgenClassHierarchy 3" };
+
+		/**
+		*	@brief Check whether a struct/class can be numbered.
+		*
+		*	@param struct_ The struct/class to check.
+		*
+		*	@return true if the struct/class is part of the numbered hierarchy, else false.
+		*/
+		static bool isNumberedStructClass(kodgen::StructClassInfo const& struct_) noexcept
+		{
+			std::string fullName = struct_.getFullName();
+
+			//Class templates have no single interval, and anonymous namespace members can't be named from the hierarchy file
+			return !struct_.isForwardDeclaration && fullName.find_first_of("< (") == std::string::npos;
+		}
+
+	protected:
+		virtual bool initialGenerateHeaderFileHeaderCode(kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			std::vector<ClassRecord> classes;
+
+			env.getFileParsingResult()->foreachEntityOfType(kodgen::EEntityType::Struct | kodgen::EEntityType::Class,
+															[&classes](kodgen::EntityInfo const& entity)
+															{
+																kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+																if (isNumberedStructClass(struct_))
+																{
+																	ClassRecord& record = classes.emplace_back();
+
+																	record.identifier	= GeneratorHelpers::getIdentifier(struct_);
+																	record.name			= struct_.getFullName();
+
+																	for (kodgen::StructClassInfo::ParentInfo const& parent : struct_.parents)
+																	{
+																		std::string parentName = parent.type.getCanonicalName(true);
+
+																		//Template instances are never numbered
+																		if (parentName.find_first_of("< ") == std::string::npos)
+																		{
+																			record.parents.push_back(std::move(parentName));
+																		}
+																	}
+																}
+															});
+
+			bool hasNumberedClasses = !classes.empty();
+
+			_classes.record(env.getFileParsingResult()->parsedFile, std::move(classes));
+
+			if (!hasNumberedClasses)
+			{
+				return true;
+			}
+
+			std::string const& sep = env.getSeparator();
+
+			//Types shared by all generated headers, so they must be defined only once per translation unit
+			inout_result += "#ifndef KODGEN_CLASS_HIERARCHY_DEFINED" + sep +
+							"#define KODGEN_CLASS_HIERARCHY_DEFINED" + sep + sep +
+							"#include <cstdint>" + sep +
+							"#include <type_traits>" + sep + sep +
+							"#include \"" + _hierarchyFilename + "\"" + sep + sep +
+							"namespace kodgen_hierarchy" + sep +
+							"{" + sep +
+							"	//Pre-order numbering of a class subtree: begin is the index of the class, [begin + 1, end) the indices of its derived classes" + sep +
+							"	struct Interval" + sep +
+							"	{" + sep +
+							"		std::uint32_t	begin;" + sep +
+							"		std::uint32_t	end;" + sep + sep +
+							"		constexpr bool contains(std::uint32_t index) const noexcept { return index >= begin && index < end; }" + sep +
+							"	};" + sep + sep +
+							"	//Friend of all numbered classes, so that the generated code doesn't change the access of the members declared after the footer macro" + sep +
+							"	struct Access" + sep +
+							"	{" + sep +
+							"		template <typename T, typename = void>" + sep +
+							"		struct HasDynamicIndex : std::false_type {};" + sep + sep +
+							"		template <typename T>" + sep +
+							"		struct HasDynamicIndex<T, std::void_t<decltype(T::kodgenHasDynamicHierarchyIndex)>> : std::bool_constant<T::kodgenHasDynamicHierarchyIndex> {};" + sep + sep +
+							"		template <typename T>" + sep +
+							"		static constexpr Interval interval() noexcept { return T::kodgenHierarchyInterval; }" + sep + sep +
+							"		template <typename T>" + sep +
+							"		static constexpr std::uint32_t index(T const& object) noexcept { return object.kodgenHierarchyIndex(); }" + sep +
+							"	};" + sep + sep +
+							"	template <typename T>" + sep +
+							"	struct HasDynamicIndex : Access::HasDynamicIndex<T> {};" + sep + sep +
+							"	//Check whether object is an instance of Base or of a class derived from Base" + sep +
+							"	template <typename Base, typename T>" + sep +
+							"	constexpr bool isA(T const& object) noexcept" + sep +
+							"	{" + sep +
+							"		static_assert(!std::is_polymorphic_v<T> || HasDynamicIndex<T>::value, \"The hierarchy index of a polymorphic class must be virtual, reflect a virtual method of its root class.\");" + sep + sep +
+							"		return Access::interval<Base>().contains(Access::index(object));" + sep +
+							"	}" + sep +
+							"}" + sep + sep +
+							"#endif" + sep + sep;
+
+			return true;
+		}
+
+		virtual kodgen::ETraversalBehaviour generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			if (entity.entityType != kodgen::EEntityType::Struct && entity.entityType != kodgen::EEntityType::Class)
+			{
+				return kodgen::CodeGenHelpers::leastPrioritizedTraversalBehaviour;
+			}
+
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			if (!isNumberedStructClass(struct_))
+			{
+				return kodgen::ETraversalBehaviour::Recurse;
+			}
+
+			std::string identifier					= GeneratorHelpers::getIdentifier(struct_);
+			bool		hasReflectedVirtualMethod	= false;
+			std::string hasDynamicIndex;
+
+			for (kodgen::MethodInfo const& method : struct_.methods)
+			{
+				hasReflectedVirtualMethod |= method.isVirtual;
+			}
+
+			//The index method of a child overrides the index method of its parents if one of them declared it virtual
+			for (kodgen::StructClassInfo::ParentInfo const& parent : struct_.parents)
+			{
+				hasDynamicIndex += " || kodgen_hierarchy::HasDynamicIndex<" + parent.type.getCanonicalName() + ">::value";
+			}
+
+			//No access specifier is emitted so that the members declared after the class footer macro keep their access
+			inout_result += "friend struct kodgen_hierarchy::Access;" + env.getSeparator() +
+							"static constexpr kodgen_hierarchy::Interval kodgenHierarchyInterval = { KODGEN_HIERARCHY_BEGIN_" + identifier + ", KODGEN_HIERARCHY_END_" + identifier + " };" + env.getSeparator() +
+							"static constexpr bool kodgenHasDynamicHierarchyIndex = " + ((hasReflectedVirtualMethod) ? "true" : "false") + hasDynamicIndex + ";" + env.getSeparator() +
+							((hasReflectedVirtualMethod) ? "virtual " : "") + "std::uint32_t kodgenHierarchyIndex() const noexcept { return kodgenHierarchyInterval.begin; }" + env.getSeparator();
+
+			return kodgen::ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		virtual ClassHierarchyCGM* clone() const noexcept override
+		{
+			return new ClassHierarchyCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "ClassHierarchyCGM";
+		}
+
+		/**
+		*	@brief Check whether the manifest of the previous run can provide the classes of the files an incremental run doesn't parse.
+		*
+		*	@param outputDirectory Output directory of the project generated files.
+		*
+		*	@return true if the manifest exists and was written by this version of the module, else false (all files must be regenerated).
+		*/
+		bool isManifestValid(fs::path const& outputDirectory) const noexcept
+		{
+			GeneratorHelpers::AggregatedOutput<ClassRecord>::RecordsPerFile	classesPerFile;
+			std::string															properties;
+
+			return _classes.loadManifest(outputDirectory, classesPerFile, properties);
+		}
+
+		/**
+		*	@brief	Number the classes of a project and write the header defining their interval in its output directory.
+		*			Classes of the parsed files are the ones recorded during the run, other files keep the classes saved by the previous run.
+		*			The header is only written if an interval changed, so that unchanged hierarchies don't trigger a rebuild.
+		*
+		*	@param outputDirectory	Output directory of the project generated files.
+		*	@param parsedFiles		Files of the project which have been parsed during the run.
+		*	@param upToDateFiles	Files of the project which have not been parsed during the run since they were up-to-date.
+		*	@param logger			Logger used to report errors, can be nullptr.
+		*
+		*	@return true if the hierarchy header is up-to-date, else false (including when unparsed files have no saved classes).
+		*/
+		bool generateHierarchyFile(fs::path const&				outputDirectory,
+								   std::vector<fs::path> const&	parsedFiles,
+								   std::vector<fs::path> const&	upToDateFiles,
+								   kodgen::ILogger*				logger) const noexcept
+		{
+			GeneratorHelpers::AggregatedOutput<ClassRecord>::RecordsPerFile	classesPerFile;
+			std::string															properties;
+
+			if (!_classes.collectRecords(outputDirectory, parsedFiles, upToDateFiles, classesPerFile, properties))
+			{
+				if (logger != nullptr)
+				{
+					logger->log("The class hierarchy manifest of " + outputDirectory.string() + " is missing or outdated, the classes of the up-to-date files are unknown. Regenerate all files of the project.", kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//Attach each class to its first numbered parent, classes without numbered parent are roots of the hierarchy
+			std::map<std::string, ClassRecord const*>					classes;
+			std::map<std::string, std::vector<ClassRecord const*>>		children;
+			std::vector<ClassRecord const*>								roots;
+
+			for (auto const& [sourceFile, fileClasses] : classesPerFile)
+			{
+				for (ClassRecord const& record : fileClasses)
+				{
+					if (!classes.emplace(record.name, &record).second && logger != nullptr)
+					{
+						logger->log("Class " + record.name + " is declared in several files, only the first one is numbered.", kodgen::ILogger::ELogSeverity::Warning);
+					}
+				}
+			}
+
+			for (auto const& [name, record] : classes)
+			{
+				ClassRecord const*	primaryParent		= nullptr;
+				size_t				numberedParentCount	= 0u;
+
+				for (std::string const& parent : record->parents)
+				{
+					auto parentIt = classes.find(parent);
+
+					if (parentIt != classes.end())
+					{
+						primaryParent = (primaryParent == nullptr) ? parentIt->second : primaryParent;
+						numberedParentCount++;
+					}
+				}
+
+				if (numberedParentCount > 1u && logger != nullptr)
+				{
+					logger->log("Class " + name + " has several reflected parents, isA only follows " + primaryParent->name + ".", kodgen::ILogger::ELogSeverity::Warning);
+				}
+
+				if (primaryParent != nullptr)
+				{
+					children[primaryParent->name].push_back(record);
+				}
+				else
+				{
+					roots.push_back(record);
+				}
+			}
+
+			//Pre-order numbering: the begin index of a class is its position in numberedClasses.
+			//Children are visited in name order so that numbers don't depend on the parsing order.
+			std::vector<ClassRecord const*>	numberedClasses;
+			std::vector<kodgen::uint32>		endIndices;
+
+			auto numberSubtree = [&](ClassRecord const& record, auto& numberSubtreeRef) -> void
+			{
+				size_t beginIndex = numberedClasses.size();
+
+				numberedClasses.push_back(&record);
+				endIndices.emplace_back();
+
+				auto childrenIt = children.find(record.name);
+
+				if (childrenIt != children.end())
+				{
+					for (ClassRecord const* child : childrenIt->second)
+					{
+						numberSubtreeRef(*child, numberSubtreeRef);
+					}
+				}
+
+				endIndices[beginIndex] = static_cast<kodgen::uint32>(numberedClasses.size());
+			};
+
+			for (ClassRecord const* root : roots)
+			{
+				numberSubtree(*root, numberSubtree);
+			}
+
+			std::string const	sep						= "\n";
+			std::string			hierarchyDefinitions;
+
+			for (size_t i = 0u; i < numberedClasses.size(); i++)
+			{
+				std::string const& identifier = numberedClasses[i]->identifier;
+
+				hierarchyDefinitions += "#define KODGEN_HIERARCHY_BEGIN_" + identifier + " " + std::to_string(i) + "u" + sep +
+										"#define KODGEN_HIERARCHY_END_" + identifier + " " + std::to_string(endIndices[i]) + "u" + sep;
+			}
+
+			std::string hierarchyFileContent =	"#pragma once" + sep + sep +
+												"//Pre-order [begin, end) interval of each reflected class in the project class hierarchy, generated by ClassHierarchyCGM" + sep + sep +
+												hierarchyDefinitions;
+
+			if (!GeneratorHelpers::writeFileIfChanged(outputDirectory / _hierarchyFilename, hierarchyFileContent, logger))
+			{
+				return false;
+			}
+
+			if (!_classes.saveManifest(outputDirectory, classesPerFile, properties) && logger != nullptr)
+			{
+				logger->log("Could not save the class hierarchy manifest in " + outputDirectory.string() + ", the next incremental run will require regenerating all files.", kodgen::ILogger::ELogSeverity::Warning);
+			}
+
+			return true;
+		}
+};
\ No newline at end of file
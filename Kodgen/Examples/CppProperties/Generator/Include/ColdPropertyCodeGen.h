@@ -0,0 +1,273 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h"
+#include "Kodgen/Parsing/ParsingSettings.h"	//ParsingSettings::parsingMacro
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Move rarely accessed fields out of a struct/class into a separately allocated side struct,
+*	so that the fields used in hot paths stay densely packed.
+*
+*	Cold fields must only be visible to the parser, their storage is generated:
+*
+*	#ifdef KODGEN_PARSING
+*		KGField(Cold)
+*		std::string debugName;
+*	#endif
+*
+*	The class footer then declares the side struct, a single pointer to it,
+*	and accessors named after the cold fields (debugName() in the previous example), with the access of their field.
+*	The side struct is allocated on the first non-const access, moves only transfer it.
+*	Cold fields are value initialized since default member initializers are not forwarded.
+*/
+class ColdPropertyCodeGen : public kodgen::MacroPropertyCodeGen
+{
+	private:
+		/**
+		*	@brief Check whether the provided field is tagged with the Cold property.
+		*
+		*	@param field The field to check.
+		*
+		*	@return true if the field is cold, else false.
+		*/
+		bool isColdField(kodgen::FieldInfo const& field) const noexcept
+		{
+			return std::any_of(field.properties.cbegin(), field.properties.cend(), [this](kodgen::Property const& property) { return property.name == getPropertyName(); });
+		}
+
+		/**
+		*	@brief Collect all cold fields of a struct/class.
+		*
+		*	@param struct_ The struct/class.
+		*
+		*	@return All cold fields in declaration order.
+		*/
+		std::vector<kodgen::FieldInfo const*> getColdFields(kodgen::StructClassInfo const& struct_) const noexcept
+		{
+			std::vector<kodgen::FieldInfo const*> result;
+
+			for (kodgen::FieldInfo const& field : struct_.fields)
+			{
+				if (isColdField(field))
+				{
+					result.push_back(&field);
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		*	@brief	Check whether the provided field is the first cold field of its outer struct/class.
+		*			Code common to all cold fields of a struct/class is generated for this field only.
+		*
+		*	@param field The field to check.
+		*
+		*	@return true if the field is the first cold field of its outer struct/class, else false.
+		*/
+		bool isFirstColdField(kodgen::FieldInfo const& field) const noexcept
+		{
+			std::vector<kodgen::FieldInfo const*> coldFields = getColdFields(static_cast<kodgen::StructClassInfo const&>(*field.outerEntity));
+
+			return !coldFields.empty() && coldFields.front() == &field;
+		}
+
+		/**
+		*	@brief Get the name of the macro containing the cold fields storage and accessors of a struct/class.
+		*
+		*	@param struct_ The struct/class.
+		*
+		*	@return The macro name.
+		*/
+		static std::string getColdFieldsMacroName(kodgen::StructClassInfo const& struct_) noexcept
+		{
+			return GeneratorHelpers::getIdentifier(struct_) + "_COLD_FIELDS";
+		}
+
+		/**
+		*	@brief	Compute the size a struct/class would have once its cold fields are replaced by a single pointer,
+		*			by laying out the remaining fields in declaration order.
+		*
+		*	@param struct_ The struct/class.
+		*
+		*	@return The computed size in bytes, or 0 if the size of a field could not be computed.
+		*/
+		size_t computeHotSize(kodgen::StructClassInfo const& struct_) const noexcept
+		{
+			size_t	size			= 0u;
+			size_t	maxAlignment	= alignof(void*);
+			bool	isFirstField	= true;
+
+			for (kodgen::FieldInfo const& field : struct_.fields)
+			{
+				if (field.isStatic)
+				{
+					continue;
+				}
+				else if (isFirstField)
+				{
+					//Everything before the first field (base classes, vtable pointer) is left untouched
+					size			= static_cast<size_t>(field.memoryOffset);
+					isFirstField	= false;
+				}
+
+				if (!isColdField(field))
+				{
+					if (field.type.sizeInBytes == 0u || field.type.alignment == 0u)
+					{
+						return 0u;
+					}
+
+					size			= GeneratorHelpers::alignUp(size, field.type.alignment) + field.type.sizeInBytes;
+					maxAlignment	= std::max(maxAlignment, field.type.alignment);
+				}
+			}
+
+			//Pointer to the side struct
+			size = GeneratorHelpers::alignUp(size, alignof(void*)) + sizeof(void*);
+
+			return GeneratorHelpers::alignUp(size, maxAlignment);
+		}
+
+	public:
+		ColdPropertyCodeGen() noexcept:
+			kodgen::MacroPropertyCodeGen("Cold", kodgen::EEntityType::Field)
+		{}
+
+		virtual bool preGenerateCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */, kodgen::MacroCodeGenEnv& env) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			std::string errorMessage;
+
+			if (!property.arguments.empty())
+			{
+				errorMessage = "Cold property doesn't take any argument.";
+			}
+			else if (field.isStatic)
+			{
+				errorMessage = "Cold property can't be used on the static field " + field.getFullName() + " since it is not part of the object layout.";
+			}
+			else if (field.type.typeParts.front().descriptor & (kodgen::ETypeDescriptor::LRef | kodgen::ETypeDescriptor::RRef))
+			{
+				errorMessage = "Cold property can't be used on the reference field " + field.getFullName() + ".";
+			}
+
+			if (!errorMessage.empty())
+			{
+				//Log error message and abort generation
+				if (env.getLogger() != nullptr)
+				{
+					env.getLogger()->log(errorMessage, kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//Report the hot path size change once per struct/class
+			if (env.getLogger() != nullptr && isFirstColdField(field))
+			{
+				kodgen::StructClassInfo const&	struct_	= static_cast<kodgen::StructClassInfo const&>(*field.outerEntity);
+				size_t							hotSize	= computeHotSize(struct_);
+
+				env.getLogger()->log(struct_.getFullName() + " hot path size: " + std::to_string(struct_.type.sizeInBytes) + " bytes before cold fields split, " +
+									 ((hotSize != 0u) ? std::to_string(hotSize) + " bytes" : "unknown") + " after moving " + std::to_string(getColdFields(struct_).size()) + " cold field(s).",
+									 kodgen::ILogger::ELogSeverity::Info);
+			}
+
+			return true;
+		}
+
+		virtual bool generateHeaderFileHeaderCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			if (!isFirstColdField(field))
+			{
+				return true;
+			}
+
+			kodgen::StructClassInfo const&	struct_		= static_cast<kodgen::StructClassInfo const&>(*field.outerEntity);
+			std::string const&				sep			= env.getSeparator();
+			std::string						macroName	= getColdFieldsMacroName(struct_);
+
+			//The class footer macro is expanded while parsing too, where cold fields are still declared in the class:
+			//the storage and accessors must only exist in the compiled code to avoid name clashes
+			//Cold fields are allocated on first access, so that moves only steal the pointer and never allocate
+			inout_result += "#include <memory>" + sep + sep +
+							"#ifdef " + kodgen::ParsingSettings::parsingMacro + sep +
+							"	#define " + macroName + sep +
+							"#else" + sep +
+							"	#define " + macroName + " \\" + sep +
+							"	private: \\" + sep +
+							"		struct ColdFields \\" + sep +
+							"		{ \\" + sep +
+							"			template <typename T> using Type = T; \\" + sep;
+
+			std::vector<kodgen::FieldInfo const*> coldFields = getColdFields(struct_);
+
+			for (kodgen::FieldInfo const* coldField : coldFields)
+			{
+				inout_result += "			Type<" + coldField->type.getCanonicalName() + "> " + coldField->name + "{}; \\" + sep;
+			}
+
+			inout_result += "		}; \\" + sep +
+							"		struct ColdFieldsHolder \\" + sep +
+							"		{ \\" + sep +
+							"			std::unique_ptr<ColdFields> ptr; \\" + sep +
+							"			ColdFieldsHolder() = default; \\" + sep +
+							"			ColdFieldsHolder(ColdFieldsHolder const& other): ptr{other.ptr ? std::make_unique<ColdFields>(*other.ptr) : nullptr} {} \\" + sep +
+							"			ColdFieldsHolder(ColdFieldsHolder&&) noexcept = default; \\" + sep +
+							"			ColdFieldsHolder& operator=(ColdFieldsHolder const& other) \\" + sep +
+							"			{ \\" + sep +
+							"				if (this != &other) { if (other.ptr) get() = *other.ptr; else ptr.reset(); } \\" + sep +
+							"				return *this; \\" + sep +
+							"			} \\" + sep +
+							"			ColdFieldsHolder& operator=(ColdFieldsHolder&&) noexcept = default; \\" + sep +
+							"			ColdFields& get() { if (!ptr) ptr = std::make_unique<ColdFields>(); return *ptr; } \\" + sep +
+							"			ColdFields const& get() const noexcept { static ColdFields const defaultFields{}; return ptr ? *ptr : defaultFields; } \\" + sep +
+							"		}; \\" + sep +
+							"		ColdFieldsHolder _kodgenColdFields; \\" + sep;
+
+			//Accessors get the access of their cold field, then the access in effect at the class footer macro is restored
+			for (kodgen::FieldInfo const* coldField : coldFields)
+			{
+				std::string const& name = coldField->name;
+
+				inout_result += "	" + GeneratorHelpers::getAccessSpecifierCode(coldField->accessSpecifier) + " \\" + sep +
+								"		decltype(ColdFields::" + name + ")& " + name + "() { return _kodgenColdFields.get()." + name + "; } \\" + sep +
+								"		decltype(ColdFields::" + name + ") const& " + name + "() const noexcept { return _kodgenColdFields.get()." + name + "; } \\" + sep;
+			}
+
+			inout_result += "	" + GeneratorHelpers::getAccessSpecifierCode(env.getClassFooterAccessSpecifier(struct_)) + sep +
+							"#endif" + sep;
+
+			return true;
+		}
+
+		virtual bool generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+													  kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			if (isFirstColdField(field))
+			{
+				inout_result += getColdFieldsMacroName(static_cast<kodgen::StructClassInfo const&>(*field.outerEntity)) + env.getSeparator();
+			}
+
+			return true;
+		}
+};
\ No newline at end of file
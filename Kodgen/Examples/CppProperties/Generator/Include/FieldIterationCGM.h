@@ -0,0 +1,379 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/CodeGenHelpers.h>
+#include <Kodgen/Misc/Filesystem.h>
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Generate compile-time field lists for every reflected struct/class.
+*
+*	Each struct/class gets a static constexpr kodgenFields() method returning a tuple of field descriptors
+*	(name, member pointer and properties), which can be iterated with:
+*		kodgen_fields::for_each_field(object, [](auto const& field, auto& value) { ... });
+*		kodgen_fields::apply_fields(object, [](auto&... values) { ... });
+*
+*	The method keeps the access in effect at the class footer macro, use kodgen_fields::get_fields<T>() to get the descriptors.
+*
+*	Since the field list is a tuple, generic algorithms are fully unrolled and inlined by the compiler.
+*	Static fields, references, bit-fields and cold fields have no member pointer and are not listed.
+*
+*	If shouldPoolStrings is true, all names and property strings of a file are stored in a single constexpr char pool
+*	of length-prefixed entries, and descriptors only store offsets in the pool: they don't need any dynamic relocation.
+*/
+class FieldIterationCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		/** Name of the property moving a field storage outside of the object (see ColdPropertyCodeGen). */
+		static inline std::string const	coldPropertyName	= "Cold";
+
+		/** Maximum length of a pooled string, stored in a 2 bytes prefix. */
+		static constexpr size_t			maxPooledStringLength	= 0xFFFF;
+
+		/** Name of the string pool of the file being generated, empty if strings are not pooled. */
+		std::string								_stringPoolName;
+
+		/** Offset of each string in the string pool of the file being generated. */
+		std::unordered_map<std::string, uint32_t>	_stringPoolOffsets;
+
+		/**
+		*	@brief Check whether a member pointer can be generated for the provided field.
+		*
+		*	@param field The field to check.
+		*
+		*	@return true if the field can be iterated, else false.
+		*/
+		static bool isIterableField(kodgen::FieldInfo const& field) noexcept
+		{
+			//Static fields, references and cold fields are not stored in the object, and bit-fields can't be pointed to
+			return !field.isStatic &&
+				   !field.isBitField &&
+				   !(field.type.typeParts.front().descriptor & (kodgen::ETypeDescriptor::LRef | kodgen::ETypeDescriptor::RRef)) &&
+				   std::none_of(field.properties.cbegin(), field.properties.cend(), [](kodgen::Property const& property) { return property.name == coldPropertyName; });
+		}
+
+		/**
+		*	@brief Join the arguments of a property the way they are written in the source code.
+		*
+		*	@param property The property.
+		*
+		*	@return The joined arguments.
+		*/
+		static std::string joinArguments(kodgen::Property const& property) noexcept
+		{
+			std::string result;
+
+			for (size_t i = 0u; i < property.arguments.size(); i++)
+			{
+				result += ((i == 0u) ? "" : ", ") + property.arguments[i];
+			}
+
+			return result;
+		}
+
+		/**
+		*	@brief	Get a deterministic identifier of the pool of a file, unique among all generated files.
+		*			It only depends on the path of the file relative to the output directory, so that it doesn't change with the checkout location.
+		*
+		*	@param parsedFile		Path to the parsed file.
+		*	@param outputDirectory	Output directory of the generated files.
+		*
+		*	@return The name of the pool variable.
+		*/
+		static std::string getStringPoolName(fs::path const& parsedFile, fs::path const& outputDirectory) noexcept
+		{
+			std::string	path = parsedFile.lexically_normal().lexically_relative(outputDirectory.lexically_normal()).generic_string();
+			std::string	stem = parsedFile.stem().string();
+			uint32_t	hash = 2166136261u;
+
+			//Files with the same name in different directories must not share the same pool
+			for (char character : path)
+			{
+				hash = (hash ^ static_cast<unsigned char>(character)) * 16777619u;
+			}
+
+			std::replace_if(stem.begin(), stem.end(), [](char character) { return !std::isalnum(static_cast<unsigned char>(character)); }, '_');
+
+			return "kodgen_string_pool_" + stem + "_" + std::to_string(hash);
+		}
+
+		/**
+		*	@brief Generate the C++ expression of a field descriptor string.
+		*
+		*	@param string The string.
+		*
+		*	@return A string literal, or a pooled string if strings are pooled.
+		*/
+		std::string generateString(std::string const& string) const noexcept
+		{
+			auto it = _stringPoolOffsets.find(string);
+
+			if (it == _stringPoolOffsets.cend())
+			{
+				std::string literal;
+
+				for (char character : string)
+				{
+					GeneratorHelpers::appendEscapedCharacter(character, literal);
+				}
+
+				return "\"" + literal + "\"";
+			}
+
+			return "String{ " + std::to_string(it->second) + "u }";
+		}
+
+		/**
+		*	@brief Generate the C++ initializer of a field properties array.
+		*
+		*	@param field The field.
+		*
+		*	@return The initializer.
+		*/
+		std::string generatePropertiesInitializer(kodgen::FieldInfo const& field) const noexcept
+		{
+			std::string result = "{";
+
+			for (size_t i = 0u; i < field.properties.size(); i++)
+			{
+				result += ((i == 0u) ? " " : ", ") + std::string("Property{ ") + generateString(field.properties[i].name) + ", " + generateString(joinArguments(field.properties[i])) + " }";
+			}
+
+			return result + " }";
+		}
+
+		/**
+		*	@brief	Generate the string pool of a file, containing the names and properties of all iterable fields.
+		*			Identical strings are stored once.
+		*
+		*	@param env				Generation environment.
+		*	@param inout_result		String the pool definition is appended to.
+		*
+		*	@return false if a string is too long to be pooled, else true.
+		*/
+		bool generateStringPool(kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept
+		{
+			std::string	pool;
+			uint32_t	poolSize	= 0u;
+			bool		result		= true;
+
+			auto addString = [this, &pool, &poolSize, &result, &env](std::string const& string)
+			{
+				if (string.size() > maxPooledStringLength)
+				{
+					if (env.getLogger() != nullptr)
+					{
+						env.getLogger()->log("FieldIterationCGM: can't pool a string of " + std::to_string(string.size()) + " characters.", kodgen::ILogger::ELogSeverity::Error);
+					}
+
+					result = false;
+				}
+				else if (_stringPoolOffsets.emplace(string, poolSize).second)
+				{
+					GeneratorHelpers::appendEscapedCharacter(static_cast<char>(string.size() & 0xFF), pool);
+					GeneratorHelpers::appendEscapedCharacter(static_cast<char>(string.size() >> 8), pool);
+
+					for (char character : string)
+					{
+						GeneratorHelpers::appendEscapedCharacter(character, pool);
+					}
+
+					poolSize += static_cast<uint32_t>(string.size()) + 2u;
+				}
+			};
+
+			env.getFileParsingResult()->foreachEntityOfType(kodgen::EEntityType::Struct | kodgen::EEntityType::Class,
+															[&addString](kodgen::EntityInfo const& entity)
+															{
+																for (kodgen::FieldInfo const& field : static_cast<kodgen::StructClassInfo const&>(entity).fields)
+																{
+																	if (isIterableField(field))
+																	{
+																		addString(field.name);
+
+																		for (kodgen::Property const& property : field.properties)
+																		{
+																			addString(property.name);
+																			addString(joinArguments(property));
+																		}
+																	}
+																}
+															});
+
+			if (_stringPoolOffsets.empty())
+			{
+				//No field to describe, footers don't reference the pool
+				_stringPoolName.clear();
+			}
+			else
+			{
+				inout_result += "inline constexpr char " + _stringPoolName + "[] = \"" + pool + "\";" + env.getSeparator() + env.getSeparator();
+			}
+
+			return result;
+		}
+
+	protected:
+		virtual bool initialGenerateHeaderFileHeaderCode(kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			bool containsStructClass = false;
+
+			env.getFileParsingResult()->foreachEntityOfType(kodgen::EEntityType::Struct | kodgen::EEntityType::Class,
+															[&containsStructClass](kodgen::EntityInfo const& entity)
+															{
+																containsStructClass |= !static_cast<kodgen::StructClassInfo const&>(entity).isForwardDeclaration;
+															});
+
+			_stringPoolName.clear();
+			_stringPoolOffsets.clear();
+
+			if (!containsStructClass)
+			{
+				return true;
+			}
+
+			std::string const& sep = env.getSeparator();
+
+			//Types shared by all generated headers, so they must be defined only once per translation unit
+			inout_result += "#ifndef KODGEN_FIELD_ITERATION_DEFINED" + sep +
+							"#define KODGEN_FIELD_ITERATION_DEFINED" + sep + sep +
+							"#include <array>" + sep +
+							"#include <tuple>" + sep +
+							"#include <cstddef>" + sep +
+							"#include <cstdint>" + sep +
+							"#include <utility>" + sep +
+							"#include <string_view>" + sep +
+							"#include <type_traits>" + sep + sep +
+							"namespace kodgen_fields" + sep +
+							"{" + sep +
+							"	//Length-prefixed string of a constexpr char pool, only the offset is stored so that descriptors don't need any relocation" + sep +
+							"	template <char const* Pool>" + sep +
+							"	struct PooledString" + sep +
+							"	{" + sep +
+							"		std::uint32_t offset;" + sep + sep +
+							"		constexpr std::string_view view() const noexcept" + sep +
+							"		{" + sep +
+							"			return std::string_view(Pool + offset + 2u, static_cast<std::size_t>(static_cast<unsigned char>(Pool[offset])) | (static_cast<std::size_t>(static_cast<unsigned char>(Pool[offset + 1u])) << 8u));" + sep +
+							"		}" + sep + sep +
+							"		constexpr operator std::string_view() const noexcept { return view(); }" + sep +
+							"	};" + sep + sep +
+							"	template <typename Stream, char const* Pool>" + sep +
+							"	Stream& operator<<(Stream& stream, PooledString<Pool> const& string) { return stream << string.view(); }" + sep + sep +
+							"	template <typename StringType = std::string_view>" + sep +
+							"	struct BasicProperty" + sep +
+							"	{" + sep +
+							"		using String = StringType;" + sep + sep +
+							"		StringType	name;" + sep +
+							"		StringType	arguments;" + sep +
+							"	};" + sep + sep +
+							"	using Property = BasicProperty<>;" + sep + sep +
+							"	template <typename ClassType, typename FieldType, std::size_t PropertyCount, typename StringType = std::string_view>" + sep +
+							"	struct Field" + sep +
+							"	{" + sep +
+							"		using Class	= ClassType;" + sep +
+							"		using Type	= FieldType;" + sep + sep +
+							"		StringType												name;" + sep +
+							"		FieldType ClassType::*									pointer;" + sep +
+							"		std::array<BasicProperty<StringType>, PropertyCount>	properties;" + sep +
+							"	};" + sep + sep +
+							"	//The string type is deduced from the properties only" + sep +
+							"	template <typename ClassType, typename FieldType, std::size_t PropertyCount, typename StringType>" + sep +
+							"	constexpr Field<ClassType, FieldType, PropertyCount, StringType> makeField(typename BasicProperty<StringType>::String name, FieldType ClassType::* pointer, std::array<BasicProperty<StringType>, PropertyCount> const& properties) noexcept" + sep +
+							"	{" + sep +
+							"		return Field<ClassType, FieldType, PropertyCount, StringType>{ name, pointer, properties };" + sep +
+							"	}" + sep + sep +
+							"	//Friend of all reflected classes, so that the generated code doesn't change the access of the members declared after the footer macro" + sep +
+							"	struct Access" + sep +
+							"	{" + sep +
+							"		template <typename T>" + sep +
+							"		static constexpr auto fields() noexcept { return T::kodgenFields(); }" + sep +
+							"	};" + sep + sep +
+							"	//Get the tuple of the reflected field descriptors of T" + sep +
+							"	template <typename T>" + sep +
+							"	constexpr auto get_fields() noexcept" + sep +
+							"	{" + sep +
+							"		return Access::fields<std::remove_const_t<T>>();" + sep +
+							"	}" + sep + sep +
+							"	//Call visitor(fieldDescriptor, fieldValue) on each reflected field of object" + sep +
+							"	template <typename T, typename Visitor>" + sep +
+							"	constexpr void for_each_field(T& object, Visitor&& visitor)" + sep +
+							"	{" + sep +
+							"		std::apply([&object, &visitor](auto const&... fields) { (visitor(fields, object.*(fields.pointer)), ...); }, get_fields<T>());" + sep +
+							"	}" + sep + sep +
+							"	//Call visitor(fieldValues...) once with all reflected fields of object" + sep +
+							"	template <typename T, typename Visitor>" + sep +
+							"	constexpr decltype(auto) apply_fields(T& object, Visitor&& visitor)" + sep +
+							"	{" + sep +
+							"		return std::apply([&object, &visitor](auto const&... fields) -> decltype(auto) { return visitor(object.*(fields.pointer)...); }, get_fields<T>());" + sep +
+							"	}" + sep +
+							"}" + sep + sep +
+							"#endif" + sep + sep;
+
+			if (shouldPoolStrings)
+			{
+				_stringPoolName = getStringPoolName(env.getFileParsingResult()->parsedFile, env.getSettings()->getOutputDirectory());
+
+				return generateStringPool(env, inout_result);
+			}
+
+			return true;
+		}
+
+		virtual kodgen::ETraversalBehaviour generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			if (entity.entityType != kodgen::EEntityType::Struct && entity.entityType != kodgen::EEntityType::Class)
+			{
+				return kodgen::CodeGenHelpers::leastPrioritizedTraversalBehaviour;
+			}
+
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			if (struct_.isForwardDeclaration)
+			{
+				return kodgen::ETraversalBehaviour::Recurse;
+			}
+
+			//Use the injected class name so that it also works for nested classes and class templates
+			std::string className = struct_.name.substr(0u, struct_.name.find('<'));
+			std::string fields;
+
+			for (kodgen::FieldInfo const& field : struct_.fields)
+			{
+				if (isIterableField(field))
+				{
+					fields += ((fields.empty()) ? "" : ", ") + std::string("kodgen_fields::makeField(") + generateString(field.name) + ", &" + className + "::" + field.name +
+							  ", std::array<Property, " + std::to_string(field.properties.size()) + ">" + generatePropertiesInitializer(field) + ")";
+				}
+			}
+
+			std::string stringType = (_stringPoolName.empty()) ? "std::string_view" : "kodgen_fields::PooledString<" + _stringPoolName + ">";
+
+			inout_result += "friend struct kodgen_fields::Access;" + env.getSeparator() +
+							"static constexpr auto kodgenFields() noexcept { using String = " + stringType + "; using Property = kodgen_fields::BasicProperty<String>; return std::make_tuple(" + fields + "); }" + env.getSeparator();
+
+			return kodgen::ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		/** Should the names and property strings of each file be stored in a single string pool? */
+		bool	shouldPoolStrings	= false;
+
+		virtual FieldIterationCGM* clone() const noexcept override
+		{
+			return new FieldIterationCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "FieldIterationCGM";
+		}
+};
\ No newline at end of file
@@ -0,0 +1,344 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <unordered_map>
+
+#include "Kodgen/InfoStructures/EntityInfo.h"
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/EAccessSpecifier.h"
+
+namespace GeneratorHelpers
+{
+	/**
+	*	@brief	Get a valid C++ identifier uniquely identifying the provided entity, built from its full name.
+	*			Underscores are escaped as _1 and scope separators as _0, so that a::b_c and a_b::c don't collide.
+	*
+	*	@param entity The entity.
+	*
+	*	@return The identifier.
+	*/
+	inline std::string getIdentifier(kodgen::EntityInfo const& entity) noexcept
+	{
+		std::string fullName = entity.getFullName();
+		std::string result;
+
+		result.reserve(fullName.size() + fullName.size() / 4u);
+
+		for (std::string::size_type i = 0u; i < fullName.size(); i++)
+		{
+			if (fullName[i] == '_')
+			{
+				result += "_1";
+			}
+			else if (fullName.compare(i, 2u, "::") == 0)
+			{
+				result += "_0";
+				i++;
+			}
+			else
+			{
+				result += fullName[i];
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	*	@brief Get the code switching to the provided access, to restore it at the end of class footer code changing the access.
+	*
+	*	@param accessSpecifier The access specifier, see MacroCodeGenEnv::getClassFooterAccessSpecifier.
+	*
+	*	@return The access specifier followed by a colon.
+	*/
+	inline std::string getAccessSpecifierCode(kodgen::EAccessSpecifier accessSpecifier) noexcept
+	{
+		switch (accessSpecifier)
+		{
+			case kodgen::EAccessSpecifier::Protected:
+				return "protected:";
+
+			case kodgen::EAccessSpecifier::Private:
+				return "private:";
+
+			default:
+				return "public:";
+		}
+	}
+
+	/**
+	*	@brief Append a character to a C++ string literal, escaping it if necessary.
+	*
+	*	@param character		The character to append.
+	*	@param inout_literal	Content of the string literal.
+	*/
+	inline void appendEscapedCharacter(char character, std::string& inout_literal) noexcept
+	{
+		unsigned char value = static_cast<unsigned char>(character);
+
+		if (value >= 0x20 && value < 0x7F && character != '"' && character != '\\')
+		{
+			inout_literal += character;
+		}
+		else
+		{
+			//Octal escapes have at most 3 digits, so the next character can't be absorbed by the escape sequence
+			inout_literal += { '\\', static_cast<char>('0' + (value >> 6)), static_cast<char>('0' + ((value >> 3) & 7)), static_cast<char>('0' + (value & 7)) };
+		}
+	}
+
+	/**
+	*	@brief Round a size up to the next multiple of the provided alignment.
+	*
+	*	@param size			The size to round.
+	*	@param alignment	The alignment, must not be 0.
+	*
+	*	@return The rounded size.
+	*/
+	inline size_t alignUp(size_t size, size_t alignment) noexcept
+	{
+		return (size + alignment - 1u) / alignment * alignment;
+	}
+
+	/**
+	*	@brief Write a file, only if its content changed so that unchanged files don't trigger a rebuild.
+	*
+	*	@param path		Path to the file.
+	*	@param content	Content of the file.
+	*	@param logger	Logger used to report errors, can be nullptr.
+	*
+	*	@return true if the file is up-to-date, else false.
+	*/
+	inline bool writeFileIfChanged(fs::path const& path, std::string const& content, kodgen::ILogger* logger) noexcept
+	{
+		std::string previousContent;
+
+		{
+			std::ifstream previousFile(path, std::ios::binary);
+
+			previousContent.assign(std::istreambuf_iterator<char>(previousFile), std::istreambuf_iterator<char>());
+		}
+
+		if (previousContent == content)
+		{
+			return true;
+		}
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+		if (!(file << content))
+		{
+			if (logger != nullptr)
+			{
+				logger->log("Could not write the generated file " + path.string(), kodgen::ILogger::ELogSeverity::Error);
+			}
+
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	*	Records of a project aggregated into files written once the whole project is generated (see ClassHierarchyCGM and TypeRegistryCGM).
+	*	Records are collected per source file by all the clones of a module, which share the same recorded records.
+	*	Files which are not parsed again by incremental runs keep the records saved in a manifest by the previous run.
+	*
+	*	The manifest is a text file: the manifest header line, a "P <properties>" line, then "F <source file>" lines
+	*	each followed by a "R <record>" line per record of the file.
+	*	Record must provide:
+	*		bool read(std::istream& stream);		Read the record written by write, return false if it is invalid.
+	*		void write(std::ostream& stream) const;	Write the record on a single line.
+	*/
+	template <typename Record>
+	class AggregatedOutput
+	{
+		public:
+			using RecordsPerFile = std::map<std::string, std::vector<Record>>;
+
+		private:
+			/** Records recorded by all the clones of a module during a run, indexed by source file. */
+			struct RecordedRecords
+			{
+				std::mutex												mutex;
+				std::unordered_map<std::string, std::vector<Record>>	recordsPerFile;
+			};
+
+			/** Name of the manifest, in the generated files output directory. */
+			char const*							_manifestFilename;
+
+			/** First line of the manifest. Manifests with another header are discarded. */
+			char const*							_manifestHeader;
+
+			/** Recorded records, shared by the copies of this object. */
+			std::shared_ptr<RecordedRecords>	_recordedRecords	= std::make_shared<RecordedRecords>();
+
+		public:
+			AggregatedOutput(char const* manifestFilename, char const* manifestHeader) noexcept:
+				_manifestFilename{manifestFilename},
+				_manifestHeader{manifestHeader}
+			{
+			}
+
+			/**
+			*	@brief Record the records of a generated source file. Files generated several times keep the records of their last generation.
+			*
+			*	@param sourceFile	Path to the source file.
+			*	@param records		Records of the source file.
+			*/
+			void record(fs::path const& sourceFile, std::vector<Record>&& records) const noexcept
+			{
+				std::lock_guard<std::mutex> lock(_recordedRecords->mutex);
+
+				_recordedRecords->recordsPerFile[sourceFile.string()] = std::move(records);
+			}
+
+			/**
+			*	@brief	Collect the records of all the files of a project.
+			*			Records of the parsed files are the ones recorded during the run, other files keep the records saved by the previous run.
+			*			Removed files and files without records are left out.
+			*
+			*	@param outputDirectory		Output directory of the project generated files, containing the manifest.
+			*	@param parsedFiles			Files of the project which have been parsed during the run.
+			*	@param upToDateFiles		Files of the project which have not been parsed during the run since they were up-to-date.
+			*	@param out_recordsPerFile	Records of the project, indexed by source file.
+			*	@param out_properties		Properties saved by the previous run, left untouched if there is no manifest.
+			*
+			*	@return	false if some files were not parsed and there is no valid manifest to provide their records
+			*			(the project must be regenerated with forceRegenerateAll), else true.
+			*/
+			bool collectRecords(fs::path const&					outputDirectory,
+								std::vector<fs::path> const&	parsedFiles,
+								std::vector<fs::path> const&	upToDateFiles,
+								RecordsPerFile&					out_recordsPerFile,
+								std::string&					out_properties)	const	noexcept
+			{
+				if (!loadManifest(outputDirectory, out_recordsPerFile, out_properties) && !upToDateFiles.empty())
+				{
+					return false;
+				}
+
+				//Removed files don't contribute anymore
+				for (auto it = out_recordsPerFile.begin(); it != out_recordsPerFile.end();)
+				{
+					std::error_code errorCode;
+
+					it = (fs::exists(it->first, errorCode)) ? std::next(it) : out_recordsPerFile.erase(it);
+				}
+
+				std::lock_guard<std::mutex> lock(_recordedRecords->mutex);
+
+				for (fs::path const& parsedFile : parsedFiles)
+				{
+					auto recordedIt = _recordedRecords->recordsPerFile.find(parsedFile.string());
+
+					if (recordedIt != _recordedRecords->recordsPerFile.end() && !recordedIt->second.empty())
+					{
+						out_recordsPerFile[parsedFile.string()] = recordedIt->second;
+					}
+					else
+					{
+						out_recordsPerFile.erase(parsedFile.string());
+					}
+				}
+
+				return true;
+			}
+
+			/**
+			*	@brief Load the records saved in the manifest of the previous run.
+			*
+			*	@param outputDirectory		Directory containing the manifest.
+			*	@param out_recordsPerFile	Records of the previous run, indexed by source file.
+			*	@param out_properties		Properties of the previous run, left untouched if there is no manifest.
+			*
+			*	@return false if the manifest is missing or was written with another header, else true.
+			*/
+			bool loadManifest(fs::path const& outputDirectory, RecordsPerFile& out_recordsPerFile, std::string& out_properties) const noexcept
+			{
+				std::ifstream	manifest(outputDirectory / _manifestFilename);
+				std::string		line;
+
+				if (!manifest.is_open() || !std::getline(manifest, line) || line != _manifestHeader)
+				{
+					return false;
+				}
+
+				std::vector<Record>* fileRecords = nullptr;
+
+				while (std::getline(manifest, line))
+				{
+					if (line.compare(0u, 2u, "P ") == 0)
+					{
+						out_properties = line.substr(2u);
+					}
+					else if (line.compare(0u, 2u, "F ") == 0)
+					{
+						fileRecords = &out_recordsPerFile[line.substr(2u)];
+					}
+					else if (line.compare(0u, 2u, "R ") == 0 && fileRecords != nullptr)
+					{
+						std::istringstream	stream(line.substr(2u));
+						Record				record;
+
+						if (record.read(stream))
+						{
+							fileRecords->push_back(std::move(record));
+						}
+					}
+				}
+
+				return true;
+			}
+
+			/**
+			*	@brief Save the records of all the files of a project, so that the next incremental run doesn't need to parse them.
+			*
+			*	@param outputDirectory	Directory containing the manifest.
+			*	@param recordsPerFile	Records of the project, indexed by source file.
+			*	@param properties		Properties of the run, written on a single line.
+			*
+			*	@return true if the manifest was saved, else false.
+			*/
+			bool saveManifest(fs::path const& outputDirectory, RecordsPerFile const& recordsPerFile, std::string const& properties) const noexcept
+			{
+				std::ofstream manifest(outputDirectory / _manifestFilename, std::ios::trunc);
+
+				if (!manifest.is_open())
+				{
+					return false;
+				}
+
+				manifest << _manifestHeader << "\n" << "P " << properties << "\n";
+
+				for (auto const& [sourceFile, records] : recordsPerFile)
+				{
+					manifest << "F " << sourceFile << "\n";
+
+					for (Record const& record : records)
+					{
+						manifest << "R ";
+						record.write(manifest);
+						manifest << "\n";
+					}
+				}
+
+				return manifest.good();
+			}
+	};
+}
\ No newline at end of file
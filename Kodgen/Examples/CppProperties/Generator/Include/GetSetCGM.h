@@ -27,4 +27,9 @@ class GetSetCGM : public kodgen::MacroCodeGenModule
 		{
 			return new GetSetCGM(*this);
 		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "GetSetCGM";
+		}
 };
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <algorithm>
+
+#include "Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h"
+
+/**
+*	Compile the listed instantiations of a class template only once, in the translation unit including the generated source file.
+*
+*	The header file footer declares each instantiation extern so that downstream translation units don't instantiate it again,
+*	and the generated source file explicitly instantiates it.
+*
+*	Usage: KGClass(Instantiate[int, float]) generates Class<int> and Class<float>.
+*	Since property arguments are separated by commas, template arguments of a single instantiation are separated by ';' instead:
+*	KGClass(Instantiate[int; 4, float; 8]) generates Class<int, 4> and Class<float, 8>.
+*/
+class InstantiatePropertyCodeGen : public kodgen::MacroPropertyCodeGen
+{
+	private:
+		/**
+		*	@brief Get the instantiated type name for the provided property argument.
+		*
+		*	@param struct_	The class template.
+		*	@param argument	The property argument, listing the template arguments separated by ';'.
+		*
+		*	@return The instantiated type name.
+		*/
+		static std::string getInstantiationName(kodgen::StructClassInfo const& struct_, std::string argument) noexcept
+		{
+			std::replace(argument.begin(), argument.end(), ';', ',');
+
+			return struct_.type.getName(true, false, true) + "<" + argument + ">";
+		}
+
+		/**
+		*	@brief Get the class key to use in the explicit instantiations of the provided class template.
+		*
+		*	@param struct_ The class template.
+		*
+		*	@return "struct " or "class ".
+		*/
+		static std::string getClassKey(kodgen::StructClassInfo const& struct_) noexcept
+		{
+			return (struct_.entityType == kodgen::EEntityType::Struct) ? "struct " : "class ";
+		}
+
+	public:
+		InstantiatePropertyCodeGen() noexcept:
+			kodgen::MacroPropertyCodeGen("Instantiate", kodgen::EEntityType::Class | kodgen::EEntityType::Struct)
+		{}
+
+		virtual bool preGenerateCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */, kodgen::MacroCodeGenEnv& env) noexcept override
+		{
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			std::string errorMessage;
+
+			if (property.arguments.empty())
+			{
+				errorMessage = "Instantiate property must list at least one instantiation.";
+			}
+			else if (std::any_of(property.arguments.cbegin(), property.arguments.cend(), [](std::string const& argument) { return argument.empty(); }))
+			{
+				errorMessage = "Instantiate property can't contain an empty instantiation.";
+			}
+			else if (!struct_.type.isTemplateType())
+			{
+				errorMessage = "Instantiate property can't be used on " + struct_.getFullName() + " since it is not a class template.";
+			}
+			else if (struct_.outerEntity != nullptr && struct_.outerEntity->entityType != kodgen::EEntityType::Namespace)
+			{
+				//Member templates can only be instantiated through an instantiation of their outer class
+				errorMessage = "Instantiate property can't be used on the nested class template " + struct_.getFullName() + ".";
+			}
+
+			if (!errorMessage.empty())
+			{
+				//Log error message and abort generation
+				if (env.getLogger() != nullptr)
+				{
+					env.getLogger()->log(errorMessage, kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//If arguments are valid, dispatch the generation call normally
+			return true;
+		}
+
+		virtual bool generateHeaderFileFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			for (std::string const& argument : property.arguments)
+			{
+				inout_result += "extern template " + getClassKey(struct_) + getInstantiationName(struct_, argument) + ";" + env.getSeparator();
+			}
+
+			return true;
+		}
+
+		virtual bool generateSourceFileHeaderCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			for (std::string const& argument : property.arguments)
+			{
+				inout_result += "template " + getClassKey(struct_) + getInstantiationName(struct_, argument) + ";" + env.getSeparator();
+			}
+
+			return true;
+		}
+};
\ No newline at end of file
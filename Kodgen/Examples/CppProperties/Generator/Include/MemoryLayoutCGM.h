@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+
+#include "PooledPropertyCodeGen.h"
+#include "ColdPropertyCodeGen.h"
+
+class MemoryLayoutCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		PooledPropertyCodeGen	_pooledPropertyCodeGen;
+		ColdPropertyCodeGen		_coldPropertyCodeGen;
+
+	public:
+		MemoryLayoutCGM() noexcept
+		{
+			addPropertyCodeGen(_pooledPropertyCodeGen);
+			addPropertyCodeGen(_coldPropertyCodeGen);
+		}
+
+		MemoryLayoutCGM(MemoryLayoutCGM const&):
+			MemoryLayoutCGM() //Call the default constructor to add the copied instance its own property references
+		{
+		}
+
+		virtual MemoryLayoutCGM* clone() const noexcept override
+		{
+			return new MemoryLayoutCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "MemoryLayoutCGM";
+		}
+};
\ No newline at end of file
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <string>
+#include <cctype>
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/CodeGen/CodeGenHelpers.h>
+
+/**
+*	Generate a direct invoker thunk for every reflected method of every reflected struct/class.
+*
+*	All thunks share the same signature, void(*)(void* object, void* const* arguments, void* result), so that script bindings
+*	and RPC layers can call any reflected method through a single indirect call, without std::function or any allocation:
+*		- object is the called object, ignored by static methods,
+*		- arguments[i] points to the i-th argument,
+*		- result points to uninitialized storage where the returned value is constructed, or receives a pointer
+*		  to the returned object if the method returns a reference. It is ignored if the method returns void.
+*
+*	Each struct/class gets a static constexpr kodgenMethods table (name, thunk, parameter count, const, static), which can be searched with:
+*		kodgen_methods::findMethod<T>("name");
+*
+*	Operators are listed with their spelled name (operator+, operator(), operator int...).
+*	The table keeps the access in effect at the class footer macro, use kodgen_methods::get_methods<T>() to get it.
+*/
+class MethodInvokerCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		/**
+		*	@brief Check whether a thunk can be generated for the provided method.
+		*
+		*	@param method The method to check.
+		*
+		*	@return true if the method can be invoked through a thunk, else false.
+		*/
+		static bool isInvokableMethod(kodgen::MethodInfo const& method) noexcept
+		{
+			//Method templates can't be named by a simple call expression, operator< and operator<< are not templates
+			return isOperator(method) || method.name.find('<') == std::string::npos;
+		}
+
+		/**
+		*	@brief Check whether the provided method is an operator.
+		*
+		*	@param method The method to check.
+		*
+		*	@return true if the method is an operator (including conversion operators), else false.
+		*/
+		static bool isOperator(kodgen::MethodInfo const& method) noexcept
+		{
+			return method.name.compare(0u, 8u, "operator") == 0 &&
+				   (method.name.size() == 8u || !(std::isalnum(static_cast<unsigned char>(method.name[8])) || method.name[8] == '_'));
+		}
+
+		/**
+		*	@brief Get the name used to call a method.
+		*
+		*	@param method The method.
+		*
+		*	@return The name of the method, operator() included.
+		*/
+		static std::string getCalledName(kodgen::MethodInfo const& method) noexcept
+		{
+			//The method name is cut at the first parenthesis of the display name, which truncates the call operator
+			return (method.name == "operator") ? "operator()" : method.name;
+		}
+
+		/**
+		*	@brief Generate the thunk of a method.
+		*
+		*	@param className	Name of the class owning the method, usable from the class scope.
+		*	@param method		The method.
+		*	@param thunkName	Name of the generated thunk.
+		*
+		*	@return The thunk definition.
+		*/
+		static std::string generateThunk(std::string const& className, kodgen::MethodInfo const& method, std::string const& thunkName) noexcept
+		{
+			std::string call = (method.isStatic) ? className + "::" : std::string("static_cast<") + className + ((method.isConst) ? " const*>(object)->" : "*>(object)->");
+
+			call += getCalledName(method) + "(";
+
+			for (size_t i = 0u; i < method.parameters.size(); i++)
+			{
+				call += ((i == 0u) ? "kodgen_methods::argument<" : ", kodgen_methods::argument<") + method.parameters[i].type.getName() + ">(arguments[" + std::to_string(i) + "])";
+			}
+
+			call += ")";
+
+			//Unused parameters are not named to avoid warnings
+			return "static void " + thunkName + "(void*" + ((method.isStatic) ? "" : " object") + ", void* const*" + ((method.parameters.empty()) ? "" : " arguments") + ", void* result) " +
+				   "{ kodgen_methods::storeResult(result, [&]() -> decltype(auto) { return " + call + "; }); }";
+		}
+
+	protected:
+		virtual bool initialGenerateHeaderFileHeaderCode(kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			bool containsStructClass = false;
+
+			env.getFileParsingResult()->foreachEntityOfType(kodgen::EEntityType::Struct | kodgen::EEntityType::Class,
+															[&containsStructClass](kodgen::EntityInfo const& entity)
+															{
+																containsStructClass |= !static_cast<kodgen::StructClassInfo const&>(entity).isForwardDeclaration;
+															});
+
+			if (!containsStructClass)
+			{
+				return true;
+			}
+
+			std::string const& sep = env.getSeparator();
+
+			//Types shared by all generated headers, so they must be defined only once per translation unit
+			inout_result += "#ifndef KODGEN_METHOD_INVOKER_DEFINED" + sep +
+							"#define KODGEN_METHOD_INVOKER_DEFINED" + sep + sep +
+							"#include <new>" + sep +
+							"#include <array>" + sep +
+							"#include <cstdint>" + sep +
+							"#include <string_view>" + sep +
+							"#include <type_traits>" + sep + sep +
+							"namespace kodgen_methods" + sep +
+							"{" + sep +
+							"	using Thunk = void(*)(void* object, void* const* arguments, void* result);" + sep + sep +
+							"	struct Method" + sep +
+							"	{" + sep +
+							"		std::string_view	name;" + sep +
+							"		Thunk				invoke;" + sep +
+							"		std::uint32_t		parameterCount;" + sep +
+							"		bool				isConst;" + sep +
+							"		bool				isStatic;" + sep +
+							"	};" + sep + sep +
+							"	//Forward the object pointed to by argument as a T parameter, only rvalue reference parameters are moved from" + sep +
+							"	template <typename T>" + sep +
+							"	constexpr decltype(auto) argument(void* argument) noexcept" + sep +
+							"	{" + sep +
+							"		if constexpr (std::is_rvalue_reference_v<T>)" + sep +
+							"			return static_cast<T>(*static_cast<std::remove_reference_t<T>*>(argument));" + sep +
+							"		else" + sep +
+							"			return *static_cast<std::remove_reference_t<T>*>(argument);" + sep +
+							"	}" + sep + sep +
+							"	//Call callable and construct its result in result, or store a pointer to the returned object if it returns a reference" + sep +
+							"	template <typename Callable>" + sep +
+							"	void storeResult(void* result, Callable&& callable)" + sep +
+							"	{" + sep +
+							"		using ResultType = decltype(callable());" + sep + sep +
+							"		if constexpr (std::is_void_v<ResultType>)" + sep +
+							"			callable();" + sep +
+							"		else if constexpr (std::is_reference_v<ResultType>)" + sep +
+							"		{" + sep +
+							"			//Bind the result first, the address of an rvalue reference result can't be taken directly" + sep +
+							"			auto&& value = callable();" + sep + sep +
+							"			*static_cast<std::remove_reference_t<ResultType>**>(result) = &value;" + sep +
+							"		}" + sep +
+							"		else" + sep +
+							"			new (result) ResultType(callable());" + sep +
+							"	}" + sep + sep +
+							"	//Friend of all reflected classes, so that the generated code doesn't change the access of the members declared after the footer macro" + sep +
+							"	struct Access" + sep +
+							"	{" + sep +
+							"		template <typename T>" + sep +
+							"		static constexpr auto const& methods() noexcept { return T::kodgenMethods; }" + sep +
+							"	};" + sep + sep +
+							"	//Get the table of the reflected methods of T" + sep +
+							"	template <typename T>" + sep +
+							"	constexpr auto const& get_methods() noexcept" + sep +
+							"	{" + sep +
+							"		return Access::methods<std::remove_const_t<T>>();" + sep +
+							"	}" + sep + sep +
+							"	//Find the first reflected method of T with the provided name (overloads share the same name), nullptr if there is none" + sep +
+							"	template <typename T>" + sep +
+							"	constexpr Method const* findMethod(std::string_view name) noexcept" + sep +
+							"	{" + sep +
+							"		for (Method const& method : get_methods<T>())" + sep +
+							"		{" + sep +
+							"			if (method.name == name)" + sep +
+							"				return &method;" + sep +
+							"		}" + sep + sep +
+							"		return nullptr;" + sep +
+							"	}" + sep +
+							"}" + sep + sep +
+							"#endif" + sep + sep;
+
+			return true;
+		}
+
+		virtual kodgen::ETraversalBehaviour generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			if (entity.entityType != kodgen::EEntityType::Struct && entity.entityType != kodgen::EEntityType::Class)
+			{
+				return kodgen::CodeGenHelpers::leastPrioritizedTraversalBehaviour;
+			}
+
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			if (struct_.isForwardDeclaration)
+			{
+				return kodgen::ETraversalBehaviour::Recurse;
+			}
+
+			//Use the injected class name so that it also works for nested classes and class templates
+			std::string className	= struct_.name.substr(0u, struct_.name.find('<'));
+			std::string thunks;
+			std::string methods;
+			size_t		methodCount	= 0u;
+
+			for (kodgen::MethodInfo const& method : struct_.methods)
+			{
+				if (isInvokableMethod(method))
+				{
+					std::string thunkName = "kodgenInvoke_" + ((isOperator(method)) ? std::string("operator") : method.name) + "_" + std::to_string(methodCount);
+
+					thunks	+= generateThunk(className, method, thunkName) + env.getSeparator();
+					methods	+= ((methodCount == 0u) ? " { \"" : ", { \"") + getCalledName(method) + "\", &" + thunkName + ", " + std::to_string(method.parameters.size()) + "u, " +
+							   ((method.isConst) ? "true, " : "false, ") + ((method.isStatic) ? "true }" : "false }");
+
+					methodCount++;
+				}
+			}
+
+			//No access specifier is emitted so that the members declared after the class footer macro keep their access
+			inout_result += "friend struct kodgen_methods::Access;" + env.getSeparator() +
+							thunks +
+							"static constexpr std::array<kodgen_methods::Method, " + std::to_string(methodCount) + "> kodgenMethods = {{" + methods + " }};" + env.getSeparator();
+
+			return kodgen::ETraversalBehaviour::Recurse;
+		}
+
+	public:
+		virtual MethodInvokerCGM* clone() const noexcept override
+		{
+			return new MethodInvokerCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "MethodInvokerCGM";
+		}
+};
\ No newline at end of file
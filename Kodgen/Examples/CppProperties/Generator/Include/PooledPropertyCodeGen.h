@@ -0,0 +1,292 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <algorithm>
+
+#include "Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h"
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Generate class specific operator new / operator delete backed by a fixed-size pool.
+*	The pool is sized from the parsed class size/alignment and hands blocks to each thread in batches
+*	through a thread local cache, so that most allocations don't touch the pool mutex.
+*
+*	Usage: KGClass(Pooled) or KGClass(Pooled[blocksPerChunk])
+*/
+class PooledPropertyCodeGen : public kodgen::MacroPropertyCodeGen
+{
+	private:
+		/** Number of blocks allocated at once when a pool runs out of free blocks, if not specified in the property. */
+		static constexpr size_t	defaultBlocksPerChunk	= 1024u;
+
+		/** Maximum number of blocks moved between a thread cache and its pool at once. */
+		static constexpr size_t	maxBatchSize			= 64u;
+
+		/**
+		*	@brief Compute the number of blocks per chunk specified in the property.
+		*
+		*	@param property The Pooled property.
+		*
+		*	@return The number of blocks per chunk, or 0 if the property argument is invalid.
+		*/
+		static size_t getBlocksPerChunk(kodgen::Property const& property) noexcept
+		{
+			if (property.arguments.empty())
+			{
+				return defaultBlocksPerChunk;
+			}
+
+			std::string const& arg = property.arguments[0];
+
+			if (arg.empty() || arg.size() > 9u || !std::all_of(arg.cbegin(), arg.cend(), [](char c) { return c >= '0' && c <= '9'; }))
+			{
+				return 0u;
+			}
+
+			return static_cast<size_t>(std::stoul(arg));
+		}
+
+	public:
+		PooledPropertyCodeGen() noexcept:
+			kodgen::MacroPropertyCodeGen("Pooled", kodgen::EEntityType::Class | kodgen::EEntityType::Struct)
+		{}
+
+		virtual bool preGenerateCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */, kodgen::MacroCodeGenEnv& env) noexcept override
+		{
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			std::string errorMessage;
+
+			if (property.arguments.size() > 1)
+			{
+				errorMessage = "Pooled property can't take more than one argument.";
+			}
+			else if (getBlocksPerChunk(property) == 0u)
+			{
+				errorMessage = "Pooled property only argument must be a strictly positive number of blocks per chunk.";
+			}
+			else if (struct_.type.sizeInBytes == 0u || struct_.type.alignment == 0u)
+			{
+				//Happens for class templates and incomplete types
+				errorMessage = "Can't generate a pool for " + struct_.getFullName() + " because its size or alignment could not be computed.";
+			}
+
+			if (!errorMessage.empty())
+			{
+				//Log error message and abort generation
+				if (env.getLogger() != nullptr)
+				{
+					env.getLogger()->log(errorMessage, kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//If arguments are valid, dispatch the generation call normally
+			return true;
+		}
+
+		virtual bool generateHeaderFileHeaderCodeForEntity(kodgen::EntityInfo const& /* entity */, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			//std::size_t and std::align_val_t are used in the operator new / operator delete declarations
+			inout_result += "#include <new>" + env.getSeparator() +
+							"#include <cstddef>" + env.getSeparator();
+
+			return true;
+		}
+
+		virtual bool generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+													  kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			//The operators must be public to be usable by new/delete expressions, then the access in effect at the macro is restored
+			inout_result += "public:" + env.getSeparator();
+			inout_result += "static void* operator new(std::size_t size);" + env.getSeparator();
+			inout_result += "static void* operator new(std::size_t size, std::align_val_t alignment);" + env.getSeparator();
+			inout_result += "static void operator delete(void* ptr, std::size_t size) noexcept;" + env.getSeparator();
+			inout_result += "static void operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept;" + env.getSeparator();
+			inout_result += GeneratorHelpers::getAccessSpecifierCode(env.getClassFooterAccessSpecifier(static_cast<kodgen::StructClassInfo const&>(entity))) + env.getSeparator();
+
+			return true;
+		}
+
+		virtual bool generateSourceFileHeaderCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::StructClassInfo const& struct_ = static_cast<kodgen::StructClassInfo const&>(entity);
+
+			std::string const&	sep				= env.getSeparator();
+			std::string			className		= struct_.getFullName();
+			std::string			poolName		= GeneratorHelpers::getIdentifier(struct_) + "_Pool";
+			std::string			cacheName		= poolName + "Cache";
+			size_t				blocksPerChunk	= getBlocksPerChunk(property);
+
+			//A free block must at least be able to store the next free block pointer
+			size_t				blockAlignment	= std::max(struct_.type.alignment, alignof(void*));
+			size_t				blockSize		= std::max(struct_.type.sizeInBytes, sizeof(void*));
+			blockSize = GeneratorHelpers::alignUp(blockSize, blockAlignment);
+
+			size_t				batchSize		= std::min(blocksPerChunk, maxBatchSize);
+
+			inout_result += "#include <new>" + sep +
+							"#include <mutex>" + sep +
+							"#include <cstddef>" + sep + sep;
+
+			inout_result += "//Fixed-size pool backing " + className + "::operator new / operator delete" + sep +
+							"namespace" + sep +
+							"{" + sep +
+							"	struct " + poolName + sep +
+							"	{" + sep +
+							"		struct Block { Block* next; };" + sep + sep +
+							"		static constexpr std::size_t blockSize		= " + std::to_string(blockSize) + "u;" + sep +
+							"		static constexpr std::size_t blockAlignment	= " + std::to_string(blockAlignment) + "u;" + sep +
+							"		static constexpr std::size_t blocksPerChunk	= " + std::to_string(blocksPerChunk) + "u;" + sep +
+							"		static constexpr std::size_t batchSize		= " + std::to_string(batchSize) + "u;" + sep + sep +
+							"		std::mutex	mutex;" + sep +
+							"		Block*		freeList = nullptr;" + sep + sep +
+							"		static " + poolName + "& get() noexcept" + sep +
+							"		{" + sep +
+							"			//Never destroyed so that objects deleted during static destruction still find their pool" + sep +
+							"			static " + poolName + "* pool = new " + poolName + "();" + sep + sep +
+							"			return *pool;" + sep +
+							"		}" + sep + sep +
+							"		Block* acquireBatch(std::size_t& out_count)" + sep +
+							"		{" + sep +
+							"			std::lock_guard<std::mutex> lock(mutex);" + sep + sep +
+							"			if (freeList == nullptr)" + sep +
+							"			{" + sep +
+							"				char* chunk = static_cast<char*>(::operator new(blockSize * blocksPerChunk, std::align_val_t(blockAlignment)));" + sep + sep +
+							"				for (std::size_t i = 0u; i < blocksPerChunk; i++)" + sep +
+							"				{" + sep +
+							"					reinterpret_cast<Block*>(chunk + i * blockSize)->next = (i + 1u < blocksPerChunk) ? reinterpret_cast<Block*>(chunk + (i + 1u) * blockSize) : nullptr;" + sep +
+							"				}" + sep + sep +
+							"				freeList = reinterpret_cast<Block*>(chunk);" + sep +
+							"			}" + sep + sep +
+							"			Block* first = freeList;" + sep +
+							"			Block* last = first;" + sep + sep +
+							"			for (out_count = 1u; out_count < batchSize && last->next != nullptr; out_count++)" + sep +
+							"			{" + sep +
+							"				last = last->next;" + sep +
+							"			}" + sep + sep +
+							"			freeList = last->next;" + sep +
+							"			last->next = nullptr;" + sep + sep +
+							"			return first;" + sep +
+							"		}" + sep + sep +
+							"		void releaseBatch(Block* first, Block* last) noexcept" + sep +
+							"		{" + sep +
+							"			std::lock_guard<std::mutex> lock(mutex);" + sep + sep +
+							"			last->next = freeList;" + sep +
+							"			freeList = first;" + sep +
+							"		}" + sep +
+							"	};" + sep + sep +
+							"	//Trivially destructible so that it can still be used by deletes happening during thread exit" + sep +
+							"	struct " + cacheName + sep +
+							"	{" + sep +
+							"		" + poolName + "::Block*	head;" + sep +
+							"		std::size_t	count;" + sep + sep +
+							"		void releaseBlocks(std::size_t blockCount) noexcept" + sep +
+							"		{" + sep +
+							"			" + poolName + "::Block* first = head;" + sep +
+							"			" + poolName + "::Block* last = head;" + sep + sep +
+							"			for (std::size_t i = 1u; i < blockCount; i++)" + sep +
+							"			{" + sep +
+							"				last = last->next;" + sep +
+							"			}" + sep + sep +
+							"			head = last->next;" + sep +
+							"			count -= blockCount;" + sep + sep +
+							"			" + poolName + "::get().releaseBatch(first, last);" + sep +
+							"		}" + sep +
+							"	};" + sep + sep +
+							"	//Give the cached blocks back to the pool when the thread exits" + sep +
+							"	struct " + cacheName + "Flusher" + sep +
+							"	{" + sep +
+							"		~" + cacheName + "Flusher();" + sep +
+							"	};" + sep + sep +
+							"	thread_local " + cacheName + "		" + cacheName + "Instance{ nullptr, 0u };" + sep +
+							"	thread_local " + cacheName + "Flusher	" + cacheName + "FlusherInstance;" + sep + sep +
+							"	" + cacheName + "Flusher::~" + cacheName + "Flusher()" + sep +
+							"	{" + sep +
+							"		if (" + cacheName + "Instance.count != 0u)" + sep +
+							"		{" + sep +
+							"			" + cacheName + "Instance.releaseBlocks(" + cacheName + "Instance.count);" + sep +
+							"		}" + sep +
+							"	}" + sep +
+							"}" + sep + sep;
+
+			//Layout may differ if the generator was not run with the same compilation flags as the compiled project
+			inout_result += "static_assert(sizeof(" + className + ") <= " + poolName + "::blockSize && alignof(" + className + ") <= " + poolName + "::blockAlignment, "
+							"\"" + className + " layout changed since the pool was generated, run the generator again.\");" + sep + sep;
+
+			inout_result += "void* " + className + "::operator new(std::size_t size)" + sep +
+							"{" + sep +
+							"	//Bigger derived classes fall back on the global allocator, keeping the alignment of the pool blocks" + sep +
+							"	if (size > " + poolName + "::blockSize)" + sep +
+							"	{" + sep +
+							"		return ::operator new(size, std::align_val_t(" + poolName + "::blockAlignment));" + sep +
+							"	}" + sep + sep +
+							"	" + cacheName + "& cache = " + cacheName + "Instance;" + sep + sep +
+							"	if (cache.head == nullptr)" + sep +
+							"	{" + sep +
+							"		static_cast<void>(&" + cacheName + "FlusherInstance);	//Make sure the flusher is constructed for this thread" + sep + sep +
+							"		cache.head = " + poolName + "::get().acquireBatch(cache.count);" + sep +
+							"	}" + sep + sep +
+							"	" + poolName + "::Block* block = cache.head;" + sep +
+							"	cache.head = block->next;" + sep +
+							"	cache.count--;" + sep + sep +
+							"	return block;" + sep +
+							"}" + sep + sep;
+
+			inout_result += "void " + className + "::operator delete(void* ptr, std::size_t size) noexcept" + sep +
+							"{" + sep +
+							"	if (ptr == nullptr)" + sep +
+							"	{" + sep +
+							"		return;" + sep +
+							"	}" + sep +
+							"	else if (size > " + poolName + "::blockSize)" + sep +
+							"	{" + sep +
+							"		::operator delete(ptr, std::align_val_t(" + poolName + "::blockAlignment));" + sep +
+							"		return;" + sep +
+							"	}" + sep + sep +
+							"	" + cacheName + "& cache = " + cacheName + "Instance;" + sep + sep +
+							"	" + poolName + "::Block* block = static_cast<" + poolName + "::Block*>(ptr);" + sep +
+							"	block->next = cache.head;" + sep +
+							"	cache.head = block;" + sep +
+							"	cache.count++;" + sep + sep +
+							"	//Don't let a thread which only deletes hoard all the blocks" + sep +
+							"	if (cache.count >= 2u * " + poolName + "::batchSize)" + sep +
+							"	{" + sep +
+							"		cache.releaseBlocks(" + poolName + "::batchSize);" + sep +
+							"	}" + sep +
+							"}" + sep + sep;
+
+			//Over-aligned classes and derived classes call the aligned forms
+			inout_result += "void* " + className + "::operator new(std::size_t size, std::align_val_t alignment)" + sep +
+							"{" + sep +
+							"	if (static_cast<std::size_t>(alignment) > " + poolName + "::blockAlignment)" + sep +
+							"	{" + sep +
+							"		return ::operator new(size, alignment);" + sep +
+							"	}" + sep + sep +
+							"	return " + className + "::operator new(size);" + sep +
+							"}" + sep + sep;
+
+			inout_result += "void " + className + "::operator delete(void* ptr, std::size_t size, std::align_val_t alignment) noexcept" + sep +
+							"{" + sep +
+							"	if (static_cast<std::size_t>(alignment) > " + poolName + "::blockAlignment)" + sep +
+							"	{" + sep +
+							"		::operator delete(ptr, alignment);" + sep +
+							"		return;" + sep +
+							"	}" + sep + sep +
+							"	" + className + "::operator delete(ptr, size);" + sep +
+							"}" + sep + sep;
+
+			return true;
+		}
+};
\ No newline at end of file
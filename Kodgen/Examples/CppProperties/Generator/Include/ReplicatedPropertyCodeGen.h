@@ -0,0 +1,286 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "Kodgen/CodeGen/Macro/MacroPropertyCodeGen.h"
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Track modifications of replicated fields and generate delta serialization for them.
+*
+*	For each struct/class containing KGField(Replicated) fields, the class footer receives:
+*		- a dirty bit per replicated field, stored in a single per-object bitset;
+*		- a setter per replicated field (setFieldName) updating the field and marking it dirty;
+*		- forEachDirtyField(visitor), calling visitor(fieldIndex, fieldName, fieldValue) on dirty fields only;
+*		- isDirty() / clearDirtyFields();
+*		- serializeDelta / deserializeDelta, encoding the dirty mask followed by the raw bytes of the dirty fields only.
+*		  Both return the number of written/read bytes, deserializeDelta returns 0 and leaves the object untouched if the provided data is truncated.
+*	The generated members are public, then the access in effect at the class footer macro is restored.
+*
+*	Fields are encoded with the size computed by the parser, so replicated fields must be trivially copyable
+*	and both ends must share the same architecture.
+*/
+class ReplicatedPropertyCodeGen : public kodgen::MacroPropertyCodeGen
+{
+	private:
+		/**
+		*	@brief Collect all replicated fields of a struct/class.
+		*
+		*	@param struct_ The struct/class.
+		*
+		*	@return All replicated fields in declaration order.
+		*/
+		std::vector<kodgen::FieldInfo const*> getReplicatedFields(kodgen::StructClassInfo const& struct_) const noexcept
+		{
+			std::vector<kodgen::FieldInfo const*> result;
+
+			for (kodgen::FieldInfo const& field : struct_.fields)
+			{
+				if (std::any_of(field.properties.cbegin(), field.properties.cend(), [this](kodgen::Property const& property) { return property.name == getPropertyName(); }))
+				{
+					result.push_back(&field);
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		*	@brief	Check whether the provided field is the first replicated field of its outer struct/class.
+		*			Code common to all replicated fields of a struct/class is generated for this field only.
+		*
+		*	@param field The field to check.
+		*
+		*	@return true if the field is the first replicated field of its outer struct/class, else false.
+		*/
+		bool isFirstReplicatedField(kodgen::FieldInfo const& field) const noexcept
+		{
+			std::vector<kodgen::FieldInfo const*> replicatedFields = getReplicatedFields(static_cast<kodgen::StructClassInfo const&>(*field.outerEntity));
+
+			return !replicatedFields.empty() && replicatedFields.front() == &field;
+		}
+
+		/**
+		*	@brief Get the setter name of a replicated field.
+		*
+		*	@param field The replicated field.
+		*
+		*	@return The setter name.
+		*/
+		static std::string getSetterName(kodgen::FieldInfo const& field) noexcept
+		{
+			//Upper case the first field info char if applicable
+			std::string methodName = field.name;
+			methodName.replace(0, 1, 1, static_cast<char>(std::toupper(methodName.at(0))));
+
+			return "set" + methodName;
+		}
+
+	public:
+		ReplicatedPropertyCodeGen() noexcept:
+			kodgen::MacroPropertyCodeGen("Replicated", kodgen::EEntityType::Field)
+		{}
+
+		virtual bool preGenerateCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& property, kodgen::uint8 /* propertyIndex */, kodgen::MacroCodeGenEnv& env) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			std::string errorMessage;
+
+			if (!property.arguments.empty())
+			{
+				errorMessage = "Replicated property doesn't take any argument.";
+			}
+			else if (field.isStatic)
+			{
+				errorMessage = "Replicated property can't be used on the static field " + field.getFullName() + ".";
+			}
+			else if (field.type.typeParts.front().descriptor & (kodgen::ETypeDescriptor::LRef | kodgen::ETypeDescriptor::RRef | kodgen::ETypeDescriptor::CArray) ||
+					 field.type.typeParts.back().descriptor & kodgen::ETypeDescriptor::Const)
+			{
+				errorMessage = "Replicated property can't be used on the field " + field.getFullName() + " since it is not assignable.";
+			}
+			else if (field.type.sizeInBytes == 0u)
+			{
+				errorMessage = "Replicated property can't be used on the field " + field.getFullName() + " since its size could not be computed.";
+			}
+			else if (std::any_of(field.properties.cbegin(), field.properties.cend(), [](kodgen::Property const& prop) { return prop.name == "Set"; }))
+			{
+				errorMessage = "Replicated property already generates a setter for the field " + field.getFullName() + ", remove its Set property.";
+			}
+
+			if (!errorMessage.empty())
+			{
+				//Log error message and abort generation
+				if (env.getLogger() != nullptr)
+				{
+					env.getLogger()->log(errorMessage, kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//If arguments are valid, dispatch the generation call normally
+			return true;
+		}
+
+		virtual bool generateHeaderFileHeaderCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			if (isFirstReplicatedField(static_cast<kodgen::FieldInfo const&>(entity)))
+			{
+				inout_result += "#include <bitset>" + env.getSeparator() +
+								"#include <vector>" + env.getSeparator() +
+								"#include <cstddef>" + env.getSeparator();
+			}
+
+			return true;
+		}
+
+		virtual bool generateClassFooterCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+													  kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			std::vector<kodgen::FieldInfo const*>	replicatedFields	= getReplicatedFields(static_cast<kodgen::StructClassInfo const&>(*field.outerEntity));
+			size_t									fieldIndex			= std::find(replicatedFields.cbegin(), replicatedFields.cend(), &field) - replicatedFields.cbegin();
+			std::string const&						sep					= env.getSeparator();
+
+			if (fieldIndex == 0u)
+			{
+				std::string forEachDirtyFieldBody;
+
+				for (size_t i = 0u; i < replicatedFields.size(); i++)
+				{
+					forEachDirtyFieldBody += " if (_kodgenDirtyFields.test(" + std::to_string(i) + "u)) { visitor(" + std::to_string(i) + "u, \"" + replicatedFields[i]->name + "\", " + replicatedFields[i]->name + "); }";
+				}
+
+				//The setters of all replicated fields follow, the access is restored after the last one
+				inout_result += "private:" + sep +
+								"std::bitset<" + std::to_string(replicatedFields.size()) + "> _kodgenDirtyFields;" + sep +
+								"public:" + sep +
+								"static constexpr std::size_t replicatedFieldCount = " + std::to_string(replicatedFields.size()) + "u;" + sep +
+								"bool isDirty() const noexcept { return _kodgenDirtyFields.any(); }" + sep +
+								"void clearDirtyFields() noexcept { _kodgenDirtyFields.reset(); }" + sep +
+								"template <typename Visitor> void forEachDirtyField(Visitor&& visitor) const {" + forEachDirtyFieldBody + " }" + sep +
+								"std::size_t serializeDelta(std::vector<unsigned char>& out_buffer) const;" + sep +
+								"std::size_t deserializeDelta(unsigned char const* data, std::size_t size) noexcept;" + sep;
+			}
+
+			std::string paramName = "_kodgen" + field.name;
+
+			inout_result += "void " + getSetterName(field) + "(" + field.type.getCanonicalName() + " const& " + paramName + ") { " +
+							field.name + " = " + paramName + "; _kodgenDirtyFields.set(" + std::to_string(fieldIndex) + "u); }" + sep;
+
+			if (fieldIndex + 1u == replicatedFields.size())
+			{
+				inout_result += GeneratorHelpers::getAccessSpecifierCode(env.getClassFooterAccessSpecifier(static_cast<kodgen::StructClassInfo const&>(*field.outerEntity))) + sep;
+			}
+
+			return true;
+		}
+
+		virtual bool generateSourceFileHeaderCodeForEntity(kodgen::EntityInfo const& entity, kodgen::Property const& /* property */, kodgen::uint8 /* propertyIndex */,
+														   kodgen::MacroCodeGenEnv& env, std::string& inout_result) noexcept override
+		{
+			kodgen::FieldInfo const& field = static_cast<kodgen::FieldInfo const&>(entity);
+
+			if (!isFirstReplicatedField(field))
+			{
+				return true;
+			}
+
+			kodgen::StructClassInfo const&			struct_				= static_cast<kodgen::StructClassInfo const&>(*field.outerEntity);
+			std::vector<kodgen::FieldInfo const*>	replicatedFields	= getReplicatedFields(struct_);
+			std::string const&						sep					= env.getSeparator();
+			std::string								className			= struct_.getFullName();
+			std::string								maskSize			= std::to_string((replicatedFields.size() + 7u) / 8u) + "u";
+
+			inout_result += "#include <cstring>" + sep +
+							"#include <type_traits>" + sep + sep;
+
+			//Serialization
+			inout_result += "std::size_t " + className + "::serializeDelta(std::vector<unsigned char>& out_buffer) const" + sep +
+							"{" + sep;
+
+			for (kodgen::FieldInfo const* replicatedField : replicatedFields)
+			{
+				inout_result += "	static_assert(std::is_trivially_copyable_v<decltype(" + replicatedField->name + ")> && sizeof(" + replicatedField->name + ") == " + std::to_string(replicatedField->type.sizeInBytes) + "u, "
+								"\"" + replicatedField->getFullName() + " can't be replicated as raw bytes or its layout changed since the code was generated.\");" + sep;
+			}
+
+			inout_result += sep +
+							"	std::size_t const startSize = out_buffer.size();" + sep + sep +
+							"	//Dirty fields mask" + sep +
+							"	out_buffer.resize(startSize + " + maskSize + ", 0u);" + sep + sep +
+							"	for (std::size_t i = 0u; i < _kodgenDirtyFields.size(); i++)" + sep +
+							"	{" + sep +
+							"		if (_kodgenDirtyFields.test(i))" + sep +
+							"		{" + sep +
+							"			out_buffer[startSize + i / 8u] |= static_cast<unsigned char>(1u << (i % 8u));" + sep +
+							"		}" + sep +
+							"	}" + sep + sep +
+							"	//Dirty fields values" + sep;
+
+			for (size_t i = 0u; i < replicatedFields.size(); i++)
+			{
+				std::string const& name = replicatedFields[i]->name;
+
+				inout_result += "	if (_kodgenDirtyFields.test(" + std::to_string(i) + "u))" + sep +
+								"	{" + sep +
+								"		out_buffer.insert(out_buffer.end(), reinterpret_cast<unsigned char const*>(&" + name + "), reinterpret_cast<unsigned char const*>(&" + name + ") + " + std::to_string(replicatedFields[i]->type.sizeInBytes) + "u);" + sep +
+								"	}" + sep + sep;
+			}
+
+			inout_result += "	return out_buffer.size() - startSize;" + sep +
+							"}" + sep + sep;
+
+			//Deserialization: the size required by the dirty mask is checked before any field is modified
+			inout_result += "std::size_t " + className + "::deserializeDelta(unsigned char const* data, std::size_t size) noexcept" + sep +
+							"{" + sep +
+							"	std::size_t offset = " + maskSize + ";" + sep + sep +
+							"	if (size < offset)" + sep +
+							"	{" + sep +
+							"		return 0u;" + sep +
+							"	}" + sep + sep +
+							"	std::size_t requiredSize = offset;" + sep + sep;
+
+			for (size_t i = 0u; i < replicatedFields.size(); i++)
+			{
+				inout_result += "	requiredSize += (data[" + std::to_string(i / 8u) + "u] & " + std::to_string(1u << (i % 8u)) + "u) ? " + std::to_string(replicatedFields[i]->type.sizeInBytes) + "u : 0u;" + sep;
+			}
+
+			inout_result += sep +
+							"	if (size < requiredSize)" + sep +
+							"	{" + sep +
+							"		return 0u;" + sep +
+							"	}" + sep + sep;
+
+			for (size_t i = 0u; i < replicatedFields.size(); i++)
+			{
+				std::string const&	name		= replicatedFields[i]->name;
+				std::string			fieldSize	= std::to_string(replicatedFields[i]->type.sizeInBytes) + "u";
+
+				inout_result += "	if (data[" + std::to_string(i / 8u) + "u] & " + std::to_string(1u << (i % 8u)) + "u)" + sep +
+								"	{" + sep +
+								"		std::memcpy(&" + name + ", data + offset, " + fieldSize + ");" + sep +
+								"		offset += " + fieldSize + ";" + sep +
+								"	}" + sep + sep;
+			}
+
+			inout_result += "	return offset;" + sep +
+							"}" + sep + sep;
+
+			return true;
+		}
+};
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+
+#include "ReplicatedPropertyCodeGen.h"
+
+class ReplicationCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		ReplicatedPropertyCodeGen	_replicatedPropertyCodeGen;
+
+	public:
+		ReplicationCGM() noexcept
+		{
+			addPropertyCodeGen(_replicatedPropertyCodeGen);
+		}
+
+		ReplicationCGM(ReplicationCGM const&):
+			ReplicationCGM() //Call the default constructor to add the copied instance its own property references
+		{
+		}
+
+		virtual ReplicationCGM* clone() const noexcept override
+		{
+			return new ReplicationCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "ReplicationCGM";
+		}
+};
\ No newline at end of file
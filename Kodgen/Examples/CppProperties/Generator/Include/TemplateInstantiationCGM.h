@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+
+#include "InstantiatePropertyCodeGen.h"
+
+class TemplateInstantiationCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		InstantiatePropertyCodeGen	_instantiatePropertyCodeGen;
+
+	public:
+		TemplateInstantiationCGM() noexcept
+		{
+			addPropertyCodeGen(_instantiatePropertyCodeGen);
+		}
+
+		TemplateInstantiationCGM(TemplateInstantiationCGM const&):
+			TemplateInstantiationCGM() //Call the default constructor to add the copied instance its own property references
+		{
+		}
+
+		virtual TemplateInstantiationCGM* clone() const noexcept override
+		{
+			return new TemplateInstantiationCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "TemplateInstantiationCGM";
+		}
+};
\ No newline at end of file
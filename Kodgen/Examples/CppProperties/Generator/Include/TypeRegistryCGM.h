@@ -0,0 +1,311 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+
+#include <Kodgen/CodeGen/Macro/MacroCodeGenModule.h>
+#include <Kodgen/Misc/ILogger.h>
+#include <Kodgen/Misc/FundamentalTypes.h>
+
+#include "GeneratorHelpers.h"
+
+/**
+*	Generate a registry listing all the reflected namespace-level structs, classes and enums of a project:
+*		std::vector<kodgen_registry::TypeEntry> types = kodgen_registry::getAllTypes();
+*
+*	A single registry file would change (and rebuild all its dependents) whenever any type is added, so types are split into
+*	shardCount source files by a stable hash of their USR: adding or removing a type only rewrites the shard it belongs to.
+*	The KodgenTypeRegistry.h index only declares the shards, so it is left untouched as long as the shard count doesn't change.
+*	The shards (KodgenTypeRegistry_<index>.cpp) are written in the output directory by generateRegistryFiles,
+*	which must be called once the whole project is generated. All of them must be compiled in the project.
+*	Shards beyond the shard count (left by a previous run with more shards) are removed from the output directory.
+*/
+class TypeRegistryCGM : public kodgen::MacroCodeGenModule
+{
+	private:
+		/** Registered type as saved in the registry manifest. */
+		struct TypeRecord
+		{
+			/** Unified Symbol Resolution of the type, stable across runs. */
+			std::string	usr;
+
+			/** Full name of the type. */
+			std::string	name;
+
+			/** Read a record written by write. */
+			bool read(std::istream& stream) noexcept
+			{
+				return static_cast<bool>(stream >> usr >> name);
+			}
+
+			/** Write the record as "<usr> <name>". */
+			void write(std::ostream& stream) const noexcept
+			{
+				stream << usr << " " << name;
+			}
+		};
+
+		/** Name of the index header declaring all shards, written in the generated files output directory. */
+		static constexpr char const*	_indexFilename		= "KodgenTypeRegistry.h";
+
+		/** Prefix of the shard source files names, followed by the shard index and .cpp. */
+		static constexpr char const*	_shardFilenamePrefix	= "KodgenTypeRegistry_";
+
+		/** Types of the project files, shared with the clones of this module since they generate the files of the project. The manifest properties are the shard count. */
+		GeneratorHelpers::AggregatedOutput<TypeRecord>	_types{ "KodgenTypeRegistry.txt", "KodgenTypeRegistry 2" };
+
+		/**
+		*	@brief Check whether an entity can be registered.
+		*
+		*	@param entity The entity to check.
+		*
+		*	@return true if the entity is a complete namespace-level struct, class or enum which can be named from the registry, else false.
+		*/
+		static bool isRegisteredType(kodgen::EntityInfo const& entity) noexcept
+		{
+			if (entity.id.empty() || (entity.outerEntity != nullptr && entity.outerEntity->entityType != kodgen::EEntityType::Namespace))
+			{
+				return false;
+			}
+
+			if ((entity.entityType == kodgen::EEntityType::Struct || entity.entityType == kodgen::EEntityType::Class) &&
+				static_cast<kodgen::StructClassInfo const&>(entity).isForwardDeclaration)
+			{
+				return false;
+			}
+
+			//Templates have no single size, and anonymous types or namespace members can't be named from another file
+			return !entity.name.empty() && entity.getFullName().find_first_of("< (") == std::string::npos;
+		}
+
+		/**
+		*	@brief Get the shard a type is assigned to. The assignment only depends on the type USR and the shard count.
+		*
+		*	@param usr			USR of the type.
+		*	@param shardCount	Number of shards.
+		*
+		*	@return The index of the shard.
+		*/
+		static kodgen::uint32 getShardIndex(std::string const& usr, kodgen::uint32 shardCount) noexcept
+		{
+			//FNV-1a, std::hash is not guaranteed to be stable across runs or implementations
+			kodgen::uint32 hash = 2166136261u;
+
+			for (char character : usr)
+			{
+				hash = (hash ^ static_cast<unsigned char>(character)) * 16777619u;
+			}
+
+			return hash % shardCount;
+		}
+
+		/**
+		*	@brief Get the path to a shard source file.
+		*
+		*	@param outputDirectory	Output directory of the project generated files.
+		*	@param shardIndex		Index of the shard.
+		*
+		*	@return The path to the shard.
+		*/
+		static fs::path getShardPath(fs::path const& outputDirectory, kodgen::uint32 shardIndex) noexcept
+		{
+			return outputDirectory / (_shardFilenamePrefix + std::to_string(shardIndex) + ".cpp");
+		}
+
+		/**
+		*	@brief	Remove the shards of the output directory whose index is beyond the shard count.
+		*			The directory is scanned rather than relying on the manifest, so that shards are removed even if the manifest was lost.
+		*
+		*	@param outputDirectory	Output directory of the project generated files.
+		*	@param shardCount		Number of shards of the run.
+		*/
+		static void removeStaleShards(fs::path const& outputDirectory, kodgen::uint32 shardCount) noexcept
+		{
+			std::string const	prefix = _shardFilenamePrefix;
+			std::error_code		errorCode;
+
+			for (fs::directory_iterator it(outputDirectory, errorCode), end; !errorCode && it != end; it.increment(errorCode))
+			{
+				std::string filename = it->path().filename().string();
+
+				if (filename.size() <= prefix.size() + 4u || filename.compare(0u, prefix.size(), prefix) != 0 || it->path().extension() != ".cpp")
+				{
+					continue;
+				}
+
+				std::string index = filename.substr(prefix.size(), filename.size() - prefix.size() - 4u);
+
+				//Shards beyond the shard count would register their types twice if they were still compiled
+				if (index.find_first_not_of("0123456789") == std::string::npos && (index.size() > 9u || std::stoul(index) >= shardCount))
+				{
+					std::error_code removeErrorCode;
+
+					fs::remove(it->path(), removeErrorCode);
+				}
+			}
+		}
+
+	protected:
+		virtual bool initialGenerateHeaderFileHeaderCode(kodgen::MacroCodeGenEnv& env, std::string& /* inout_result */) noexcept override
+		{
+			std::vector<TypeRecord> types;
+
+			env.getFileParsingResult()->foreachEntityOfType(kodgen::EEntityType::Struct | kodgen::EEntityType::Class | kodgen::EEntityType::Enum,
+															[&types](kodgen::EntityInfo const& entity)
+															{
+																if (isRegisteredType(entity))
+																{
+																	types.push_back({ entity.id, entity.getFullName() });
+																}
+															});
+
+			_types.record(env.getFileParsingResult()->parsedFile, std::move(types));
+
+			return true;
+		}
+
+	public:
+		/** Number of shard source files the registry is split into. Changing it reassigns most types and rewrites the index. */
+		kodgen::uint32	shardCount	= 8u;
+
+		virtual TypeRegistryCGM* clone() const noexcept override
+		{
+			return new TypeRegistryCGM(*this);
+		}
+
+		virtual std::string getName() const noexcept override
+		{
+			return "TypeRegistryCGM";
+		}
+
+		/**
+		*	@brief	Write the registry index and shards of a project in its output directory.
+		*			Types of the parsed files are the ones recorded during the run, other files keep the types saved by the previous run.
+		*			Files are only written if their content changed, so that only the shards of added or removed types are rebuilt.
+		*
+		*	@param outputDirectory	Output directory of the project generated files.
+		*	@param parsedFiles		Files of the project which have been parsed during the run.
+		*	@param upToDateFiles	Files of the project which have not been parsed during the run since they were up-to-date.
+		*	@param logger			Logger used to report errors, can be nullptr.
+		*
+		*	@return	true if the registry files are up-to-date, else false.
+		*			Fails if some files were not parsed and the manifest providing their types is missing or outdated.
+		*/
+		bool generateRegistryFiles(fs::path const&					outputDirectory,
+								   std::vector<fs::path> const&		parsedFiles,
+								   std::vector<fs::path> const&		upToDateFiles,
+								   kodgen::ILogger*					logger)			const	noexcept
+		{
+			GeneratorHelpers::AggregatedOutput<TypeRecord>::RecordsPerFile	typesPerFile;
+			std::string														properties;
+			kodgen::uint32 const											currentShardCount	= std::max(shardCount, 1u);
+
+			if (!_types.collectRecords(outputDirectory, parsedFiles, upToDateFiles, typesPerFile, properties))
+			{
+				if (logger != nullptr)
+				{
+					logger->log("The type registry manifest of " + outputDirectory.string() + " is missing or outdated, the types of the up-to-date files are unknown. Regenerate all files of the project.", kodgen::ILogger::ELogSeverity::Error);
+				}
+
+				return false;
+			}
+
+			//Assign each type to its shard, along with the file declaring it. Shards are sorted by USR so that they don't depend on the parsing order.
+			std::vector<std::map<std::string, std::pair<TypeRecord const*, std::string const*>>> shards(currentShardCount);
+
+			for (auto const& [sourceFile, types] : typesPerFile)
+			{
+				for (TypeRecord const& record : types)
+				{
+					shards[getShardIndex(record.usr, currentShardCount)].emplace(record.usr, std::make_pair(&record, &sourceFile));
+				}
+			}
+
+			std::string const	sep		= "\n";
+			bool				result	= true;
+
+			for (kodgen::uint32 shardIndex = 0u; shardIndex < currentShardCount; shardIndex++)
+			{
+				fs::path				shardPath = getShardPath(outputDirectory, shardIndex);
+				std::vector<fs::path>	includedFiles;
+				std::string				registrations;
+
+				for (auto const& [usr, type] : shards[shardIndex])
+				{
+					fs::path includedFile = fs::path(*type.second).lexically_relative(outputDirectory);
+
+					if (std::find(includedFiles.cbegin(), includedFiles.cend(), includedFile) == includedFiles.cend())
+					{
+						includedFiles.push_back(std::move(includedFile));
+					}
+
+					registrations += "	out_types.push_back({ \"" + type.first->name + "\", sizeof(::" + type.first->name + "), alignof(::" + type.first->name + ") });" + sep;
+				}
+
+				std::sort(includedFiles.begin(), includedFiles.end());
+
+				std::string shardContent =	"//Reflected types assigned to this shard by the hash of their USR, generated by TypeRegistryCGM" + sep + sep +
+											"#include \"" + _indexFilename + "\"" + sep + sep;
+
+				for (fs::path const& includedFile : includedFiles)
+				{
+					shardContent += "#include \"" + includedFile.generic_string() + "\"" + sep;
+				}
+
+				shardContent += ((includedFiles.empty()) ? "" : sep) +
+								"void kodgen_registry::registerShard" + std::to_string(shardIndex) + "(std::vector<TypeEntry>& " + ((registrations.empty()) ? "/* out_types */" : "out_types") + ")" + sep +
+								"{" + sep +
+								registrations +
+								"}" + sep;
+
+				result &= GeneratorHelpers::writeFileIfChanged(shardPath, shardContent, logger);
+			}
+
+			removeStaleShards(outputDirectory, currentShardCount);
+
+			std::string shardDeclarations;
+			std::string shardCalls;
+
+			for (kodgen::uint32 shardIndex = 0u; shardIndex < currentShardCount; shardIndex++)
+			{
+				shardDeclarations	+= "	void registerShard" + std::to_string(shardIndex) + "(std::vector<TypeEntry>& out_types);" + sep;
+				shardCalls			+= "		registerShard" + std::to_string(shardIndex) + "(result);" + sep;
+			}
+
+			//The index only depends on the shard count
+			std::string indexContent =	"#pragma once" + sep + sep +
+										"//Registry of all reflected types, split into " + std::to_string(currentShardCount) + " " + _shardFilenamePrefix + "<index>.cpp shards generated by TypeRegistryCGM" + sep + sep +
+										"#include <cstddef>" + sep +
+										"#include <vector>" + sep + sep +
+										"namespace kodgen_registry" + sep +
+										"{" + sep +
+										"	struct TypeEntry" + sep +
+										"	{" + sep +
+										"		char const*	name;" + sep +
+										"		std::size_t	size;" + sep +
+										"		std::size_t	alignment;" + sep +
+										"	};" + sep + sep +
+										"	constexpr std::size_t shardCount = " + std::to_string(currentShardCount) + "u;" + sep + sep +
+										shardDeclarations + sep +
+										"	inline std::vector<TypeEntry> getAllTypes()" + sep +
+										"	{" + sep +
+										"		std::vector<TypeEntry> result;" + sep + sep +
+										shardCalls + sep +
+										"		return result;" + sep +
+										"	}" + sep +
+										"}" + sep;
+
+			result &= GeneratorHelpers::writeFileIfChanged(outputDirectory / _indexFilename, indexContent, logger);
+
+			if (!_types.saveManifest(outputDirectory, typesPerFile, std::to_string(currentShardCount)) && logger != nullptr)
+			{
+				logger->log("Could not save the type registry manifest in " + outputDirectory.string() + ", the next incremental run will require regenerating all files.", kodgen::ILogger::ELogSeverity::Warning);
+			}
+
+			return result;
+		}
+};
\ No newline at end of file
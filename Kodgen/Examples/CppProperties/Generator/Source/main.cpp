@@ -2,10 +2,23 @@
 #include <Kodgen/CodeGen/CodeGenManager.h>
 #include <Kodgen/CodeGen/Macro/MacroCodeGenUnit.h>
 #include <Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h>
+#include <Kodgen/CodeGen/GeneratedHeaderProfiler.h>
 #include <Kodgen/Misc/Filesystem.h>
 #include <Kodgen/Misc/DefaultLogger.h>
 
+#include <vector>
+#include <string>
+#include <algorithm>	//std::max
+#include <cstdlib>		//std::atoi, std::atof
+
 #include "GetSetCGM.h"
+#include "MemoryLayoutCGM.h"
+#include "FieldIterationCGM.h"
+#include "ReplicationCGM.h"
+#include "TemplateInstantiationCGM.h"
+#include "MethodInvokerCGM.h"
+#include "ClassHierarchyCGM.h"
+#include "TypeRegistryCGM.h"
 
 void initCodeGenUnitSettings(fs::path const& workingDirectory, kodgen::MacroCodeGenUnitSettings& out_cguSettings)
 {
@@ -78,23 +91,85 @@ int main(int argc, char** argv)
 {
 	kodgen::DefaultLogger logger;
 
-	if (argc <= 1)
+	//Options come first:
+	//	--record <file>		Save the parsing results of the run to file.
+	//	--replay <file>		Don't parse anything, generate the code of the parsing results saved in file (first project only).
+	//	--repeat <count>	Number of times the code of each file is generated when replaying.
+	//	--progress <sec>	Display the progress of the generation every sec seconds.
+	//	--profile-headers <count>	Parse the generated files in isolation and report the count most expensive ones.
+	//	--pool-strings <0|1>	Store the field names and properties of each file in a single string pool.
+	fs::path	recordPath;
+	fs::path	replayPath;
+	int			replayRepetitionCount	= 1;
+	float		progressReportInterval	= 0.0f;
+	int			profiledHeaderCount		= 0;
+	bool		shouldPoolStrings		= false;
+	int			argIndex				= 1;
+
+	for (; argIndex + 1 < argc && std::string(argv[argIndex]).compare(0, 2, "--") == 0; argIndex += 2)
 	{
-		logger.log("No working directory provided as first program argument", kodgen::ILogger::ELogSeverity::Error);
-		return EXIT_FAILURE;
-	}
+		std::string option = argv[argIndex];
 
-	fs::path workingDirectory = argv[1];
+		if (option == "--record")
+		{
+			recordPath = argv[argIndex + 1];
+		}
+		else if (option == "--replay")
+		{
+			replayPath = argv[argIndex + 1];
+		}
+		else if (option == "--repeat")
+		{
+			replayRepetitionCount = std::max(std::atoi(argv[argIndex + 1]), 1);
+		}
+		else if (option == "--progress")
+		{
+			progressReportInterval = static_cast<float>(std::atof(argv[argIndex + 1]));
+		}
+		else if (option == "--profile-headers")
+		{
+			profiledHeaderCount = std::max(std::atoi(argv[argIndex + 1]), 0);
+		}
+		else if (option == "--pool-strings")
+		{
+			shouldPoolStrings = std::atoi(argv[argIndex + 1]) != 0;
+		}
+		else
+		{
+			logger.log("Unknown option " + option, kodgen::ILogger::ELogSeverity::Error);
+			return EXIT_FAILURE;
+		}
+	}
 
-	if (!fs::is_directory(workingDirectory))
+	if (argIndex >= argc)
 	{
-		logger.log("Provided working directory is not a directory or doesn't exist", kodgen::ILogger::ELogSeverity::Error);
+		logger.log("No working directory or settings file provided as program argument", kodgen::ILogger::ELogSeverity::Error);
 		return EXIT_FAILURE;
 	}
 
-	logger.log("Working Directory: " + workingDirectory.string());
+	//Each program argument is a project, all projects are processed in a single batch:
+	//	- a working directory uses the example project layout (WorkingDir/Include, generated to WorkingDir/Include/Generated),
+	//	- a .toml settings file (see KodgenSettings.toml) provides the code generation manager, unit and parsing settings of the project.
+	std::vector<fs::path> projectPaths(argv + argIndex, argv + argc);
+
+	for (fs::path const& projectPath : projectPaths)
+	{
+		if (fs::is_directory(projectPath))
+		{
+			logger.log("Working Directory: " + projectPath.string());
+		}
+		else if (fs::is_regular_file(projectPath) && projectPath.extension() == ".toml")
+		{
+			logger.log("Settings File: " + projectPath.string());
+		}
+		else
+		{
+			logger.log("Provided project " + projectPath.string() + " is neither a directory nor a .toml settings file", kodgen::ILogger::ELogSeverity::Error);
+			return EXIT_FAILURE;
+		}
+	}
 
-	//Setup FileParser
+	//Setup FileParser, shared by all working directory projects
 	kodgen::FileParser fileParser;
 	fileParser.logger = &logger;
 
@@ -104,34 +179,165 @@ int main(int argc, char** argv)
 		return EXIT_FAILURE;
 	}
 
-	//Setup code generation unit
+	//Setup code generation unit model
 	kodgen::MacroCodeGenUnit codeGenUnit;
 	codeGenUnit.logger = &logger;
 
-	kodgen::MacroCodeGenUnitSettings cguSettings;
-	initCodeGenUnitSettings(workingDirectory, cguSettings);
-	codeGenUnit.setSettings(cguSettings);
-
 	//Add code generation modules
 	GetSetCGM getSetCodeGenModule;
 	codeGenUnit.addModule(getSetCodeGenModule);
 
+	MemoryLayoutCGM memoryLayoutCodeGenModule;
+	codeGenUnit.addModule(memoryLayoutCodeGenModule);
+
+	FieldIterationCGM fieldIterationCodeGenModule;
+	fieldIterationCodeGenModule.shouldPoolStrings = shouldPoolStrings;
+	codeGenUnit.addModule(fieldIterationCodeGenModule);
+
+	ReplicationCGM replicationCodeGenModule;
+	codeGenUnit.addModule(replicationCodeGenModule);
+
+	TemplateInstantiationCGM templateInstantiationCodeGenModule;
+	codeGenUnit.addModule(templateInstantiationCodeGenModule);
+
+	MethodInvokerCGM methodInvokerCodeGenModule;
+	codeGenUnit.addModule(methodInvokerCodeGenModule);
+
+	ClassHierarchyCGM classHierarchyCodeGenModule;
+	codeGenUnit.addModule(classHierarchyCodeGenModule);
+
+	TypeRegistryCGM typeRegistryCodeGenModule;
+	codeGenUnit.addModule(typeRegistryCodeGenModule);
+
+	//Each project has its own output directory, hence its own code generation unit settings.
+	//Settings file projects also have their own parsing settings, hence their own file parser.
+	//Projects reference their file parser, code generation unit and settings, so don't let the vectors reallocate.
+	std::vector<kodgen::MacroCodeGenUnitSettings>											cguSettings(projectPaths.size());
+	std::vector<kodgen::FileParser>															fileParsers;
+	std::vector<kodgen::MacroCodeGenUnit>													codeGenUnits;
+	std::vector<kodgen::CodeGenProject<kodgen::FileParser, kodgen::MacroCodeGenUnit>>		projects;
+
+	fileParsers.reserve(projectPaths.size());
+	codeGenUnits.reserve(projectPaths.size());
+	projects.reserve(projectPaths.size());
+
+	for (size_t i = 0u; i < projectPaths.size(); i++)
+	{
+		fs::path const&	projectPath		= projectPaths[i];
+		bool			isSettingsFile	= !fs::is_directory(projectPath);
+
+		//Settings files only override the settings they specify: use the example layout relative to the settings file by default
+		initCodeGenUnitSettings(isSettingsFile ? projectPath.parent_path() : projectPath, cguSettings[i]);
+
+		if (isSettingsFile)
+		{
+			fileParsers.emplace_back();
+			fileParsers.back().logger = &logger;
+
+			if (!initParsingSettings(fileParsers.back().getSettings()) ||
+				!fileParsers.back().getSettings().loadFromFile(projectPath, &logger) ||
+				!cguSettings[i].loadFromFile(projectPath, &logger))
+			{
+				logger.log("Could not load the settings file " + projectPath.string(), kodgen::ILogger::ELogSeverity::Error);
+				return EXIT_FAILURE;
+			}
+		}
+
+		//The contributions of the modules are only measured to profile the generated headers
+		cguSettings[i].shouldMeasureModuleContributions |= (profiledHeaderCount > 0);
+
+		//Copying the model unit clones its modules
+		codeGenUnits.emplace_back(codeGenUnit);
+		codeGenUnits.back().setSettings(cguSettings[i]);
+
+		projects.emplace_back(isSettingsFile ? fileParsers.back() : fileParser, codeGenUnits.back());
+
+		if (!isSettingsFile)
+		{
+			initCodeGenManagerSettings(projectPath, projects.back().settings);
+		}
+		else if (!projects.back().settings.loadFromFile(projectPath, &logger))
+		{
+			logger.log("Could not load the settings file " + projectPath.string(), kodgen::ILogger::ELogSeverity::Error);
+			return EXIT_FAILURE;
+		}
+	}
+
 	//Setup CodeGenManager
 	kodgen::CodeGenManager codeGenMgr;
 	codeGenMgr.logger = &logger;
 
-	initCodeGenManagerSettings(workingDirectory, codeGenMgr.settings);
+	if (progressReportInterval > 0.0f)
+	{
+		codeGenMgr.shouldDisplayProgress	= true;
+		codeGenMgr.progressReportInterval	= progressReportInterval;
+	}
+
+	kodgen::ParsingResultSnapshot parsingResultSnapshot;
+
+	//Replay the code generation of recorded parsing results, to benchmark code generation modules without parsing noise
+	if (!replayPath.empty())
+	{
+		if (!parsingResultSnapshot.load(replayPath))
+		{
+			logger.log("Could not load the parsing results snapshot " + replayPath.string(), kodgen::ILogger::ELogSeverity::Error);
+			return EXIT_FAILURE;
+		}
+
+		kodgen::CodeGenReplayResult replayResult = codeGenMgr.replay(parsingResultSnapshot, codeGenUnits.front(), static_cast<kodgen::uint32>(replayRepetitionCount));
+
+		return (replayResult.completed) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (!recordPath.empty())
+	{
+		codeGenMgr.parsingResultsRecorder = &parsingResultSnapshot;
+	}
 
 	//Kick-off code generation
-	kodgen::CodeGenResult genResult = codeGenMgr.run(fileParser, codeGenUnit, true);
+	std::vector<kodgen::CodeGenResult> genResults = codeGenMgr.runBatch(projects, true);
 
-	if (genResult.completed)
+	if (!recordPath.empty() && !parsingResultSnapshot.save(recordPath))
 	{
-		logger.log("Generation completed successfully in " + std::to_string(genResult.duration) + " seconds.");
+		logger.log("Could not save the parsing results snapshot " + recordPath.string(), kodgen::ILogger::ELogSeverity::Error);
 	}
-	else
+
+	for (size_t i = 0u; i < genResults.size(); i++)
 	{
-		logger.log("An error happened during code generation.", kodgen::ILogger::ELogSeverity::Error);
+		//Number the classes of the whole project once all its files are generated
+		if (genResults[i].completed && !classHierarchyCodeGenModule.generateHierarchyFile(cguSettings[i].getOutputDirectory(), genResults[i].parsedFiles, genResults[i].upToDateFiles, &logger))
+		{
+			genResults[i].completed = false;
+		}
+
+		//Register the types of the whole project in shards, only the shards of added or removed types change
+		if (genResults[i].completed && !typeRegistryCodeGenModule.generateRegistryFiles(cguSettings[i].getOutputDirectory(), genResults[i].parsedFiles, genResults[i].upToDateFiles, &logger))
+		{
+			genResults[i].completed = false;
+		}
+
+		if (genResults[i].completed)
+		{
+			logger.log("Generation of " + projectPaths[i].string() + " completed successfully in " + std::to_string(genResults[i].duration) + " seconds.");
+		}
+		else
+		{
+			logger.log("An error happened during code generation of " + projectPaths[i].string() + ".", kodgen::ILogger::ELogSeverity::Error);
+		}
+	}
+
+	//Find the generated files which are the most expensive to compile
+	if (profiledHeaderCount > 0)
+	{
+		kodgen::GeneratedHeaderProfiler generatedHeaderProfiler;
+		generatedHeaderProfiler.logger				= &logger;
+		generatedHeaderProfiler.reportedFileCount	= static_cast<size_t>(profiledHeaderCount);
+
+		//Settings file projects have their own parsing settings
+		for (size_t i = 0u; i < genResults.size(); i++)
+		{
+			generatedHeaderProfiler.profile(projects[i].fileParser.getSettings(), genResults[i].generatedFileContributions);
+		}
 	}
 
 	return EXIT_SUCCESS;
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+#include "Generated/GameEntity.h.h"
+
+namespace SomeNamespace KGNamespace()
+{
+	class KGClass() GameEntity
+	{
+		public:
+			//Read every frame
+			float		position[3]	= { 0.0f, 0.0f, 0.0f };
+			float		velocity[3]	= { 0.0f, 0.0f, 0.0f };
+			unsigned	flags		= 0u;
+
+		private:
+			//Sent over the network when modified
+			KGField(Replicated)
+			int			health		= 100;
+
+			KGField(Replicated)
+			unsigned	score		= 0u;
+
+		public:
+		//Rarely read, only visible to the parser: storage and accessors are generated in a separately allocated struct
+		#ifdef KODGEN_PARSING
+			KGField(Cold)
+			std::string	debugName;
+
+			KGField(Cold)
+			double		spawnTime;
+		#endif
+
+		SomeNamespace_GameEntity_GENERATED
+	};
+}
+
+File_GameEntity_GENERATED
\ No newline at end of file
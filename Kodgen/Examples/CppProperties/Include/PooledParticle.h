@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Generated/PooledParticle.h.h"
+
+namespace SomeNamespace KGNamespace()
+{
+	//Small and frequently allocated: use the generated pool
+	class KGClass(Pooled[4096]) PooledParticle
+	{
+		public:
+			float	position[3]	= { 0.0f, 0.0f, 0.0f };
+			float	velocity[3]	= { 0.0f, 0.0f, 0.0f };
+			int		lifetime	= 0;
+
+		SomeNamespace_PooledParticle_GENERATED
+	};
+
+	//Same layout, allocated with the default allocator
+	class Particle
+	{
+		public:
+			float	position[3]	= { 0.0f, 0.0f, 0.0f };
+			float	velocity[3]	= { 0.0f, 0.0f, 0.0f };
+			int		lifetime	= 0;
+	};
+}
+
+File_PooledParticle_GENERATED
\ No newline at end of file
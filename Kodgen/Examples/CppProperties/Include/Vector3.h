@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Generated/Vector3.h.h"
+
+namespace SomeNamespace KGNamespace()
+{
+	//Instantiated once in Vector3.cpp, other translation units only reference the listed instantiations
+	template <typename T>
+	class KGClass(Instantiate[int, float, double]) Vector3
+	{
+		public:
+			T	x = T{};
+			T	y = T{};
+			T	z = T{};
+
+			T		dot(Vector3 const& other)	const noexcept;
+			Vector3	cross(Vector3 const& other)	const noexcept;
+
+		SomeNamespace_Vector3_GENERATED
+	};
+
+	template <typename T>
+	T Vector3<T>::dot(Vector3 const& other) const noexcept
+	{
+		return x * other.x + y * other.y + z * other.z;
+	}
+
+	template <typename T>
+	Vector3<T> Vector3<T>::cross(Vector3 const& other) const noexcept
+	{
+		return Vector3{ y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x };
+	}
+}
+
+File_Vector3_GENERATED
\ No newline at end of file
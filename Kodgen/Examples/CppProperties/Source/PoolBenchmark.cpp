@@ -0,0 +1,76 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include "PooledParticle.h"
+
+/**
+*	Allocate and free batches of objects in a random order, from several threads at once.
+*
+*	@return The average time spent per allocation/deallocation pair, in nanoseconds.
+*/
+template <typename T>
+double runBenchmark(size_t threadCount, size_t rounds, size_t objectsPerRound)
+{
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0u; i < threadCount; i++)
+	{
+		threads.emplace_back([rounds, objectsPerRound, seed = static_cast<unsigned>(i)]()
+							 {
+								 std::mt19937	randomEngine(seed);
+								 std::vector<T*>	objects(objectsPerRound, nullptr);
+
+								 for (size_t round = 0u; round < rounds; round++)
+								 {
+									 for (T*& object : objects)
+									 {
+										 object = new T();
+									 }
+
+									 //Free in a random order to avoid measuring a LIFO-only pattern
+									 std::shuffle(objects.begin(), objects.end(), randomEngine);
+
+									 for (T* object : objects)
+									 {
+										 delete object;
+									 }
+								 }
+							 });
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	return elapsed.count() / static_cast<double>(threadCount * rounds * objectsPerRound);
+}
+
+int main()
+{
+	constexpr size_t rounds				= 200u;
+	constexpr size_t objectsPerRound	= 10000u;
+
+	size_t maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << "Object size: " << sizeof(SomeNamespace::PooledParticle) << " bytes" << std::endl;
+
+	for (size_t threadCount = 1u; threadCount <= maxThreadCount; threadCount *= 2u)
+	{
+		double defaultAllocatorTime	= runBenchmark<SomeNamespace::Particle>(threadCount, rounds, objectsPerRound);
+		double pooledAllocatorTime	= runBenchmark<SomeNamespace::PooledParticle>(threadCount, rounds, objectsPerRound);
+
+		std::cout << threadCount << " thread(s): default allocator " << defaultAllocatorTime << " ns/op, pooled allocator " << pooledAllocatorTime << " ns/op" << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
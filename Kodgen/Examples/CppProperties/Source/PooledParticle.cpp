@@ -0,0 +1 @@
+#include "Generated/PooledParticle.src.h"	//Must be last include
\ No newline at end of file
@@ -0,0 +1,3 @@
+//Other includes if necessary
+
+#include "Generated/Vector3.src.h"	//Must be last include
\ No newline at end of file
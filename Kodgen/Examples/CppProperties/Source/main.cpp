@@ -1,7 +1,10 @@
 #include <iostream>
+#include <vector>
 
 #include "SomeClass.h"
 #include "SomeOtherClass.h"
+#include "GameEntity.h"
+#include "Vector3.h"
 
 int main()
 {
@@ -27,6 +30,12 @@ int main()
 	std::cout << someClass.get_someUnsignedLongLong()	<< std::endl;
 	std::cout << someClass.get_someString()				<< std::endl;
 
+	//Iterate over reflected fields without any runtime field list
+	kodgen_fields::for_each_field(someClass, [](auto const& field, auto const& /* value */)
+								  {
+									  std::cout << field.name << " has " << field.properties.size() << " properties" << std::endl;
+								  });
+
 	SomeNamespace::SomeOtherClass	someOtherClass;
 
 	std::cout << someOtherClass.get_someFloat() << std::endl;
@@ -34,5 +43,31 @@ int main()
 	std::cout << someOtherClass.get_someVectorOfSomeClass().data() << std::endl;
 	std::cout << someOtherClass.get_someUmapOfSomeClass2().size() << std::endl;
 
+	SomeNamespace::GameEntity gameEntity;
+	gameEntity.debugName() = "Player";
+
+	std::cout << gameEntity.debugName() << " " << sizeof(SomeNamespace::GameEntity) << std::endl;
+
+	//Only the modified fields are encoded
+	std::vector<unsigned char> delta;
+	gameEntity.setScore(10u);
+	gameEntity.forEachDirtyField([](std::size_t /* index */, char const* name, auto const& value) { std::cout << name << " changed to " << value << std::endl; });
+
+	std::cout << "Delta size: " << gameEntity.serializeDelta(delta) << " bytes" << std::endl;
+	gameEntity.clearDirtyFields();
+
+	SomeNamespace::GameEntity replicatedGameEntity;
+
+	if (replicatedGameEntity.deserializeDelta(delta.data(), delta.size()) != delta.size())
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Vector3<float> is explicitly instantiated in Vector3.cpp only
+	SomeNamespace::Vector3<float> forward{ 0.0f, 0.0f, 1.0f };
+	SomeNamespace::Vector3<float> right{ 1.0f, 0.0f, 0.0f };
+
+	std::cout << right.cross(forward).y << " " << right.dot(forward) << std::endl;
+
 	return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -8,15 +8,28 @@
 #pragma once
 
 #include <set>
+#include <vector>
+#include <mutex>
+#include <algorithm>	//std::max
 #include <cassert>
 #include <type_traits>	//std::is_base_of
 #include <chrono>		//std::chrono::high_resolution_clock
 
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/AllocationTracker.h"
 #include "Kodgen/CodeGen/CodeGenResult.h"
+#include "Kodgen/CodeGen/CodeGenReplayResult.h"
+#include "Kodgen/CodeGen/GeneratedFile.h"
 #include "Kodgen/CodeGen/CodeGenUnit.h"
+#include "Kodgen/CodeGen/CodeGenProject.h"
+#include "Kodgen/CodeGen/CodeGenProgress.h"
+#include "Kodgen/CodeGen/CodeGenProgressTracker.h"
+#include "Kodgen/CodeGen/FileCostHistory.h"
+#include "Kodgen/CodeGen/EntityStreamingQueue.h"
+#include "Kodgen/CodeGen/GitIndexChangeDetector.h"
 #include <Kodgen/CodeGen/CodeGenManagerSettings.h>
 #include "Kodgen/Parsing/FileParser.h"
+#include "Kodgen/Parsing/ParsingResults/ParsingResultSnapshot.h"
 #include "Kodgen/Threading/ThreadPool.h"
 #include "Kodgen/Threading/TaskHelper.h"
 
@@ -26,62 +39,210 @@ namespace kodgen
 	{
 		private:
 			/** Thread pool used for files processing. */
-			ThreadPool	_threadPool;
+			ThreadPool				_threadPool;
+
+			/** Tracker collecting the progress of the running generation, only started if the progress is reported. */
+			CodeGenProgressTracker	_progressTracker;
+
+			/**
+			*	Files of a single project to process, with the objects used to process them.
+			*	Processing methods take several jobs to schedule the files of all projects on the same thread pool stages.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			struct ProcessingJob
+			{
+				/** Original file parser used to parse the files. */
+				FileParserType*		fileParser;
+
+				/** Generation unit used to generate the files. */
+				CodeGenUnitType*	codeGenUnit;
+
+				/** Collection of all files to process. */
+				std::set<fs::path>	toProcessFiles;
+
+				/** Generation result to fill during file generation. */
+				CodeGenResult*		genResult;
+
+				/** Cost of each file in the previous runs, only loaded if the progress is tracked. */
+				FileCostHistory		fileCostHistory;
+
+				/** Provisional generation task of each file to process (same order as toProcessFiles), empty if provisional files are not generated. */
+				std::vector<std::shared_ptr<TaskBase>>	provisionalTasks;
+			};
+
+			/** Result of a file parsing task. */
+			struct ParsingTaskResult
+			{
+				/** Result of the file parsing. */
+				FileParsingResult		parsingResult;
+
+				/** Code already generated for the top-level entities streamed during the parsing. */
+				StreamedEntitiesCode	streamedEntitiesCode;
+			};
+
+			/**
+			*	@brief	Parse a file with a parser, streaming its top-level entities to the thread pool for generation
+			*			if the code generation unit allows it (see CodeGenUnitSettings::shouldStreamEntities).
+			*	
+			*	@param fileParser	Parser used to parse the file. It must not be used by another thread.
+			*	@param codeGenUnit	Generation unit model copied to generate the streamed entities.
+			*	@param file			Path to the file to parse.
+			*	@param parse		Callable parsing the file, taking the parser and the FileParsingResult to fill as parameters.
+			*
+			*	@return The parsing result, with the code generated for its streamed entities.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType, typename ParseCallable>
+			ParsingTaskResult	parseFile(FileParserType&			fileParser,
+										  CodeGenUnitType const&	codeGenUnit,
+										  fs::path const&			file,
+										  ParseCallable				parse)											noexcept;
 
 			/**
-			*	@brief Process all provided files on multiple threads.
+			*	@brief Process all files of the provided jobs on multiple threads.
 			*	
-			*	@param fileParser		Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
-			*	@param codeGenUnit		Generation unit used to generate files. It must have a clean state when this method is called.
-			*	@param toProcessFiles	Collection of all files to process.
-			*	@param out_genResult	Reference to the generation result to fill during file generation.
+			*	@param jobs Jobs to process. Each job file parser and code generation unit must have a clean state when this method is called.
 			*/
 			template <typename FileParserType, typename CodeGenUnitType>
-			void	processFiles(FileParserType&			fileParser,
-								 CodeGenUnitType&			codeGenUnit,
-								 std::set<fs::path> const&	toProcessFiles,
-								 CodeGenResult&				out_genResult)										noexcept;
+			void	processFiles(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs)					noexcept;
 
 			/**
-			*	@brief Process all provided files ignoring Clang parsing errors on multiple threads.
+			*	@brief Process all files of the provided jobs ignoring Clang parsing errors on multiple threads.
 			*	
-			*	@param fileParser		Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
-			*	@param codeGenUnit		Generation unit used to generate files. It must have a clean state when this method is called.
-			*	@param toProcessFiles	Collection of all files to process.
-			*	@param out_genResult	Reference to the generation result to fill during file generation.
+			*	@param jobs Jobs to process.
 			*/
 			template <typename FileParserType, typename CodeGenUnitType>
-			void	processFilesIgnoreErrors(FileParserType&			fileParser,
-											 CodeGenUnitType&			codeGenUnit,
-											 std::set<fs::path> const&	toProcessFiles,
-											 CodeGenResult&				out_genResult)							noexcept;
+			void	processFilesIgnoreErrors(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs)		noexcept;
 
 			/**
-			*	@brief Process all provided files and fail on any Clang parsing errors on multiple threads.
+			*	@brief Process all files of the provided jobs and fail on any Clang parsing errors on multiple threads.
 			*	
-			*	@param fileParser		Original file parser to use to parse registered files. A copy of this parser will be used for each generation thread.
-			*	@param codeGenUnit		Generation unit used to generate files. It must have a clean state when this method is called.
-			*	@param toProcessFiles	Collection of all files to process.
-			*	@param out_genResult	Reference to the generation result to fill during file generation.
+			*	@param jobs Jobs to process.
 			*/
 			template <typename FileParserType, typename CodeGenUnitType>
-			void	processFilesFailOnErrors(FileParserType&			fileParser,
-											 CodeGenUnitType&			codeGenUnit,
-											 std::set<fs::path> const&	toProcessFiles,
-											 CodeGenResult&				out_genResult)							noexcept;
+			void	processFilesFailOnErrors(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs)		noexcept;
+
+			/**
+			*	@brief	Check whether a file should be parsed & regenerated, and register it as up-to-date otherwise.
+			*			If the git index change detector is loaded, it is queried before the CodeGenUnit.
+			*			If projectSettings.shouldExplainFileProcessing is true, the reason of the decision is logged and added to the generation result.
+			*	
+			*	@param projectSettings			Generation settings of the project containing the file.
+			*	@param gitIndexChangeDetector	Change detector of the project containing the file.
+			*	@param codeGenUnit				Generation unit used to determine whether the file should be reparsed/regenerated or not.
+			*	@param file						Path to the file to check.
+			*	@param out_genResult			Reference to the generation result to fill.
+			*	@param forceRegenerateAll		Should the file be regenerated even if it is up-to-date.
+			*
+			*	@return true if the file should be processed, else false.
+			*/
+			bool					shouldProcessFile(CodeGenManagerSettings&		projectSettings,
+													  GitIndexChangeDetector&		gitIndexChangeDetector,
+													  CodeGenUnit const&			codeGenUnit,
+													  fs::path const&				file,
+													  CodeGenResult&				out_genResult,
+													  bool							forceRegenerateAll)		noexcept;
 
 			/**
 			*	@brief Identify all files which will be parsed & regenerated.
 			*	
-			*	@param codeGenUnit			Generation unit used to determine whether a file should be reparsed/regenerated or not.
-			*	@param out_genResult		Reference to the generation result to fill during file generation.
-			*	@param forceRegenerateAll	Should all files be regenerated or not (regardless of CodeGenManager::shouldRegenerateFile() returned value).
+			*	@param projectSettings			Generation settings of the project.
+			*	@param gitIndexChangeDetector	Change detector of the project, loaded by this method.
+			*	@param codeGenUnit				Generation unit used to determine whether a file should be reparsed/regenerated or not.
+			*	@param out_genResult			Reference to the generation result to fill during file generation.
+			*	@param forceRegenerateAll		Should all files be regenerated or not (regardless of CodeGenManager::shouldRegenerateFile() returned value).
 			*
 			*	@return A collection of all files which will be regenerated.
 			*/
-			std::set<fs::path>		identifyFilesToProcess(CodeGenUnit const&	codeGenUnit,
-														   CodeGenResult&		out_genResult,
-														   bool					forceRegenerateAll)				noexcept;
+			std::set<fs::path>		identifyFilesToProcess(CodeGenManagerSettings&			projectSettings,
+														   GitIndexChangeDetector&			gitIndexChangeDetector,
+														   CodeGenUnit const&				codeGenUnit,
+														   CodeGenResult&					out_genResult,
+														   bool								forceRegenerateAll)	noexcept;
+
+			/**
+			*	@brief	Submit the tasks writing the provisional generated files of all files to process, without waiting for them,
+			*			so that the files compile while the full generation is running.
+			*			The tasks are submitted before the full generation tasks so that workers pick them first
+			*			(the pool executes the first ready task), and the parsing of a file must depend on its provisional task
+			*			so that the provisional files never overwrite the fully generated ones.
+			*
+			*	@param codeGenUnit		Generation unit used to generate the provisional files.
+			*	@param toProcessFiles	Collection of all files to process. It must outlive the submitted tasks.
+			*
+			*	@return The provisional task of each file to process, in the same order as toProcessFiles.
+			*/
+			std::vector<std::shared_ptr<TaskBase>>	generateProvisionalFiles(CodeGenUnit const&			codeGenUnit,
+																			 std::set<fs::path> const&	toProcessFiles)		noexcept;
+
+			/**
+			*	@brief Fill the allocation report of a generation result and log it if it contains any allocation.
+			*
+			*	@param allocationsAtStart	Allocation report taken at the beginning of the run.
+			*	@param out_genResult		Generation result to fill.
+			*/
+			void					reportAllocations(AllocationReport const&	allocationsAtStart,
+													  CodeGenResult&			out_genResult)			const	noexcept;
+
+			/**
+			*	@brief Fill the thread pool statistics of a generation result and log them if the pool executed any task.
+			*
+			*	@param out_genResult Generation result to fill.
+			*/
+			void					reportThreadPoolStatistics(CodeGenResult& out_genResult)		const	noexcept;
+
+			/**
+			*	@brief Start tracking the progress of a run if it is reported (see progressCallback and shouldDisplayProgress).
+			*/
+			void					startProgressTracking()											noexcept;
+
+			/**
+			*	@brief	Save the cost of the processed files measured by the progress tracker with the costs of the previous runs,
+			*			in the output directory of a code generation unit.
+			*
+			*	@param fileCostHistory	Costs of the previous runs, updated with the measured costs.
+			*	@param codeGenUnit		Generation unit whose output directory will contain the history.
+			*	@param processedFiles	Files processed during this run.
+			*/
+			void					saveFileCostHistory(FileCostHistory&			fileCostHistory,
+														CodeGenUnit const&			codeGenUnit,
+														std::set<fs::path> const&	processedFiles)		noexcept;
+
+			/**
+			*	@brief	Load a git index change detector if projectSettings.shouldUseGitIndexChangeDetection is true.
+			*	
+			*	@param projectSettings			Generation settings of the project.
+			*	@param gitIndexChangeDetector	Change detector to load. It is reset even if the setting is disabled.
+			*	@param codeGenUnit				Generation unit whose output directory contains the manifest of the previous run.
+			*/
+			void					loadGitIndexChangeDetector(CodeGenManagerSettings&			projectSettings,
+															   GitIndexChangeDetector&			gitIndexChangeDetector,
+															   CodeGenUnit const&				codeGenUnit)		noexcept;
+
+			/**
+			*	@brief	Save a git index change detector manifest for the next run, if it has been loaded.
+			*			Nothing is saved if the generation failed so that the next run checks all files again.
+			*	
+			*	@param gitIndexChangeDetector	Change detector to save.
+			*	@param codeGenUnit				Generation unit whose output directory will contain the manifest.
+			*	@param genResult				Result of the generation.
+			*/
+			void					saveGitIndexChangeDetectorManifest(GitIndexChangeDetector const&	gitIndexChangeDetector,
+																	   CodeGenUnit const&				codeGenUnit,
+																	   CodeGenResult const&				genResult)	noexcept;
+
+			/**
+			*	@brief Load the generated file pack of a generation unit, if its generated files are packed.
+			*	
+			*	@param codeGenUnit Generation unit whose output directory contains the pack.
+			*/
+			void					loadGeneratedFilePack(CodeGenUnit& codeGenUnit)										noexcept;
+
+			/**
+			*	@brief Save (and extract) the generated file pack of a generation unit, if its generated files are packed.
+			*	
+			*	@param codeGenUnit Generation unit whose output directory will contain the pack.
+			*/
+			void					saveGeneratedFilePack(CodeGenUnit const& codeGenUnit)									noexcept;
 
 			/**
 			*	@brief	Get the number of threads to use based on the provided thread count.
@@ -106,13 +267,15 @@ namespace kodgen
 			/**
 			*	@brief Check that everything is setup correctly for generation.
 			* 
+			*	@param projectSettings	Generation settings of the project.
 			*	@param fileParser	The file parser to using during the generation process.
 			*	@param codeGenUnit	The code generation to use during the generation process.
 			* 
 			*	@return true if all settings are correct, else false.
 			*/
-			bool					checkGenerationSetup(FileParser const&	fileParser,
-														 CodeGenUnit const& codeGenUnit)						noexcept;
+			bool					checkGenerationSetup(CodeGenManagerSettings&		projectSettings,
+														 FileParser const&				fileParser,
+														 CodeGenUnit const&				codeGenUnit)			noexcept;
 
 		public:
 			/** Logger used to issue logs from the CodeGenManager. */
@@ -121,6 +284,24 @@ namespace kodgen
 			/** Struct containing all generation settings. */
 			CodeGenManagerSettings	settings;
 
+			/**
+			*	If not nullptr, the result of each successfully parsed file is added to this snapshot before its code generation,
+			*	so that the generation can be replayed later without parsing (see replay).
+			*/
+			ParsingResultSnapshot*	parsingResultsRecorder	= nullptr;
+
+			/**
+			*	Callback periodically called from a dedicated thread with the progress of the running generation, and once at the end of the run.
+			*	The remaining time is estimated with the cost of each file saved in the output directory by the previous runs.
+			*/
+			std::function<void(CodeGenProgress const&)>	progressCallback;
+
+			/** Should the progress of the running generation be displayed on a single line of the standard output? */
+			bool										shouldDisplayProgress	= false;
+
+			/** Time (in seconds) between 2 progress reports. */
+			float										progressReportInterval	= 0.5f;
+
 			/**
 			*	@brief Construct a CodeGenManager that will work with the specified number of threads.
 			* 
@@ -144,6 +325,38 @@ namespace kodgen
 			CodeGenResult run(FileParserType&	fileParser,
 							  CodeGenUnitType&	codeGenUnit,
 							  bool				forceRegenerateAll	= false)	noexcept;
+
+			/**
+			*	@brief	Run the code generation of several projects at once.
+			*			Files of all projects are scheduled together on the thread pool, so that small projects don't leave threads idle,
+			*			and parsing settings shared by several projects are initialized once.
+			*			CodeGenManager::settings is not used, each project provides its own settings.
+			*
+			*	@param projects				Projects to process.
+			*	@param forceRegenerateAll	Ignore the last write time check and reparse / regenerate all files.
+			*
+			*	@return	The generation report of each project, in the same order as the projects.
+			*			The allocation report and thread pool statistics cover the whole batch and are only filled in the first report.
+			*/
+			template <typename FileParserType, typename CodeGenUnitType>
+			std::vector<CodeGenResult> runBatch(std::vector<CodeGenProject<FileParserType, CodeGenUnitType>>&	projects,
+												bool															forceRegenerateAll	= false)	noexcept;
+
+			/**
+			*	@brief	Run the code generation on parsing results recorded in a snapshot, without parsing anything.
+			*			Used to benchmark code generation units and modules in isolation from libclang.
+			*			Generated files are written to the code generation unit output directory as during a normal run.
+			*
+			*	@param snapshot			Snapshot containing the parsing results to generate code for.
+			*	@param codeGenUnit		Generation unit used to generate code. It must have a clean state when this method is called.
+			*	@param repetitionCount	Number of times the code of each file is generated.
+			*
+			*	@return Structure containing the replay report.
+			*/
+			template <typename CodeGenUnitType>
+			CodeGenReplayResult replay(ParsingResultSnapshot const&	snapshot,
+									   CodeGenUnitType&				codeGenUnit,
+									   uint32						repetitionCount	= 1u)	noexcept;
 	};
 
 	#include "Kodgen/CodeGen/CodeGenManager.inl"
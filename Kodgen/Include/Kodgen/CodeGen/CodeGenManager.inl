@@ -5,48 +5,165 @@
 *	See the LICENSE.md file for full license details.
 */
 
-template <typename FileParserType, typename CodeGenUnitType>
-void CodeGenManager::processFiles(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::set<fs::path> const& toProcessFiles, CodeGenResult& out_genResult) noexcept
+template <typename FileParserType, typename CodeGenUnitType, typename ParseCallable>
+CodeGenManager::ParsingTaskResult CodeGenManager::parseFile(FileParserType& fileParser, CodeGenUnitType const& codeGenUnit, fs::path const& file, ParseCallable parse) noexcept
 {
-	ParsingSettings parsingSettings = fileParser.getSettings();
-	if (!parsingSettings.shouldFailCodeGenerationOnClangErrors)
+	ParsingTaskResult						result;
+	std::shared_ptr<EntityStreamingQueue>	streamingQueue;
+	fs::path								parsedFile = FilesystemHelpers::sanitizePath(file);
+
+	fileParser.generatedFilePack = codeGenUnit.getGeneratedFilePack();
+
+	if (codeGenUnit.getSettings()->shouldStreamEntities && codeGenUnit.canStreamEntities())
 	{
-		processFilesIgnoreErrors(fileParser, codeGenUnit, toProcessFiles, out_genResult);
+		streamingQueue = std::make_shared<EntityStreamingQueue>();
+
+		//Tasks may run after the end of the parsing, so they share the queue ownership
+		fileParser.topLevelEntityListener = [this, streamingQueue, &codeGenUnit, &parsedFile](EntityInfo const& entity)
+		{
+			streamingQueue->push(entity);
+
+			auto streamedGenerationTaskLambda = [streamingQueue, &codeGenUnit, parsedFile](TaskBase*)
+			{
+				if (streamingQueue->hasPendingEntities())
+				{
+					//Copy the generation unit model to have a fresh one for this generation unit
+					CodeGenUnitType generationUnit = codeGenUnit;
+
+					while (streamingQueue->generateNext(generationUnit, parsedFile));
+				}
+			};
+
+			_threadPool.submitTask(std::string("Streamed generation ") + parsedFile.string(), streamedGenerationTaskLambda);
+		};
 	}
-	else
+
+	parse(fileParser, result.parsingResult);
+
+	if (streamingQueue != nullptr)
 	{
-		processFilesFailOnErrors(fileParser, codeGenUnit, toProcessFiles, out_genResult);
+		//Generate the entities no worker has picked yet instead of waiting for a worker to be available
+		if (streamingQueue->hasPendingEntities())
+		{
+			CodeGenUnitType generationUnit = codeGenUnit;
+
+			while (streamingQueue->generateNext(generationUnit, parsedFile));
+		}
+
+		streamingQueue->waitForRunningGenerations();
+
+		result.streamedEntitiesCode = streamingQueue->takeGeneratedCode();
+		fileParser.topLevelEntityListener = nullptr;
 	}
+
+	return result;
 }
 
 template <typename FileParserType, typename CodeGenUnitType>
-void CodeGenManager::processFilesFailOnErrors(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::set<fs::path> const& toProcessFiles, CodeGenResult& out_genResult) noexcept
+void CodeGenManager::processFiles(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs) noexcept
 {
-	std::vector<std::shared_ptr<TaskBase>>	generationTasks;
+	std::vector<ProcessingJob<FileParserType, CodeGenUnitType>> ignoreErrorsJobs;
+	std::vector<ProcessingJob<FileParserType, CodeGenUnitType>> failOnErrorsJobs;
 
-	//Reserve enough space for all tasks
-	generationTasks.reserve(toProcessFiles.size());
+	//Jobs are not used after processing, move them to the list matching their parsing settings
+	for (ProcessingJob<FileParserType, CodeGenUnitType>& job : jobs)
+	{
+		if (_progressTracker.isTracking())
+		{
+			job.fileCostHistory.load(job.codeGenUnit->getSettings()->getOutputDirectory());
+		}
 
-	//Launch all parsing -> generation processes
-	std::shared_ptr<TaskBase> parsingTask;
-	std::shared_ptr<TaskBase> preParsingTask;
+		if (logger != nullptr && job.codeGenUnit->getSettings()->shouldStreamEntities && !job.codeGenUnit->canStreamEntities())
+		{
+			logger->log("shouldStreamEntities is enabled but the code generation unit or one of its generators needs the whole file context, entities are not streamed.", ILogger::ELogSeverity::Warning);
+		}
+
+		if (!job.fileParser->getSettings().shouldFailCodeGenerationOnClangErrors)
+		{
+			ignoreErrorsJobs.emplace_back(std::move(job));
+		}
+		else
+		{
+			failOnErrorsJobs.emplace_back(std::move(job));
+		}
+	}
+
+	if (!ignoreErrorsJobs.empty())
+	{
+		processFilesIgnoreErrors(ignoreErrorsJobs);
+	}
+
+	if (!failOnErrorsJobs.empty())
+	{
+		processFilesFailOnErrors(failOnErrorsJobs);
+	}
+
+	if (_progressTracker.isTracking())
+	{
+		for (std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>* processedJobs : { &ignoreErrorsJobs, &failOnErrorsJobs })
+		{
+			for (ProcessingJob<FileParserType, CodeGenUnitType>& job : *processedJobs)
+			{
+				saveFileCostHistory(job.fileCostHistory, *job.codeGenUnit, job.toProcessFiles);
+			}
+		}
+	}
+}
+
+template <typename FileParserType, typename CodeGenUnitType>
+void CodeGenManager::processFilesFailOnErrors(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs) noexcept
+{
+	//Processing state of a single job
+	struct JobState
+	{
+		const kodgen::MacroCodeGenUnitSettings*				codeGenSettings = nullptr;
+		std::set<fs::path>									filesLeftToProcess;
+		std::set<fs::path>									filesToProcessThisIteration;
+		std::vector<std::pair<fs::path, ParsingError>>		parsingResultsOfFailedFiles;
+		std::vector<std::set<std::string>>					fileMacrosToDefine;
+		std::vector<std::shared_ptr<TaskBase>>				parsingTasks;
+		std::vector<std::shared_ptr<TaskBase>>				generationTasks;
+		size_t												filesLeftBefore = 0;
+		bool												isActive = true;
+	};
+
+	std::vector<JobState>	jobStates(jobs.size());
+	bool					isAnyJobActive = true;
+	bool					isFirstCycle = true;
+
+	//Parsing tasks of all jobs report their failures concurrently
+	std::mutex				failedFilesMutex;
+
+	for (size_t i = 0u; i < jobs.size(); i++)
+	{
+		jobStates[i].codeGenSettings	= jobs[i].codeGenUnit->getSettings();
+		jobStates[i].filesLeftToProcess	= jobs[i].toProcessFiles;
+
+		//Reserve enough space for all tasks
+		jobStates[i].generationTasks.reserve(jobs[i].toProcessFiles.size());
+	}
 
-	const kodgen::MacroCodeGenUnitSettings* codeGenSettings = codeGenUnit.getSettings();
-	std::set<fs::path> filesLeftToProcess = toProcessFiles;
-	std::vector<std::pair<fs::path, ParsingError>> parsingResultsOfFailedFiles;
-	size_t filesLeftBefore = 0;
-	
 	// Process files in cycle.
 	// Files that failed parsing step will be queued for the next cycle iteration to be parsed again.
 	// This is needed because sometimes not all GENERATED macros are filled on pre-parsing step (usually,
 	// when we have an include chain of multiple files that use reflection some GENERATED macros
 	// are not detected on pre-parsing step).
-	do
+	// Each step is run for the files of all jobs at once so that threads are not left idle by small jobs.
+	while (isAnyJobActive)
 	{
-		parsingResultsOfFailedFiles.clear();
-		filesLeftBefore = filesLeftToProcess.size();
-		std::set<fs::path> filesToProcessThisIteration = std::move(filesLeftToProcess);
-		
+		for (JobState& state : jobStates)
+		{
+			if (state.isActive)
+			{
+				state.parsingResultsOfFailedFiles.clear();
+				state.parsingTasks.clear();
+				state.filesLeftBefore				= state.filesLeftToProcess.size();
+				state.filesToProcessThisIteration	= std::move(state.filesLeftToProcess);
+				state.filesLeftToProcess.clear();
+				state.fileMacrosToDefine.assign(state.filesToProcessThisIteration.size(), std::set<std::string>());
+			}
+		}
+
 		//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
 		_threadPool.setIsRunning(false);
 
@@ -54,20 +171,41 @@ void CodeGenManager::processFilesFailOnErrors(FileParserType& fileParser, CodeGe
 		// with reflection macros (file/class macros).
 		// This will avoid the following issue: if we are using inheritance and we haven't
 		// generated parent's macros while parsing child class we will fail with an error.
-		std::vector<std::set<std::string>> fileMacrosToDefine(filesToProcessThisIteration.size());
-		size_t iPreParsingFileIndex = 0;
-		for (fs::path const& file : filesToProcessThisIteration)
+		for (size_t i = 0u; i < jobs.size(); i++)
 		{
-			std::set<std::string>* macrosToDefine = &fileMacrosToDefine[iPreParsingFileIndex];
-			auto preParsingTaskLambda = [codeGenSettings, &fileParser, &file, macrosToDefine](TaskBase*) -> bool
+			JobState& state = jobStates[i];
+
+			if (!state.isActive)
 			{
-				FileParserType fileParserCopy = fileParser;
-				return fileParserCopy.prepareForParsing(file, codeGenSettings, *macrosToDefine);
-			};
+				continue;
+			}
+
+			size_t iPreParsingFileIndex = 0;
+			for (fs::path const& file : state.filesToProcessThisIteration)
+			{
+				std::set<std::string>* macrosToDefine = &state.fileMacrosToDefine[iPreParsingFileIndex];
+
+				_progressTracker.queueFile(file, jobs[i].fileCostHistory.getCost(file));
 
-			preParsingTask = _threadPool.submitTask(std::string("Pre-parsing ") + file.string(), preParsingTaskLambda);
+				auto preParsingTaskLambda = [codeGenSettings = state.codeGenSettings, fileParser = jobs[i].fileParser, pack = jobs[i].codeGenUnit->getGeneratedFilePack(), &file, macrosToDefine](TaskBase*) -> bool
+				{
+					FileParserType fileParserCopy = *fileParser;
+					fileParserCopy.generatedFilePack = pack;
+					return fileParserCopy.prepareForParsing(file, codeGenSettings, *macrosToDefine);
+				};
+
+				//The first pre-parsing of a file also waits for its provisional files, so that they never overwrite the generated ones
+				if (isFirstCycle && !jobs[i].provisionalTasks.empty())
+				{
+					_threadPool.submitTask(std::string("Pre-parsing ") + file.string(), preParsingTaskLambda, { jobs[i].provisionalTasks[iPreParsingFileIndex] });
+				}
+				else
+				{
+					_threadPool.submitTask(std::string("Pre-parsing ") + file.string(), preParsingTaskLambda);
+				}
 
-			iPreParsingFileIndex += 1;
+				iPreParsingFileIndex += 1;
+			}
 		}
 
 		// Wait for pre-parse step to finish.
@@ -76,55 +214,97 @@ void CodeGenManager::processFilesFailOnErrors(FileParserType& fileParser, CodeGe
 		_threadPool.setIsRunning(false);
 
 		// Define generated macros.
-		iPreParsingFileIndex = 0;
-		for (fs::path const& file : filesToProcessThisIteration)
+		for (size_t i = 0u; i < jobs.size(); i++)
 		{
-			if (!fileMacrosToDefine[iPreParsingFileIndex].empty())
+			JobState&			state	= jobStates[i];
+			GeneratedFilePack*	pack	= jobs[i].codeGenUnit->getGeneratedFilePack();
+
+			if (!state.isActive)
 			{
-				// Populate generated file with macros.
-				const auto generatedFilePath = codeGenSettings->getOutputDirectory() / codeGenSettings->getGeneratedHeaderFileName(file);
+				continue;
+			}
 
-				std::ofstream generatedfile(generatedFilePath, std::ios::app);
-				for (const auto& macroName : fileMacrosToDefine[iPreParsingFileIndex])
+			size_t iPreParsingFileIndex = 0;
+			for (fs::path const& file : state.filesToProcessThisIteration)
+			{
+				if (!state.fileMacrosToDefine[iPreParsingFileIndex].empty())
 				{
-					generatedfile << "#define " + macroName + " " << std::endl;
+					// Populate generated file with macros.
+					const auto generatedFilePath = state.codeGenSettings->getOutputDirectory() / state.codeGenSettings->getGeneratedHeaderFileName(file);
+
+					if (pack != nullptr)
+					{
+						std::string macroDefinitions;
+						for (const auto& macroName : state.fileMacrosToDefine[iPreParsingFileIndex])
+						{
+							macroDefinitions += "#define " + macroName + " \n";
+						}
+						pack->appendToFile(generatedFilePath, file, macroDefinitions);
+					}
+					else
+					{
+						std::ofstream generatedfile(generatedFilePath, std::ios::app);
+						for (const auto& macroName : state.fileMacrosToDefine[iPreParsingFileIndex])
+						{
+							generatedfile << "#define " + macroName + " " << std::endl;
+						}
+						generatedfile.close();
+					}
 				}
-				generatedfile.close();
-			}
 
-			iPreParsingFileIndex += 1;
+				iPreParsingFileIndex += 1;
+			}
 		}
-		
+
 		// Run parsing step.
-		std::vector<std::shared_ptr<TaskBase>> parsingTasks;
-		for (fs::path const& file : filesToProcessThisIteration)
+		for (size_t i = 0u; i < jobs.size(); i++)
 		{
-			auto parsingTaskLambda = [codeGenSettings, &fileParser, &file, &filesLeftToProcess, &parsingResultsOfFailedFiles](TaskBase*) -> FileParsingResult
+			JobState& state = jobStates[i];
+
+			if (!state.isActive)
 			{
-				FileParsingResult	parsingResult;
-				
-				// Copy a parser for this task.
-				FileParserType		fileParserCopy = fileParser;
+				continue;
+			}
 
-				fileParserCopy.parseFailOnErrors(file, parsingResult, codeGenSettings);
-				if (!parsingResult.errors.empty())
+			for (fs::path const& file : state.filesToProcessThisIteration)
+			{
+				auto parsingTaskLambda = [this, &state, fileParser = jobs[i].fileParser, codeGenUnit = jobs[i].codeGenUnit, &file, &failedFilesMutex](TaskBase*) -> ParsingTaskResult
 				{
-					for (const auto& error : parsingResult.errors)
+					_progressTracker.onParsingStarted(file);
+
+					// Copy a parser for this task.
+					FileParserType		fileParserCopy = *fileParser;
+
+					ParsingTaskResult	parsingTaskResult = parseFile(fileParserCopy, *codeGenUnit, file, [&state, &file](FileParserType& parser, FileParsingResult& out_result)
 					{
-						parsingResultsOfFailedFiles.push_back(std::make_pair(file, error));
+						parser.parseFailOnErrors(file, out_result, state.codeGenSettings);
+					});
+
+					FileParsingResult&	parsingResult = parsingTaskResult.parsingResult;
+
+					// Files which failed parsing are queued again if they are processed in the next iteration.
+					_progressTracker.onParsingEnded(file, parsingResult.errors.empty());
+
+					if (!parsingResult.errors.empty())
+					{
+						std::lock_guard<std::mutex> lock(failedFilesMutex);
+
+						for (const auto& error : parsingResult.errors)
+						{
+							state.parsingResultsOfFailedFiles.push_back(std::make_pair(file, error));
+						}
+						parsingResult.errors.clear();
+						state.filesLeftToProcess.insert(file);
 					}
-					parsingResult.errors.clear();
-					filesLeftToProcess.insert(file);
-				}
 
-				return parsingResult;
-			};
+					return parsingTaskResult;
+				};
 
-			//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
-			out_genResult.parsedFiles.push_back(file);
-			
-			parsingTask = _threadPool.submitTask(std::string("Parsing ") + file.string(), parsingTaskLambda);
-			parsingTasks.push_back(parsingTask);
+				//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
+				jobs[i].genResult->parsedFiles.push_back(file);
+
+				state.parsingTasks.push_back(_threadPool.submitTask(std::string("Parsing ") + file.string(), parsingTaskLambda));
+			}
 		}
 
 		// Wait for parse step to finish.
@@ -137,88 +317,129 @@ void CodeGenManager::processFilesFailOnErrors(FileParserType& fileParser, CodeGe
 		_threadPool.setIsRunning(false);
 
 		// Run code generation after all files were parsed.
-		size_t parsingTaskIndex = 0;
-		for (fs::path const& file : filesToProcessThisIteration)
+		for (size_t i = 0u; i < jobs.size(); i++)
 		{
-			// Check if the parsing step failed for this file.
-			bool bParsingFailed = false;
-			for (const auto& failedFile : filesLeftToProcess)
-			{
-				if (failedFile == file)
-				{
-					bParsingFailed = true;
-					break;
-				}
-			}
-			if (bParsingFailed)
+			JobState& state = jobStates[i];
+
+			if (!state.isActive)
 			{
-				parsingTaskIndex += 1;
 				continue;
 			}
-			
-			// Clear generated file as it will be filled with an actual information.
-			// Right now it has some defines that were used for proper parsing.
-			const auto generatedFilePath = codeGenSettings->getOutputDirectory() / codeGenSettings->getGeneratedHeaderFileName(file);
-			std::ofstream generatedFile(generatedFilePath); // truncate the file
-			generatedFile.close();
-			
-			auto generationTaskLambda = [&codeGenUnit](TaskBase* parsingTask) -> CodeGenResult
-			{
-				CodeGenResult out_generationResult;
 
-				// Copy the generation unit model to have a fresh one for this generation unit.
-				CodeGenUnitType	generationUnit = codeGenUnit;
-
-				// Get the result of the parsing task.
-				FileParsingResult parsingResult = TaskHelper::getDependencyResult<FileParsingResult>(parsingTask, 0u);
+			size_t parsingTaskIndex = 0;
+			for (fs::path const& file : state.filesToProcessThisIteration)
+			{
+				// Check if the parsing step failed for this file.
+				if (state.filesLeftToProcess.find(file) != state.filesLeftToProcess.cend())
+				{
+					parsingTaskIndex += 1;
+					continue;
+				}
 
-				// Generate the file if no errors occured during parsing.
-				if (parsingResult.errors.empty())
+				// Clear generated file as it will be filled with an actual information.
+				// Right now it has some defines that were used for proper parsing.
+				// Files written only if changed must keep their content to be compared with the new one.
+				if (!state.codeGenSettings->shouldWriteGeneratedFilesOnlyIfChanged)
 				{
-					out_generationResult.completed = generationUnit.generateCode(parsingResult);
+					const auto generatedFilePath = state.codeGenSettings->getOutputDirectory() / state.codeGenSettings->getGeneratedHeaderFileName(file);
+					std::ofstream generatedFile(generatedFilePath); // truncate the file
+					generatedFile.close();
 				}
 
-				return out_generationResult;
-			};
-			
-			generationTasks.emplace_back(_threadPool.submitTask(std::string("Generation ") + file.string(), generationTaskLambda, { parsingTasks[parsingTaskIndex] }));
-			parsingTaskIndex += 1;
+				auto generationTaskLambda = [this, codeGenUnit = jobs[i].codeGenUnit, recorder = parsingResultsRecorder, &file](TaskBase* parsingTask) -> CodeGenResult
+				{
+					_progressTracker.onGenerationStarted(file);
+
+					CodeGenResult out_generationResult;
+
+					// Copy the generation unit model to have a fresh one for this generation unit.
+					CodeGenUnitType	generationUnit = *codeGenUnit;
+
+					// Get the result of the parsing task.
+					ParsingTaskResult	parsingTaskResult	= TaskHelper::getDependencyResult<ParsingTaskResult>(parsingTask, 0u);
+					FileParsingResult&	parsingResult		= parsingTaskResult.parsingResult;
+
+					// Generate the file if no errors occured during parsing.
+					if (parsingResult.errors.empty())
+					{
+						if (recorder != nullptr)
+						{
+							recorder->add(parsingResult);
+						}
+
+						out_generationResult.completed					= generationUnit.generateCode(parsingResult, &parsingTaskResult.streamedEntitiesCode);
+						out_generationResult.generatedFileContributions	= generationUnit.getGeneratedCodeContributions(file);
+					}
+
+					_progressTracker.onGenerationEnded(file, out_generationResult.completed);
+
+					return out_generationResult;
+				};
+
+				state.generationTasks.emplace_back(_threadPool.submitTask(std::string("Generation ") + file.string(), generationTaskLambda, { state.parsingTasks[parsingTaskIndex] }));
+				parsingTaskIndex += 1;
+			}
 		}
 
 		// Wait for code generation.
 		_threadPool.setIsRunning(true);
 		_threadPool.joinWorkers();
-	}while(!filesLeftToProcess.empty() && filesLeftBefore != filesLeftToProcess.size());
 
-	// Log errors.
-	if (logger != nullptr)
+		// A job is done when all its files were processed or when the last iteration didn't make any progress.
+		isAnyJobActive	= false;
+		isFirstCycle	= false;
+
+		for (JobState& state : jobStates)
+		{
+			state.isActive = state.isActive && !state.filesLeftToProcess.empty() && state.filesLeftBefore != state.filesLeftToProcess.size();
+			isAnyJobActive |= state.isActive;
+		}
+	}
+
+	for (size_t i = 0u; i < jobs.size(); i++)
 	{
-		if (!parsingResultsOfFailedFiles.empty())
+		JobState& state = jobStates[i];
+
+		if (!state.parsingResultsOfFailedFiles.empty())
+		{
+			jobs[i].genResult->completed = false;
+		}
+
+		// Log errors.
+		if (logger != nullptr)
 		{
-			out_genResult.completed = false;
+			for (const auto& error : state.parsingResultsOfFailedFiles)
+			{
+				logger->log("While processing the following file: " + error.first.string() + ": " + error.second.toString(), kodgen::ILogger::ELogSeverity::Error);
+			}
 		}
-		
-        for (const auto& error : parsingResultsOfFailedFiles)
+
+		//Merge all generation results together
+		for (std::shared_ptr<TaskBase>& task : state.generationTasks)
 		{
-			logger->log("While processing the following file: " + error.first.string() + ": " + error.second.toString(), kodgen::ILogger::ELogSeverity::Error);
+			jobs[i].genResult->mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
 		}
 	}
-	
-	//Merge all generation results together
-	for (std::shared_ptr<TaskBase>& task : generationTasks)
-	{
-		out_genResult.mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
-	}
 }
 
 template <typename FileParserType, typename CodeGenUnitType>
-void CodeGenManager::processFilesIgnoreErrors(FileParserType& fileParser, CodeGenUnitType& codeGenUnit, std::set<fs::path> const& toProcessFiles, CodeGenResult& out_genResult) noexcept
+void CodeGenManager::processFilesIgnoreErrors(std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>& jobs) noexcept
 {
-	std::vector<std::shared_ptr<TaskBase>>	generationTasks;
-	uint8									iterationCount = codeGenUnit.getIterationCount();
+	std::vector<std::vector<std::shared_ptr<TaskBase>>>	generationTasks(jobs.size());
+	uint8												iterationCount = 0u;
 
-	//Reserve enough space for all tasks
-	generationTasks.reserve(toProcessFiles.size() * iterationCount);
+	for (size_t i = 0u; i < jobs.size(); i++)
+	{
+		iterationCount = std::max(iterationCount, jobs[i].codeGenUnit->getIterationCount());
+
+		//Reserve enough space for all tasks
+		generationTasks[i].reserve(jobs[i].toProcessFiles.size() * jobs[i].codeGenUnit->getIterationCount());
+
+		for (fs::path const& file : jobs[i].toProcessFiles)
+		{
+			_progressTracker.queueFile(file, jobs[i].fileCostHistory.getCost(file), jobs[i].codeGenUnit->getIterationCount());
+		}
+	}
 
 	//Launch all parsing -> generation processes
 	std::shared_ptr<TaskBase> parsingTask;
@@ -228,47 +449,88 @@ void CodeGenManager::processFilesIgnoreErrors(FileParserType& fileParser, CodeGe
 		//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
 		_threadPool.setIsRunning(false);
 
-		for (fs::path const& file : toProcessFiles)
+		for (size_t jobIndex = 0u; jobIndex < jobs.size(); jobIndex++)
 		{
-			auto parsingTaskLambda = [&fileParser, &file](TaskBase*) -> FileParsingResult
-			{
-				//Copy a parser for this task
-				FileParserType		fileParserCopy = fileParser;
-				FileParsingResult	parsingResult;
+			ProcessingJob<FileParserType, CodeGenUnitType>& job = jobs[jobIndex];
 
-				fileParserCopy.parseIgnoreErrors(file, parsingResult);
+			//This job needs less iterations than others
+			if (i >= job.codeGenUnit->getIterationCount())
+			{
+				continue;
+			}
 
-				return parsingResult;
-			};
+			size_t fileIndex = 0u;
 
-			auto generationTaskLambda = [&codeGenUnit](TaskBase* parsingTask) -> CodeGenResult
+			for (fs::path const& file : job.toProcessFiles)
 			{
-				CodeGenResult out_generationResult;
+				auto parsingTaskLambda = [this, fileParser = job.fileParser, codeGenUnit = job.codeGenUnit, &file](TaskBase*) -> ParsingTaskResult
+				{
+					_progressTracker.onParsingStarted(file);
 
-				//Copy the generation unit model to have a fresh one for this generation unit
-				CodeGenUnitType	generationUnit = codeGenUnit;
+					//Copy a parser for this task
+					FileParserType fileParserCopy = *fileParser;
 
-				//Get the result of the parsing task
-				FileParsingResult parsingResult = TaskHelper::getDependencyResult<FileParsingResult>(parsingTask, 0u);
+					ParsingTaskResult parsingTaskResult = parseFile(fileParserCopy, *codeGenUnit, file, [&file](FileParserType& parser, FileParsingResult& out_result)
+					{
+						parser.parseIgnoreErrors(file, out_result);
+					});
+
+					//Parsing errors are reported by the generation task which skips the file
+					_progressTracker.onParsingEnded(file, true);
 
-				//Generate the file if no errors occured during parsing
-				if (parsingResult.errors.empty())
+					return parsingTaskResult;
+				};
+
+				auto generationTaskLambda = [this, codeGenUnit = job.codeGenUnit, recorder = parsingResultsRecorder, &file](TaskBase* parsingTask) -> CodeGenResult
 				{
-					out_generationResult.completed = generationUnit.generateCode(parsingResult);
-				}
+					_progressTracker.onGenerationStarted(file);
 
-				return out_generationResult;
-			};
+					CodeGenResult out_generationResult;
+
+					//Copy the generation unit model to have a fresh one for this generation unit
+					CodeGenUnitType	generationUnit = *codeGenUnit;
+
+					//Get the result of the parsing task
+					ParsingTaskResult	parsingTaskResult	= TaskHelper::getDependencyResult<ParsingTaskResult>(parsingTask, 0u);
+					FileParsingResult&	parsingResult		= parsingTaskResult.parsingResult;
+
+					//Generate the file if no errors occured during parsing
+					if (parsingResult.errors.empty())
+					{
+						if (recorder != nullptr)
+						{
+							recorder->add(parsingResult);
+						}
+
+						out_generationResult.completed					= generationUnit.generateCode(parsingResult, &parsingTaskResult.streamedEntitiesCode);
+						out_generationResult.generatedFileContributions	= generationUnit.getGeneratedCodeContributions(file);
+					}
+
+					_progressTracker.onGenerationEnded(file, out_generationResult.completed);
+
+					return out_generationResult;
+				};
 
-			//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
-			out_genResult.parsedFiles.push_back(file);
+				//Add file to the list of parsed files before starting the task to avoid having to synchronize threads
+				job.genResult->parsedFiles.push_back(file);
 
-			//Parse files
-			//For multiple iterations on a same file, the parsing task depends on the previous generation task for the same file
-			parsingTask = _threadPool.submitTask(std::string("Parsing ") + std::to_string(i), parsingTaskLambda);
+				//Parse files
+				//For multiple iterations on a same file, the parsing task depends on the previous generation task for the same file
+				//The first parsing of a file also waits for its provisional files, so that they never overwrite the generated ones
+				if (i == 0 && !job.provisionalTasks.empty())
+				{
+					parsingTask = _threadPool.submitTask(std::string("Parsing ") + std::to_string(i), parsingTaskLambda, { job.provisionalTasks[fileIndex] });
+				}
+				else
+				{
+					parsingTask = _threadPool.submitTask(std::string("Parsing ") + std::to_string(i), parsingTaskLambda);
+				}
+
+				fileIndex++;
 
-			//Generate code
-			generationTasks.emplace_back(_threadPool.submitTask(std::string("Generation ") + std::to_string(i), generationTaskLambda, { parsingTask }));
+				//Generate code
+				generationTasks[jobIndex].emplace_back(_threadPool.submitTask(std::string("Generation ") + std::to_string(i), generationTaskLambda, { parsingTask }));
+			}
 		}
 
 		//Wait for this iteration to complete before continuing any further
@@ -278,9 +540,12 @@ void CodeGenManager::processFilesIgnoreErrors(FileParserType& fileParser, CodeGe
 	}
 
 	//Merge all generation results together
-	for (std::shared_ptr<TaskBase>& task : generationTasks)
+	for (size_t i = 0u; i < jobs.size(); i++)
 	{
-		out_genResult.mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
+		for (std::shared_ptr<TaskBase>& task : generationTasks[i])
+		{
+			jobs[i].genResult->mergeResult(TaskHelper::getResult<CodeGenResult>(task.get()));
+		}
 	}
 }
 
@@ -298,15 +563,30 @@ CodeGenResult CodeGenManager::run(FileParserType& fileParser, CodeGenUnitType& c
 	CodeGenResult genResult;
 	genResult.completed = true;
 
-	if (!checkGenerationSetup(fileParser, codeGenUnit))
+	if (!checkGenerationSetup(settings, fileParser, codeGenUnit))
 	{
 		genResult.completed = false;
 	}
 	else
 	{
+		startProgressTracking();
+
+		//Statistics reported at the end of the run only cover the run
+		_threadPool.resetStatistics();
+
 		//Start timer here
-		auto				start			= std::chrono::high_resolution_clock::now();
-		std::set<fs::path>	filesToProcess	= identifyFilesToProcess(codeGenUnit, genResult, forceRegenerateAll);
+		auto					start				= std::chrono::high_resolution_clock::now();
+		AllocationReport		allocationsAtStart	= AllocationTracker::getReport();
+		GitIndexChangeDetector	gitIndexChangeDetector;
+
+		//Packed files are checked by identifyFilesToProcess, and the pack must be shared by the unit copies made to process files
+		loadGeneratedFilePack(codeGenUnit);
+
+		codeGenUnit.setProvisionalFilesEnabled(settings.shouldGenerateProvisionalFiles);
+
+		std::set<fs::path>		filesToProcess		= identifyFilesToProcess(settings, gitIndexChangeDetector, codeGenUnit, genResult, forceRegenerateAll);
+
+		_progressTracker.addDiscoveredFiles(filesToProcess.size() + genResult.upToDateFiles.size());
 
 		//Don't setup anything if there are no files to generate
 		if (filesToProcess.size() > 0u)
@@ -318,11 +598,197 @@ CodeGenResult CodeGenManager::run(FileParserType& fileParser, CodeGenUnitType& c
 			generateMacrosFile(fileParser.getSettings(), codeGenUnit.getSettings()->getOutputDirectory());
 
 			//Start files processing
-			processFiles(fileParser, codeGenUnit, filesToProcess, genResult);
+			std::vector<ProcessingJob<FileParserType, CodeGenUnitType>> jobs{ { &fileParser, &codeGenUnit, std::move(filesToProcess), &genResult } };
+
+			//Quickly make all files compilable while the full generation is running
+			if (settings.shouldGenerateProvisionalFiles)
+			{
+				jobs.front().provisionalTasks = generateProvisionalFiles(codeGenUnit, jobs.front().toProcessFiles);
+			}
+
+			processFiles(jobs);
 		}
 
+		_progressTracker.stop();
+
+		saveGitIndexChangeDetectorManifest(gitIndexChangeDetector, codeGenUnit, genResult);
+		saveGeneratedFilePack(codeGenUnit);
+
 		genResult.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
+
+		reportAllocations(allocationsAtStart, genResult);
+		reportThreadPoolStatistics(genResult);
 	}
 	
 	return genResult;
 }
+
+template <typename FileParserType, typename CodeGenUnitType>
+std::vector<CodeGenResult> CodeGenManager::runBatch(std::vector<CodeGenProject<FileParserType, CodeGenUnitType>>& projects, bool forceRegenerateAll) noexcept
+{
+	//Check FileParser validity
+	static_assert(std::is_base_of_v<FileParser, FileParserType>, "fileParser type must be a derived class of kodgen::FileParser.");
+	static_assert(std::is_copy_constructible_v<FileParserType>, "The provided file parser must be copy-constructible.");
+
+	//Check FileGenerationUnit validity
+	static_assert(std::is_base_of_v<CodeGenUnit, CodeGenUnitType>, "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
+	static_assert(std::is_copy_constructible_v<CodeGenUnitType>, "The CodeGenUnit you provide must be copy-constructible.");
+
+	startProgressTracking();
+
+	//Statistics reported at the end of the run only cover the run
+	_threadPool.resetStatistics();
+
+	//Start timer here
+	auto															start				= std::chrono::high_resolution_clock::now();
+	AllocationReport												allocationsAtStart	= AllocationTracker::getReport();
+	std::vector<CodeGenResult>										genResults(projects.size());
+	std::vector<GitIndexChangeDetector>								gitIndexChangeDetectors(projects.size());
+	std::vector<ProcessingJob<FileParserType, CodeGenUnitType>>		jobs;
+	std::set<ParsingSettings const*>								initializedParsingSettings;
+
+	for (size_t i = 0u; i < projects.size(); i++)
+	{
+		CodeGenProject<FileParserType, CodeGenUnitType>& project = projects[i];
+
+		genResults[i].completed = checkGenerationSetup(project.settings, project.fileParser, project.codeGenUnit);
+
+		if (!genResults[i].completed)
+		{
+			continue;
+		}
+
+		loadGeneratedFilePack(project.codeGenUnit);
+
+		project.codeGenUnit.setProvisionalFilesEnabled(project.settings.shouldGenerateProvisionalFiles);
+
+		std::set<fs::path> filesToProcess = identifyFilesToProcess(project.settings, gitIndexChangeDetectors[i], project.codeGenUnit, genResults[i], forceRegenerateAll);
+
+		_progressTracker.addDiscoveredFiles(filesToProcess.size() + genResults[i].upToDateFiles.size());
+
+		//Don't setup anything if there are no files to generate
+		if (filesToProcess.size() > 0u)
+		{
+			//Projects sharing a file parser share its parsing settings, initialize them once
+			if (initializedParsingSettings.emplace(&project.fileParser.getSettings()).second)
+			{
+				project.fileParser.getSettings().init(logger);
+			}
+
+			generateMacrosFile(project.fileParser.getSettings(), project.codeGenUnit.getSettings()->getOutputDirectory());
+
+			jobs.push_back({ &project.fileParser, &project.codeGenUnit, std::move(filesToProcess), &genResults[i] });
+
+			//Quickly make all files compilable while the full generation is running
+			if (project.settings.shouldGenerateProvisionalFiles)
+			{
+				jobs.back().provisionalTasks = generateProvisionalFiles(project.codeGenUnit, jobs.back().toProcessFiles);
+			}
+		}
+	}
+
+	//Process the files of all projects together
+	processFiles(jobs);
+
+	_progressTracker.stop();
+
+	float duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() * 0.001f;
+
+	for (size_t i = 0u; i < projects.size(); i++)
+	{
+		saveGitIndexChangeDetectorManifest(gitIndexChangeDetectors[i], projects[i].codeGenUnit, genResults[i]);
+
+		if (genResults[i].completed)
+		{
+			saveGeneratedFilePack(projects[i].codeGenUnit);
+		}
+
+		genResults[i].duration = duration;
+	}
+
+	//Allocations are counted globally and files are processed by the same pool: the reports cover the whole batch, report them once
+	if (!genResults.empty())
+	{
+		reportAllocations(allocationsAtStart, genResults.front());
+		reportThreadPoolStatistics(genResults.front());
+	}
+
+	return genResults;
+}
+
+template <typename CodeGenUnitType>
+CodeGenReplayResult CodeGenManager::replay(ParsingResultSnapshot const& snapshot, CodeGenUnitType& codeGenUnit, uint32 repetitionCount) noexcept
+{
+	//Check FileGenerationUnit validity
+	static_assert(std::is_base_of_v<CodeGenUnit, CodeGenUnitType>, "codeGenUnit type must be a derived class of kodgen::CodeGenUnit.");
+	static_assert(std::is_copy_constructible_v<CodeGenUnitType>, "The CodeGenUnit you provide must be copy-constructible.");
+
+	CodeGenReplayResult replayResult;
+
+	if (!codeGenUnit.checkSettings())
+	{
+		return replayResult;
+	}
+
+	//Deserialize all parsing results first so that only the code generation is measured
+	std::vector<FileParsingResult>	parsingResults(snapshot.getResultCount());
+	uint64							entityCount = 0u;
+
+	for (size_t i = 0u; i < parsingResults.size(); i++)
+	{
+		if (!snapshot.getResult(i, parsingResults[i]))
+		{
+			if (logger != nullptr)
+			{
+				logger->log("Failed to read the parsing result " + std::to_string(i) + " of the snapshot, abort replay.", ILogger::ELogSeverity::Error);
+			}
+
+			return replayResult;
+		}
+
+		parsingResults[i].foreachEntityOfType(NamespaceInfo::nestedEntityTypes | EEntityType::EnumValue, [&entityCount](EntityInfo const&) { entityCount++; });
+	}
+
+	std::vector<std::shared_ptr<TaskBase>> generationTasks;
+	generationTasks.reserve(parsingResults.size() * repetitionCount);
+
+	uint64	generatedBytesAtStart	= GeneratedFile::getTotalGeneratedBytes();
+	auto	start					= std::chrono::high_resolution_clock::now();
+
+	//Repetitions write the same generated files, so they must not overlap
+	for (uint32 i = 0u; i < repetitionCount; i++)
+	{
+		//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
+		_threadPool.setIsRunning(false);
+
+		for (FileParsingResult const& parsingResult : parsingResults)
+		{
+			auto generationTaskLambda = [&codeGenUnit, &parsingResult](TaskBase*) -> bool
+			{
+				//Copy the generation unit model to have a fresh one for this generation unit
+				CodeGenUnitType	generationUnit = codeGenUnit;
+
+				return generationUnit.generateCode(parsingResult);
+			};
+
+			generationTasks.emplace_back(_threadPool.submitTask(std::string("Replay ") + parsingResult.parsedFile.string(), generationTaskLambda));
+		}
+
+		_threadPool.setIsRunning(true);
+		_threadPool.joinWorkers();
+	}
+
+	replayResult.duration			= std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+	replayResult.generatedBytes		= GeneratedFile::getTotalGeneratedBytes() - generatedBytesAtStart;
+	replayResult.generatedFileCount	= generationTasks.size();
+	replayResult.entityCount		= entityCount * repetitionCount;
+	replayResult.completed			= std::all_of(generationTasks.cbegin(), generationTasks.cend(), [](std::shared_ptr<TaskBase> const& task) { return TaskHelper::getResult<bool>(task.get()); });
+
+	if (logger != nullptr)
+	{
+		logger->log("Replayed " + std::to_string(replayResult.generatedFileCount) + " file(s) in " + std::to_string(replayResult.duration) + " seconds: " +
+					std::to_string(replayResult.getEntitiesPerSecond()) + " entities/s, " + std::to_string(replayResult.getBytesPerSecond()) + " bytes/s.", ILogger::ELogSeverity::Info);
+	}
+
+	return replayResult;
+}
\ No newline at end of file
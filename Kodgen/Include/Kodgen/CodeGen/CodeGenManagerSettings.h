@@ -132,7 +132,55 @@ namespace kodgen
 			void			loadIgnoredDirectories(toml::value const&	generationSettings,
 												   ILogger*				logger)					noexcept;
 
+			/**
+			*	@brief Load the shouldExplainFileProcessing setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldExplainFileProcessing(toml::value const&	generationSettings,
+															ILogger*			logger)			noexcept;
+
+			/**
+			*	@brief Load the shouldUseGitIndexChangeDetection setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldUseGitIndexChangeDetection(toml::value const&	generationSettings,
+																 ILogger*			logger)		noexcept;
+
+			/**
+			*	@brief Load the shouldGenerateProvisionalFiles setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldGenerateProvisionalFiles(toml::value const&	generationSettings,
+															   ILogger*				logger)		noexcept;
+
 		public:
+			/**
+			*	Should the reason why each file is processed or skipped be logged and reported in the CodeGenResult?
+			*	Useful to track down files which are regenerated more often than expected.
+			*/
+			bool	shouldExplainFileProcessing			= false;
+
+			/**
+			*	Should the local git index be used to detect files unchanged since the last run (see GitIndexChangeDetector)?
+			*	Files unchanged since the last successful run (same size and last write time) are skipped as long as their generated files exist,
+			*	without comparing the generated files timestamps.
+			*	Files which are not tracked by git are still checked with CodeGenUnit::isUpToDate.
+			*/
+			bool	shouldUseGitIndexChangeDetection	= false;
+
+			/**
+			*	Should provisional generated files be written for all files to process before parsing them (see CodeGenUnit::generateProvisionalCode)?
+			*	Provisional files only make the processed files compile, so that IDEs and builds started during the generation don't fail
+			*	on missing generated macros. They are replaced by the full generated files as soon as each file is parsed.
+			*/
+			bool	shouldGenerateProvisionalFiles		= false;
+
 			/**
 			*	@brief	Add a file to the list of processed files.
 			*			If the path is invalid, doesn't exist, is not a file, or is already in the list, nothing happens.
@@ -94,6 +94,14 @@ namespace kodgen
 			*/
 			virtual int32							getGenerationOrder()							const	noexcept override;
 
+			/**
+			*	@brief	Get the name of this module, used to report the code it generated.
+			*			Default implementation returns the demangled name of the module dynamic type, override it to report a shorter name.
+			*
+			*	@return The name of this module.
+			*/
+			virtual std::string						getName()										const	noexcept;
+
 			/**
 			*	@brief Getter for _propertyCodeGenerators field.
 			*
@@ -0,0 +1,84 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Snapshot of the progress of a running code generation (see CodeGenManager::progressCallback).
+	*	A file processed by several iterations (or parsed again after a failure) is counted once per processing.
+	*/
+	class CodeGenProgress
+	{
+		public:
+			/** File being parsed or generated. */
+			struct InFlightFile
+			{
+				/** Path to the file. */
+				fs::path	file;
+
+				/** Is the file being parsed (true) or generated (false)? */
+				bool		isParsing	= true;
+
+				/** Time elapsed (in seconds) since the file entered its current stage. */
+				float		duration	= 0.0f;
+			};
+
+			/** Number of files found in the processed directories, including up-to-date files. */
+			size_t						discoveredFileCount		= 0u;
+
+			/** Number of file processings queued since the beginning of the run. */
+			size_t						queuedFileCount			= 0u;
+
+			/** Number of files being parsed. */
+			size_t						parsingFileCount		= 0u;
+
+			/** Number of files being generated. */
+			size_t						generatingFileCount		= 0u;
+
+			/** Number of files whose code has been generated and written. */
+			size_t						writtenFileCount		= 0u;
+
+			/** Number of file processings which failed (parsing errors or failed generation). */
+			size_t						failedFileCount			= 0u;
+
+			/** Time elapsed (in seconds) since the beginning of the run. */
+			float						elapsedTime				= 0.0f;
+
+			/** Number of file processings completed per second. */
+			float						throughput				= 0.0f;
+
+			/**
+			*	Estimated time (in seconds) before all queued files are processed, based on the cost of each file in previous runs
+			*	and on the parallelism observed so far. Negative if there is not enough data to estimate it yet.
+			*/
+			float						estimatedRemainingTime	= -1.0f;
+
+			/** Files being parsed or generated, the longest running first. */
+			std::vector<InFlightFile>	inFlightFiles;
+
+			/**
+			*	@brief Get the number of file processings which are over, successful or not.
+			*
+			*	@return The number of completed file processings.
+			*/
+			size_t		getCompletedFileCount()	const	noexcept;
+
+			/**
+			*	@brief Build a terse single line summary of the progress, the longest running file included.
+			*
+			*	@return The summary of the progress.
+			*/
+			std::string	toString()				const	noexcept;
+	};
+}
\ No newline at end of file
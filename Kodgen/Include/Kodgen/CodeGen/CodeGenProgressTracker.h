@@ -0,0 +1,233 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "Kodgen/CodeGen/CodeGenProgress.h"
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Collect the progress events of the files processed by a CodeGenManager run from any thread,
+	*	and periodically report a CodeGenProgress snapshot from a dedicated thread.
+	*	Events are ignored while the tracker is not started.
+	*/
+	class CodeGenProgressTracker
+	{
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			/** Progress of a single file. */
+			struct FileState
+			{
+				/** Estimated cost (in seconds) of a single processing of the file, negative if unknown. */
+				float				estimatedCost				= -1.0f;
+
+				/** Time (in seconds) spent to process the file during this run. */
+				float				measuredCost				= 0.0f;
+
+				/** Number of queued processings which are not over yet. */
+				size_t				pendingProcessingCount		= 0u;
+
+				/** Number of processings which are over. */
+				size_t				completedProcessingCount	= 0u;
+
+				/** Beginning of the current processing. */
+				Clock::time_point	processingStart;
+
+				/** Beginning of the current stage of the current processing. */
+				Clock::time_point	stageStart;
+
+				/** Is the file being parsed? */
+				bool				isParsing					= false;
+
+				/** Is the file being generated? */
+				bool				isGenerating				= false;
+			};
+
+			/** Mutex protecting all the tracker fields but _isTracking. */
+			mutable std::mutex									_mutex;
+
+			/** Condition used to wake the report thread up when the tracker is stopped. */
+			std::condition_variable								_stopCondition;
+
+			/** Thread periodically reporting the progress. */
+			std::thread											_reportThread;
+
+			/** Is the tracker started? */
+			std::atomic_bool									_isTracking				= false;
+
+			/** Set when the report thread should exit. */
+			bool												_isStopRequested		= false;
+
+			/** Callback called with each reported progress. */
+			std::function<void(CodeGenProgress const&)>			_callback;
+
+			/** Should the progress be displayed on a single terminal line? */
+			bool												_shouldDisplay			= false;
+
+			/** Length of the last displayed line, used to erase it. */
+			size_t												_displayedLineLength	= 0u;
+
+			/** Number of threads processing the files, used to estimate the remaining time before any file completes. */
+			uint32												_threadCount			= 1u;
+
+			/** Time the tracker was started. */
+			Clock::time_point									_startTime;
+
+			/** Time the first file processing started. */
+			Clock::time_point									_firstProcessingStart;
+
+			/** Progress of each queued file. */
+			std::unordered_map<fs::path, FileState, PathHash>	_files;
+
+			/** Progress counters, inFlightFiles and time related fields are computed when the progress is reported. */
+			CodeGenProgress										_counters;
+
+			/** Sum of the costs of all completed processings. */
+			float												_completedCost			= 0.0f;
+
+			/**
+			*	@brief Build the progress snapshot. _mutex must be locked when this method is called.
+			*
+			*	@return The progress snapshot.
+			*/
+			CodeGenProgress	buildProgress()												const	noexcept;
+
+			/**
+			*	@brief End the current processing of a file. _mutex must be locked when this method is called.
+			*
+			*	@param state		State of the processed file.
+			*	@param succeeded	Did the processing succeed?
+			*/
+			void			endProcessing(FileState&	state,
+										  bool			succeeded)								noexcept;
+
+			/**
+			*	@brief Call the callback and refresh the terminal line with the current progress.
+			*/
+			void			report()															noexcept;
+
+			/**
+			*	@brief Routine run by the report thread.
+			*
+			*	@param reportInterval Time (in seconds) between 2 reports.
+			*/
+			void			reportRoutine(float reportInterval)									noexcept;
+
+		public:
+			CodeGenProgressTracker()								= default;
+			CodeGenProgressTracker(CodeGenProgressTracker const&)	= delete;
+			CodeGenProgressTracker(CodeGenProgressTracker&&)		= delete;
+			~CodeGenProgressTracker()															noexcept;
+
+			/**
+			*	@brief	Reset the progress and start reporting it periodically from a dedicated thread.
+			*			Nothing is started if there is no callback and the progress is not displayed.
+			*
+			*	@param callback			Callback called from the report thread with each reported progress. Can be empty.
+			*	@param shouldDisplay	Should the progress be displayed on a single terminal line (standard output)?
+			*	@param reportInterval	Time (in seconds) between 2 reports.
+			*	@param threadCount		Number of threads processing the files.
+			*/
+			void			start(std::function<void(CodeGenProgress const&)>	callback,
+								  bool											shouldDisplay,
+								  float											reportInterval,
+								  uint32										threadCount)		noexcept;
+
+			/**
+			*	@brief Stop the report thread, after a last report of the final progress.
+			*/
+			void			stop()																noexcept;
+
+			/**
+			*	@brief Check whether the tracker is started.
+			*
+			*	@return true if the tracker is started, else false.
+			*/
+			bool			isTracking()												const	noexcept;
+
+			/**
+			*	@brief Add files to the discovered files count.
+			*
+			*	@param fileCount Number of discovered files, including the up-to-date ones.
+			*/
+			void			addDiscoveredFiles(size_t fileCount)								noexcept;
+
+			/**
+			*	@brief Queue processings of a file.
+			*
+			*	@param file				Path to the file.
+			*	@param estimatedCost	Estimated cost (in seconds) of a single processing of the file, negative if unknown.
+			*	@param processingCount	Number of times the file will be processed.
+			*/
+			void			queueFile(fs::path const&	file,
+									  float				estimatedCost,
+									  size_t			processingCount = 1u)					noexcept;
+
+			/**
+			*	@brief Notify that a queued file starts being parsed.
+			*
+			*	@param file Path to the file.
+			*/
+			void			onParsingStarted(fs::path const& file)								noexcept;
+
+			/**
+			*	@brief Notify that a file has been parsed.
+			*
+			*	@param file			Path to the file.
+			*	@param succeeded	Did the parsing succeed? The file processing is over if false.
+			*/
+			void			onParsingEnded(fs::path const&	file,
+										   bool				succeeded)							noexcept;
+
+			/**
+			*	@brief Notify that a parsed file starts being generated.
+			*
+			*	@param file Path to the file.
+			*/
+			void			onGenerationStarted(fs::path const& file)							noexcept;
+
+			/**
+			*	@brief Notify that the code of a file has been generated and written, which ends the file processing.
+			*
+			*	@param file			Path to the file.
+			*	@param succeeded	Did the generation succeed?
+			*/
+			void			onGenerationEnded(fs::path const&	file,
+											  bool				succeeded)						noexcept;
+
+			/**
+			*	@brief Get a snapshot of the current progress.
+			*
+			*	@return The current progress.
+			*/
+			CodeGenProgress	getProgress()												const	noexcept;
+
+			/**
+			*	@brief Get the average cost of a single processing of a file during the last run.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return The time (in seconds) spent to process the file once, or a negative value if no processing of the file completed.
+			*/
+			float			getMeasuredCost(fs::path const& file)						const	noexcept;
+
+			CodeGenProgressTracker& operator=(CodeGenProgressTracker const&)	= delete;
+			CodeGenProgressTracker& operator=(CodeGenProgressTracker&&)			= delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/CodeGen/CodeGenManagerSettings.h"
+
+namespace kodgen
+{
+	/**
+	*	Project processed by CodeGenManager::runBatch.
+	*	The file parser and the code generation unit are referenced, so they must outlive the batch run.
+	*	Several projects can share the same file parser (and so the same parsing settings).
+	*/
+	template <typename FileParserType, typename CodeGenUnitType>
+	class CodeGenProject
+	{
+		public:
+			/** Generation settings of the project, used instead of CodeGenManager::settings. */
+			CodeGenManagerSettings	settings;
+
+			/** Original file parser used to parse the project files. A copy of this parser will be used for each generation thread. */
+			FileParserType&			fileParser;
+
+			/** Generation unit used to generate the project files. It must have a clean state when the batch is run. */
+			CodeGenUnitType&		codeGenUnit;
+
+			CodeGenProject(FileParserType&	fileParser,
+						   CodeGenUnitType&	codeGenUnit)		noexcept;
+	};
+
+	#include "Kodgen/CodeGen/CodeGenProject.inl"
+}
\ No newline at end of file
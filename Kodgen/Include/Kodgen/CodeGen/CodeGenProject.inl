@@ -0,0 +1,13 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+template <typename FileParserType, typename CodeGenUnitType>
+CodeGenProject<FileParserType, CodeGenUnitType>::CodeGenProject(FileParserType& fileParser, CodeGenUnitType& codeGenUnit) noexcept:
+	fileParser{fileParser},
+	codeGenUnit{codeGenUnit}
+{
+}
\ No newline at end of file
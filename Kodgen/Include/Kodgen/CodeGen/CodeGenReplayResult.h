@@ -0,0 +1,49 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Report of a code generation replayed from a ParsingResultSnapshot (see CodeGenManager::replay).
+	*/
+	class CodeGenReplayResult
+	{
+		public:
+			/** This boolean is set to true if the generation of all replayed files succeeded, and false otherwise. */
+			bool	completed			= false;
+
+			/** Time elapsed (in seconds) to generate the code of all replayed files, parsing results deserialization excluded. */
+			float	duration			= 0.0f;
+
+			/** Number of files generated, counting each repetition. */
+			uint64	generatedFileCount	= 0u;
+
+			/** Number of entities forwarded to the code generation, counting each repetition. */
+			uint64	entityCount			= 0u;
+
+			/** Number of bytes written to the generated files, counting each repetition. */
+			uint64	generatedBytes		= 0u;
+
+			/**
+			*	@brief Get the code generation throughput in entities.
+			*
+			*	@return The number of entities generated per second.
+			*/
+			float	getEntitiesPerSecond()	const	noexcept;
+
+			/**
+			*	@brief Get the code generation throughput in bytes.
+			*
+			*	@return The number of bytes generated per second.
+			*/
+			float	getBytesPerSecond()		const	noexcept;
+	};
+}
\ No newline at end of file
@@ -10,6 +10,10 @@
 #include <vector>
 
 #include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/CodeGen/FileProcessingExplanation.h"
+#include "Kodgen/CodeGen/GeneratedCodeContribution.h"
+#include "Kodgen/Misc/AllocationTracker.h"
+#include "Kodgen/Threading/ThreadPoolStatistics.h"
 
 namespace kodgen
 {
@@ -31,6 +35,32 @@ namespace kodgen
 			/** List of paths to files which metadata are up-to-date. */
 			std::vector<fs::path>	upToDateFiles;
 
+			/**
+			*	Reason why each file has been processed or skipped.
+			*	Only filled if CodeGenManagerSettings::shouldExplainFileProcessing is true.
+			*/
+			std::vector<FileProcessingExplanation>	fileProcessingExplanations;
+
+			/**
+			*	Amount of code each code generation module generated in each generated file.
+			*	A file generated by several iterations appears once per iteration, the last entry being the most recent.
+			*	Only filled if CodeGenUnitSettings::shouldMeasureModuleContributions is true.
+			*/
+			std::vector<GeneratedFileContributions>	generatedFileContributions;
+
+			/**
+			*	Allocations made by all threads during the run, per pipeline stage.
+			*	Only filled if Kodgen is built with the KODGEN_ALLOCATION_TRACKING CMake option.
+			*	Allocations are counted globally, so in a batch run the report covers the whole batch and only the first project result holds it.
+			*/
+			AllocationReport						allocationReport;
+
+			/**
+			*	Statistics of the thread pool which processed the files of the run.
+			*	Files of a batch run are processed by the same pool, so the statistics cover the whole batch and only the first project result holds them.
+			*/
+			ThreadPoolStatistics					threadPoolStatistics;
+
 			/**
 			*	@brief Merge a result to this result.
 			*	
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>		//std::shared_ptr
 #include <functional>	//std::function
 
 #include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
@@ -15,6 +16,10 @@
 #include "Kodgen/CodeGen/CodeGenEnv.h"
 #include "Kodgen/CodeGen/CodeGenUnitSettings.h"
 #include "Kodgen/CodeGen/CodeGenModule.h"
+#include "Kodgen/CodeGen/GeneratedCodeChunk.h"
+#include "Kodgen/CodeGen/GeneratedFilePack.h"
+#include "Kodgen/CodeGen/FileProcessingExplanation.h"
+#include "Kodgen/CodeGen/GeneratedCodeContribution.h"
 #include "Kodgen/Misc/ILogger.h"
 #include "Kodgen/Misc/Filesystem.h"
 #include "Kodgen/Misc/FundamentalTypes.h"
@@ -32,6 +37,21 @@ namespace kodgen
 			*/
 			bool						_isCopy	= false;
 
+			/** Is the code generated by each module being measured? Only true during a generateCode call. */
+			bool						_isMeasuringContributions	= false;
+
+			/** Size of the code of each generated file when the last contribution was recorded (see getGeneratedCodeSizes). */
+			std::vector<size_t>			_lastGeneratedCodeSizes;
+
+			/** Size of the code generated by each registered module in each generated file, indexed by module then by generated file. */
+			std::vector<std::vector<uint64>>	_moduleContributions;
+
+			/** Pack the generated files are written to, shared with all copies of this unit. nullptr if generated files are not packed. */
+			std::shared_ptr<GeneratedFilePack>	_generatedFilePack;
+
+			/** Can generated files be provisional files written by generateProvisionalCode? If not, explainIsUpToDate doesn't need to look for them. */
+			bool								_areProvisionalFilesEnabled	= false;
+
 			/**
 			*	@brief Insert a code generator to a sorted vector ordered by generation order.
 			* 
@@ -47,11 +67,20 @@ namespace kodgen
 			*/
 			void						clearGenerationModules()																				noexcept;
 
+			/**
+			*	@brief	Attribute the code generated since the last recorded contribution to the module owning the provided code generator.
+			*			Does nothing if contributions are not being measured.
+			* 
+			*	@param codeGenerator Code generator which generated the code since the last call.
+			*/
+			void						recordContribution(ICodeGenerator const& codeGenerator)												noexcept;
+
 			/**
 			*	@brief Iterate and execute recursively a visitor function on each parsed entity/registered module pair.
 			* 
-			*	@param visitor	Visitor function to execute on all traversed entities.
-			*	@param env		Generation environment structure.
+			*	@param visitor				Visitor function to execute on all traversed entities.
+			*	@param env					Generation environment structure.
+			*	@param streamedEntitiesCode	Code already generated for streamed top-level entities, appended instead of traversing them. Can be nullptr.
 			* 
 			*	@return ETraversalBehaviour::Recurse if the traversal completed successfully.
 			*			ETraversalBehaviour::AbortWithSuccess if the traversal was aborted prematurely without error.
@@ -61,7 +90,42 @@ namespace kodgen
 																								   EntityInfo const&,
 																								   CodeGenEnv&,
 																								   void const*)>		visitor,
-																 CodeGenEnv&											env)					noexcept;
+																 CodeGenEnv&											env,
+																 StreamedEntitiesCode*									streamedEntitiesCode)	noexcept;
+
+			/**
+			*	@brief	Iterate and execute recursively a visitor function on a top-level namespace, struct/class or enum and
+			*			all its nested entities/registered module pair.
+			* 
+			*	@param codeGenerator	Code generator to run the visitor with.
+			*	@param entity			Namespace, struct/class or enum to iterate on.
+			*	@param env				Generation environment structure.
+			*	@param visitor			Visitor function to execute on all traversed entities.
+			* 
+			*	@return The result of the traversal of the entity.
+			*/
+			ETraversalBehaviour			foreachCodeGenEntityPairInTopLevelEntity(ICodeGenerator&										codeGenerator,
+																				 EntityInfo const&										entity,
+																				 CodeGenEnv&											env,
+																				 std::function<ETraversalBehaviour(ICodeGenerator&,
+																												   EntityInfo const&,
+																												   CodeGenEnv&,
+																												   void const*)>		visitor)	noexcept;
+
+			/**
+			*	@brief	Append the code streamed for a top-level entity by a code generator, if any.
+			* 
+			*	@param entity				Top-level entity.
+			*	@param codeGeneratorIndex	Index of the code generator in the sorted code generators list.
+			*	@param streamedEntitiesCode	Code already generated for streamed top-level entities. Can be nullptr.
+			*	@param out_result			Traversal result of the entity when it was streamed.
+			* 
+			*	@return true if streamed code was found and appended, else false (the entity must be traversed).
+			*/
+			bool						appendStreamedEntityCode(EntityInfo const&		entity,
+																 size_t					codeGeneratorIndex,
+																 StreamedEntitiesCode*	streamedEntitiesCode,
+																 ETraversalBehaviour&	out_result)												noexcept;
 
 			/**
 			*	@brief	Iterate and execute recursively a visitor function on a namespace and
@@ -247,6 +311,27 @@ namespace kodgen
 			bool							isFileNewerThan(fs::path const& file,
 															fs::path const& referenceFile)					const	noexcept;
 
+			/**
+			*	@brief Check if a generated file exists, either in the generated file pack if generated files are packed or on disk.
+			* 
+			*	@param generatedFile Path to the generated file.
+			* 
+			*	@return true if the generated file exists, else false.
+			*/
+			bool							generatedFileExists(fs::path const& generatedFile)				const	noexcept;
+
+			/**
+			*	@brief	Check if a generated file last write time is newer than reference file last write time.
+			*			The generated file last write time is read from the generated file pack if generated files are packed.
+			* 
+			*	@param generatedFile	Path to the existing generated file (see generatedFileExists).
+			*	@param referenceFile	Path to the reference file to compare.
+			* 
+			*	@return true if generatedFile last write time is newer than referenceFile's, else false.
+			*/
+			bool							isGeneratedFileNewerThan(fs::path const& generatedFile,
+																	 fs::path const& referenceFile)			const	noexcept;
+
 			/**
 			*	@brief Compute the list of all generators nested in this CodeGenUnit sorted by ascending generation order.
 			* 
@@ -254,6 +339,40 @@ namespace kodgen
 			*/
 			std::vector<ICodeGenerator*>	getSortedCodeGenerators()										const	noexcept;
 
+			/**
+			*	@brief	Check whether this unit implementation can keep the code generated for an entity aside and append it later
+			*			(see takeGeneratedCode and appendGeneratedCode).
+			*			Default implementation returns false.
+			* 
+			*	@return true if the unit supports entity streaming, else false.
+			*/
+			virtual bool					supportsEntityStreaming()										const	noexcept;
+
+			/**
+			*	@brief	Move all the code generated since the last preGenerateCode or takeGeneratedCode call into a chunk.
+			*			Default implementation does nothing.
+			* 
+			*	@param out_chunk Chunk receiving the generated code.
+			*/
+			virtual void					takeGeneratedCode(GeneratedCodeChunk& out_chunk)						noexcept;
+
+			/**
+			*	@brief	Append the code of a chunk filled by takeGeneratedCode (in another unit instance) to the code generated so far.
+			*			Default implementation does nothing.
+			* 
+			*	@param chunk Chunk containing the code to append.
+			*/
+			virtual void					appendGeneratedCode(GeneratedCodeChunk&& chunk)							noexcept;
+
+			/**
+			*	@brief	Compute the size of the code generated so far for each generated file, in the order of getGeneratedFilePaths.
+			*			Used to attribute the generated code to the modules which generated it.
+			*			Default implementation generates no file.
+			* 
+			*	@param out_sizes Vector filled with the size of the code generated for each file.
+			*/
+			virtual void					getGeneratedCodeSizes(std::vector<size_t>& out_sizes)			const	noexcept;
+
 		public:
 			/** Logger used to issue logs from this CodeGenUnit. */
 			ILogger*	logger	= nullptr;
@@ -272,6 +391,49 @@ namespace kodgen
 			*/
 			virtual bool				isUpToDate(fs::path const& sourceFile)			const	noexcept = 0;
 
+			/**
+			*	@brief	Explain why the generated code for a given source file is up-to-date or not.
+			*			The default implementation only relies on isUpToDate, override it to give more details.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return The explanation, with an UpToDate reason if the code generated for sourceFile is up-to-date.
+			*/
+			virtual FileProcessingExplanation	explainIsUpToDate(fs::path const& sourceFile)	const	noexcept;
+
+			/**
+			*	@brief	Quickly generate provisional files for a given source file without parsing it, so that the source file
+			*			compiles (and is correctly indexed by IDEs) until the full generation replaces them.
+			*			The default implementation does nothing.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return true if the provisional files are valid (or don't need to be generated), else false.
+			*/
+			virtual bool				generateProvisionalCode(fs::path const& sourceFile)	const	noexcept;
+
+			/**
+			*	@brief	Get the paths to the files generated for a given source file.
+			*			The default implementation returns an empty list.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return The paths to the files generated for sourceFile.
+			*/
+			virtual std::vector<fs::path>	getGeneratedFilePaths(fs::path const& sourceFile)	const	noexcept;
+
+			/**
+			*	@brief	Look for a file generated for a given source file which doesn't exist (on disk, or in the pack if generated files are packed).
+			*			Only the existence of the files returned by getGeneratedFilePaths is checked, so it is much cheaper than explainIsUpToDate.
+			* 
+			*	@param sourceFile			Path to the source file.
+			*	@param out_missingFile		Path to the first missing generated file, only set if a file is missing.
+			*
+			*	@return true if a generated file is missing, else false.
+			*/
+			bool							findMissingGeneratedFile(fs::path const&	sourceFile,
+																	 fs::path&			out_missingFile)	const	noexcept;
+
 			/**
 			*	@brief	Check whether all settings are setup correctly for this unit to work.
 			*			If output directory path is valid but doesn't exist yet, it is created.
@@ -282,6 +444,45 @@ namespace kodgen
 			*/
 			virtual bool				checkSettings()									const	noexcept;
 
+			/**
+			*	@brief	Load the generated file pack from the output directory if CodeGenUnitSettings::shouldPackGeneratedFiles is true.
+			*			Must be called before the unit is copied so that all copies write to the same pack.
+			* 
+			*	@return true if generated files are not packed or the pack was loaded, false if a new pack was created.
+			*/
+			bool						loadGeneratedFilePack()									noexcept;
+
+			/**
+			*	@brief	Save the generated file pack if generated files are packed, after removing the files whose source file was deleted.
+			*			If CodeGenUnitSettings::packExtractionDirectory is set, the packed files are extracted there and the VFS overlay is written.
+			* 
+			*	@return true if generated files are not packed or the pack was successfully saved (and extracted), else false.
+			*/
+			bool						saveGeneratedFilePack()							const	noexcept;
+
+			/**
+			*	@brief Getter for _generatedFilePack field.
+			* 
+			*	@return The pack generated files are written to, nullptr if generated files are not packed.
+			*/
+			GeneratedFilePack*			getGeneratedFilePack()							const	noexcept;
+
+			/**
+			*	@brief	Setter for _areProvisionalFilesEnabled field, set by the CodeGenManager from CodeGenManagerSettings::shouldGenerateProvisionalFiles
+			*			before checking which files are up-to-date.
+			*			Provisional files left by a run with provisional files enabled are not detected by runs with provisional files disabled.
+			* 
+			*	@param enabled Can generated files be provisional files?
+			*/
+			void						setProvisionalFilesEnabled(bool enabled)				noexcept;
+
+			/**
+			*	@brief Getter for _areProvisionalFilesEnabled field.
+			* 
+			*	@return true if generated files can be provisional files, else false.
+			*/
+			bool						areProvisionalFilesEnabled()					const	noexcept;
+
 			/**
 			*	@brief	Calls preGenerateCode, foreachModuleEntityPair, and postGenerateCode in that order.
 			*			If any of the previously mentioned method returns false, the generation aborts (next methods
@@ -289,11 +490,45 @@ namespace kodgen
 			*
 			*			ex: If preGenerateCode returns false, both foreachModuleEntityPair and postGenerateCode calls will be skipped.
 			*			
-			*	@param parsingResult	Result of a file parsing used to generate code.
+			*	@param parsingResult			Result of a file parsing used to generate code.
+			*	@param streamedEntitiesCode		Code already generated for the streamed top-level entities of parsingResult (see generateStreamedEntityCode).
+			*									Chunks are moved out of the collection. Can be nullptr.
 			* 
 			*	@return true if preGenerateCode, foreachModuleEntityPair and postGenerateCode calls have succeeded, else false.
 			*/
-			bool						generateCode(FileParsingResult const& parsingResult)	noexcept;
+			bool						generateCode(FileParsingResult const&	parsingResult,
+													 StreamedEntitiesCode*		streamedEntitiesCode = nullptr)	noexcept;
+
+			/**
+			*	@brief	Generate the code of a single top-level entity while the remaining of its file is still being parsed.
+			*			The code is kept in one chunk per code generator and appended when generateCode is called for the whole file.
+			*			Should only be called if canStreamEntities returns true.
+			* 
+			*	@param entity		Completely parsed top-level namespace, struct/class or enum. Its outer entities must be up-to-date.
+			*	@param parsedFile	Path to the file containing the entity.
+			*	@param out_chunks	Chunks filled with the generated code, in code generators order.
+			* 
+			*	@return true if the code was generated, else false.
+			*/
+			bool						generateStreamedEntityCode(EntityInfo const&				entity,
+																   fs::path const&					parsedFile,
+																   std::vector<GeneratedCodeChunk>&	out_chunks)			noexcept;
+
+			/**
+			*	@brief Check whether top-level entities can be generated while their file is still being parsed.
+			* 
+			*	@return true if the unit implementation supports entity streaming and no registered generator needs the whole file context, else false.
+			*/
+			bool						canStreamEntities()								const	noexcept;
+
+			/**
+			*	@brief Get the amount of code each registered module generated for each file during the last generateCode call.
+			* 
+			*	@param sourceFile Path to the source file of the last generateCode call.
+			* 
+			*	@return The contributions to each file returned by getGeneratedFilePaths.
+			*/
+			std::vector<GeneratedFileContributions>	getGeneratedCodeContributions(fs::path const& sourceFile)	const	noexcept;
 
 			/**
 			*	@brief Add a module to the internal list of generation modules.
@@ -44,10 +44,91 @@ namespace kodgen
 			void			loadOutputDirectory(toml::value const&	generationSettings,
 												ILogger*			logger)						noexcept;
 
+			/**
+			*	@brief Load the shouldWriteGeneratedFilesOnlyIfChanged setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldWriteGeneratedFilesOnlyIfChanged(toml::value const&	generationSettings,
+																	   ILogger*				logger)	noexcept;
+
+			/**
+			*	@brief Load the shouldStreamEntities setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldStreamEntities(toml::value const&	generationSettings,
+													 ILogger*			logger)						noexcept;
+
+			/**
+			*	@brief Load the shouldPackGeneratedFiles setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldPackGeneratedFiles(toml::value const&	generationSettings,
+														 ILogger*			logger)					noexcept;
+
+			/**
+			*	@brief Load the shouldMeasureModuleContributions setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadShouldMeasureModuleContributions(toml::value const&	generationSettings,
+																 ILogger*			logger)			noexcept;
+
+			/**
+			*	@brief Load the packExtractionDirectory setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadPackExtractionDirectory(toml::value const&	generationSettings,
+														ILogger*			logger)					noexcept;
+
 		public:
 			/** Name of the header containing all entity macro definitions. */
 			static inline fs::path const entityMacrosFilename	= "EntityMacros.h";
 
+			/**
+			*	Should generated files be written only if their content changed?
+			*	Unchanged generated files keep their last write time so that builds depending on them are not disturbed,
+			*	unless they are older than their source file: they are then touched so that the source file is not processed again on the next run.
+			*/
+			bool	shouldWriteGeneratedFilesOnlyIfChanged	= false;
+
+			/**
+			*	Should top-level namespaces, structs/classes and enums be generated on the thread pool as soon as they are parsed,
+			*	while the remaining of their file is still being parsed?
+			*	Only applies if the unit supports it and no registered generator needs the whole file context (see ICodeGenerator::needsWholeFileContext).
+			*	The generated files are identical, but giant files start generating earlier.
+			*/
+			bool	shouldStreamEntities					= false;
+
+			/**
+			*	Should all generated headers and sources be written to a single indexed pack file (see GeneratedFilePack)
+			*	instead of one file each in the output directory?
+			*	Provisional files are not generated in this mode, and the entity macros header is still written as a regular file.
+			*/
+			bool	shouldPackGeneratedFiles				= false;
+
+			/**
+			*	Directory the packed files are extracted to after each run, ideally on a local disk.
+			*	When set, a clang VFS overlay mapping the generated file paths to the extracted files is also written in the output directory
+			*	(to use with -ivfsoverlay), other compilers can add the directory to their include directories instead.
+			*	Only used if shouldPackGeneratedFiles is true. Left empty, the files are only available in the pack file.
+			*/
+			fs::path	packExtractionDirectory;
+
+			/**
+			*	Should the size of the code generated by each module be measured for each generated file (see CodeGenResult::generatedFileContributions)?
+			*	Measuring computes the size of all generated files after each generator call, so only enable it to profile the generated code.
+			*/
+			bool		shouldMeasureModuleContributions		= false;
+
 			/**
 			*	@brief	Setter for _outputDirectory.
 			*			If the path exists check that it is a directory.
@@ -0,0 +1,58 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Reason why a file was scheduled for processing or skipped by the CodeGenManager.
+	*/
+	enum class EFileProcessingReason : uint8
+	{
+		/**
+		*	The generated code is up-to-date, so the file is skipped.
+		*/
+		UpToDate = 0u,
+
+		/**
+		*	The generated code is up-to-date but the regeneration of all files has been forced.
+		*/
+		ForcedRegeneration,
+
+		/**
+		*	A generated file doesn't exist yet.
+		*/
+		MissingGeneratedFile,
+
+		/**
+		*	The source file has been modified after a generated file was last written.
+		*/
+		OutdatedGeneratedFile,
+
+		/**
+		*	The CodeGenUnit considers the generated code outdated without further details.
+		*/
+		OutOfDate,
+
+		/**
+		*	The git index and file stat data are the same as during the previous run, so the file is skipped.
+		*/
+		UnchangedSinceLastRun,
+
+		/**
+		*	The git index or file stat data changed since the previous run although generated files look up-to-date.
+		*/
+		ChangedSinceLastRun
+	};
+
+	std::string toString(EFileProcessingReason reason) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	State of a file compared to the previous run, as detected from the git index.
+	*/
+	enum class EGitFileState : uint8
+	{
+		/**
+		*	The file is not tracked by git (or the git index could not be loaded).
+		*/
+		Untracked = 0u,
+
+		/**
+		*	The file is tracked by git but was not recorded during the previous run.
+		*/
+		Unknown,
+
+		/**
+		*	The file blob hash, size and last write time are the same as during the previous run.
+		*/
+		Unchanged,
+
+		/**
+		*	The file blob hash, size or last write time changed since the previous run.
+		*/
+		Changed
+	};
+}
\ No newline at end of file
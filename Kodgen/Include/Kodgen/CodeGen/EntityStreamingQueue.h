@@ -0,0 +1,85 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+#include "Kodgen/CodeGen/GeneratedCodeChunk.h"
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	//Forward declaration
+	class CodeGenUnit;
+	class EntityInfo;
+
+	/**
+	*	Top-level entities of a file being parsed, waiting for their code to be generated by any thread.
+	*	The thread parsing the file pushes entities as soon as they are completely parsed, and other threads
+	*	pop and generate them while the remaining of the file is parsed.
+	*/
+	class EntityStreamingQueue
+	{
+		private:
+			/** Mutex protecting all the queue fields. */
+			std::mutex						_mutex;
+
+			/** Condition notified each time the generation of an entity ends. */
+			std::condition_variable			_generationEndCondition;
+
+			/** Entities waiting for their code to be generated. */
+			std::deque<EntityInfo const*>	_pendingEntities;
+
+			/** Number of entities being generated. */
+			size_t							_runningGenerationCount	= 0u;
+
+			/** Code generated for all entities so far. */
+			StreamedEntitiesCode			_generatedCode;
+
+		public:
+			/**
+			*	@brief Add an entity to the queue.
+			*
+			*	@param entity Completely parsed top-level entity. It must stay at the same address until takeGeneratedCode is called.
+			*/
+			void					push(EntityInfo const& entity)					noexcept;
+
+			/**
+			*	@brief Check whether some entities are waiting to be generated.
+			*
+			*	@return true if there is at least one pending entity, else false.
+			*/
+			bool					hasPendingEntities()							noexcept;
+
+			/**
+			*	@brief Pop the oldest pending entity and generate its code with the provided unit.
+			*
+			*	@param codeGenUnit	Generation unit used to generate the entity code. It must not be used by another thread.
+			*	@param parsedFile	Path to the file containing the entity.
+			*
+			*	@return true if an entity was generated, false if there was no pending entity.
+			*/
+			bool					generateNext(CodeGenUnit&		codeGenUnit,
+												 fs::path const&	parsedFile)		noexcept;
+
+			/**
+			*	@brief Wait for the end of all generations started by other threads.
+			*/
+			void					waitForRunningGenerations()						noexcept;
+
+			/**
+			*	@brief	Move the code generated for all entities out of the queue.
+			*			Entities which are still pending (or whose generation failed) have no code, so they are generated with the whole file.
+			*
+			*	@return The code generated for each entity.
+			*/
+			StreamedEntitiesCode	takeGeneratedCode()								noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Processing cost of each file measured during the previous runs, saved in the generated files output directory.
+	*	Used to estimate the remaining time of a run (see CodeGenProgress::estimatedRemainingTime).
+	*/
+	class FileCostHistory
+	{
+		private:
+			/** Name of the history file saved in the generated files output directory. */
+			static constexpr char const*	_historyFilename	= "KodgenFileCosts.txt";
+
+			/** First line of the history file, used to detect outdated formats. */
+			static constexpr char const*	_historyHeader		= "KodgenFileCosts 1";
+
+			/** Cost (in seconds) of each file, indexed by the file path. */
+			std::unordered_map<std::string, float>	_costs;
+
+		public:
+			/**
+			*	@brief	Load the history saved in the provided directory.
+			*			The history is cleared first, and stays empty if there is no history file.
+			*
+			*	@param outputDirectory Directory containing the history file.
+			*
+			*	@return true if a history file was loaded, else false.
+			*/
+			bool	load(fs::path const& outputDirectory)						noexcept;
+
+			/**
+			*	@brief Save the history to the provided directory.
+			*
+			*	@param outputDirectory Directory the history file is written to.
+			*
+			*	@return true if the history file was successfully written, else false.
+			*/
+			bool	save(fs::path const& outputDirectory)				const	noexcept;
+
+			/**
+			*	@brief Get the cost of a file.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return The time (in seconds) spent to parse and generate the file, or a negative value if the file has no history.
+			*/
+			float	getCost(fs::path const& file)						const	noexcept;
+
+			/**
+			*	@brief Set the cost of a file, replacing its previous cost if any.
+			*
+			*	@param file Path to the file.
+			*	@param cost	Time (in seconds) spent to parse and generate the file.
+			*/
+			void	setCost(fs::path const&	file,
+							float			cost)								noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/CodeGen/EFileProcessingReason.h"
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	class FileProcessingExplanation
+	{
+		public:
+			/** Path to the source file the explanation is about. */
+			fs::path				file;
+
+			/** Reason why the file was scheduled for processing or skipped. */
+			EFileProcessingReason	reason	= EFileProcessingReason::OutOfDate;
+
+			/** Generated file responsible for the decision (missing or outdated one), empty if not applicable. */
+			fs::path				generatedFile;
+
+			/**
+			*	@brief Check whether the explained file is scheduled for processing or not.
+			*
+			*	@return true if the file is processed, false if it is skipped.
+			*/
+			bool		isProcessed()	const noexcept;
+
+			/**
+			*	@brief Retrieve the string representation of one of this class instances.
+			*
+			*	@return The string representation of this instance.
+			*/
+			std::string	toString()		const noexcept;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Kodgen/CodeGen/ETraversalBehaviour.h"
+
+namespace kodgen
+{
+	//Forward declaration
+	class EntityInfo;
+
+	/**
+	*	Code generated by a single code generator for a single streamed top-level entity.
+	*	The chunk is kept aside until the whole file has been parsed, then appended to the file generated code.
+	*/
+	class GeneratedCodeChunk
+	{
+		public:
+			/** Generated code of each location defined by the CodeGenUnit implementation. */
+			std::vector<std::string>							code;
+
+			/** Generated code attached to a specific entity by the CodeGenUnit implementation. */
+			std::unordered_map<EntityInfo const*, std::string>	entityCode;
+
+			/** Value returned by the traversal of the entity, used to replicate a Break or an abort when the chunk is appended. */
+			ETraversalBehaviour									traversalResult	= ETraversalBehaviour::Recurse;
+	};
+
+	/** Code generated for each streamed top-level entity, with one chunk per code generator in generation order. */
+	using StreamedEntitiesCode = std::unordered_map<EntityInfo const*, std::vector<GeneratedCodeChunk>>;
+}
\ No newline at end of file
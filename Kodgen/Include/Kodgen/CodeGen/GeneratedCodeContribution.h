@@ -0,0 +1,49 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Amount of code generated by a single code generation module in a generated file.
+	*	Code generated by property code generators is attributed to the module they are attached to.
+	*/
+	class GeneratedCodeContribution
+	{
+		public:
+			/** Name of the contributing module (see CodeGenModule::getName). */
+			std::string	moduleName;
+
+			/** Number of bytes of code generated by the module. */
+			uint64		size	= 0u;
+	};
+
+	/** Code generation modules which contributed to a single generated file. */
+	class GeneratedFileContributions
+	{
+		public:
+			/** Path to the generated file. */
+			fs::path								generatedFile;
+
+			/** Contribution of each module which generated code in the file, sorted by descending size. */
+			std::vector<GeneratedCodeContribution>	contributions;
+
+			/**
+			*	@brief Compute the number of bytes generated by all modules in the file.
+			*
+			*	@return The sum of all contributions.
+			*/
+			uint64	getTotalSize()	const	noexcept;
+	};
+}
\ No newline at end of file
@@ -9,17 +9,48 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <atomic>
 
 #include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
 {
+	//Forward declaration
+	class GeneratedFilePack;
+
 	class GeneratedFile
 	{
 		private:
-			fs::path		_path;
-			fs::path		_sourceFilePath;
-			std::ofstream	_streamToFile;
+			/** Number of bytes generated by all instances since the program started. */
+			static std::atomic<uint64>	_totalGeneratedBytes;
+
+			fs::path			_path;
+			fs::path			_sourceFilePath;
+			std::ofstream		_streamToFile;
+
+			/** Content buffered until destruction when the file must only be written if its content changed. */
+			std::ostringstream	_bufferedContent;
+
+			/** Should the file be written only if the new content is different from the existing file content. */
+			bool				_writeOnlyIfChanged;
+
+			/** Pack the content is written to on destruction instead of the file. Can be nullptr. */
+			GeneratedFilePack*	_pack;
+
+			/**
+			*	@brief Get the stream lines are written to.
+			*
+			*	@return _bufferedContent if the content is buffered until destruction, else _streamToFile.
+			*/
+			std::ostream&	getStream()									noexcept;
+
+			/**
+			*	@brief	Write the buffered content to the file if it is different from the existing file content.
+			*			If the content is unchanged, the file last write time is only updated if the file is not newer than its source file.
+			*/
+			void			flushBufferedContentIfChanged()				noexcept;
 
 			/**
 			*	@brief Write a single line in the generated file
@@ -50,8 +81,19 @@ namespace kodgen
 
 		public:
 			GeneratedFile()													= delete;
-			GeneratedFile(fs::path&&		generatedFilePath,
-						  fs::path const&	sourceFilePath = fs::path())	noexcept;
+			/**
+			*	@param generatedFilePath	Path to the generated file.
+			*	@param sourceFilePath		Path to the source file this file is generated from.
+			*	@param writeOnlyIfChanged	If true, the content is buffered and the file is only written on destruction if its content changed,
+			*								so that the file last write time (and all builds depending on it) are left untouched otherwise.
+			*								The last write time is still updated if the file is not newer than the source file, since any build
+			*								depending on the generated file also depends on the modified source file.
+			*	@param pack					If not nullptr, the content is buffered and written to the pack on destruction instead of the file.
+			*/
+			GeneratedFile(fs::path&&			generatedFilePath,
+						  fs::path const&		sourceFilePath		= fs::path(),
+						  bool					writeOnlyIfChanged	= false,
+						  GeneratedFilePack*	pack				= nullptr)	noexcept;
 			GeneratedFile(GeneratedFile const&)								= delete;
 			GeneratedFile(GeneratedFile&&)									= delete;
 			~GeneratedFile()												noexcept;
@@ -108,6 +150,14 @@ namespace kodgen
 			*	@return The path to the source file for this generated file
 			*/
 			fs::path const&	getSourceFilePath()			const	noexcept;
+
+			/**
+			*	@brief	Get the number of bytes generated by all GeneratedFile instances since the program started,
+			*			including the content of files left untouched because it didn't change.
+			*
+			*	@return The number of generated bytes.
+			*/
+			static uint64	getTotalGeneratedBytes()			noexcept;
 	};
 
 	#include "Kodgen/CodeGen/GeneratedFile.inl"
@@ -0,0 +1,188 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	All the files generated in an output directory, stored in a single indexed pack file instead of one file per generated file.
+	*
+	*	The pack file starts with a header line, the number of packed files and two index lines per file ("<size> <lastWriteTime> <path>",
+	*	path being relative to the output directory, then the path of the source file it is generated from), followed by the content
+	*	of all files in index order.
+	*	Compilers can't read the pack directly: the files are extracted to a directory (ideally on a local disk), and clang can
+	*	redirect the generated paths to the extracted files with the VFS overlay written by writeVfsOverlay (-ivfsoverlay).
+	*
+	*	Files can be written by several threads at the same time.
+	*/
+	class GeneratedFilePack
+	{
+		private:
+			/** A packed file. */
+			struct Entry
+			{
+				/** Content of the file. */
+				std::string	content;
+
+				/** Source file the file is generated from, empty if unknown. */
+				fs::path	sourceFile;
+
+				/** Time the file was last generated, as a fs::file_time_type count. */
+				int64		lastWriteTime	= 0;
+
+				/** Has the content changed since the file was last extracted? */
+				bool		isDirty			= false;
+			};
+
+			/** First line of the pack file, used to detect outdated formats. */
+			static constexpr char const*	_packHeader		= "KodgenPack 2";
+
+			/** Directory the packed files are generated in. */
+			fs::path						_outputDirectory;
+
+			/** Mutex protecting _entries, _removedEntries and _isDirty. */
+			mutable std::mutex				_mutex;
+
+			/** Packed files, indexed by their generic path relative to the output directory. */
+			std::map<std::string, Entry>	_entries;
+
+			/** Keys of the files removed from the pack since the last extraction, whose extracted copy must be deleted. */
+			std::vector<std::string>		_removedEntries;
+
+			/** Has any file been written since the pack was loaded or saved? */
+			bool							_isDirty		= false;
+
+			/**
+			*	@brief Get the key of a generated file in _entries.
+			*
+			*	@param generatedFile Path to the generated file.
+			*
+			*	@return The generic path of the file relative to the output directory.
+			*/
+			std::string	getKey(fs::path const& generatedFile)					const	noexcept;
+
+		public:
+			/** Name of the pack file, written in the output directory. */
+			static constexpr char const*	packFilename		= "KodgenGenerated.pack";
+
+			/** Name of the clang VFS overlay file, written in the output directory. */
+			static constexpr char const*	vfsOverlayFilename	= "KodgenGenerated.vfsoverlay.yaml";
+
+			/**
+			*	@param outputDirectory Directory the packed files are generated in.
+			*/
+			explicit GeneratedFilePack(fs::path outputDirectory)	noexcept;
+
+			/**
+			*	@brief	Load the pack file saved in the output directory.
+			*			The pack is cleared first, and stays empty if there is no valid pack file.
+			*
+			*	@return true if a pack file was loaded, else false.
+			*/
+			bool		load()													noexcept;
+
+			/**
+			*	@brief Save the pack file in the output directory if any file has been written since the pack was loaded.
+			*
+			*	@return true if the pack file is up-to-date, else false.
+			*/
+			bool		save()													noexcept;
+
+			/**
+			*	@brief Add a file to the pack, or replace its content.
+			*
+			*	@param generatedFile	Path to the generated file, in the output directory.
+			*	@param sourceFile		Path to the source file the file is generated from. Can be empty.
+			*	@param content			Content of the file.
+			*/
+			void		writeFile(fs::path const&	generatedFile,
+								  fs::path const&	sourceFile,
+								  std::string&&		content)					noexcept;
+
+			/**
+			*	@brief	Append content to a packed file, adding an empty file to the pack if it is not packed yet.
+			*			Unlike writeFile, the time the file was last generated is left untouched (a new file is never up-to-date),
+			*			so it is used for placeholders and macros the source file needs to be parsed before its generation.
+			*
+			*	@param generatedFile	Path to the generated file, in the output directory.
+			*	@param sourceFile		Path to the source file the file is generated from. Can be empty.
+			*	@param content			Content appended to the file.
+			*/
+			void		appendToFile(fs::path const&	generatedFile,
+									 fs::path const&	sourceFile,
+									 std::string const&	content)				noexcept;
+
+			/**
+			*	@brief	Remove the files whose source file doesn't exist anymore from the pack.
+			*			Their extracted copy is deleted by the next extraction.
+			*
+			*	@return The number of removed files.
+			*/
+			size_t		removeOrphanedFiles()									noexcept;
+
+			/**
+			*	@brief Get the time a packed file was last generated.
+			*
+			*	@param generatedFile			Path to the generated file, in the output directory.
+			*	@param out_lastWriteTime		Time the file was last generated, only set if the file is packed.
+			*
+			*	@return true if the file is packed, else false.
+			*/
+			bool		getLastWriteTime(fs::path const&	generatedFile,
+										 fs::file_time_type&	out_lastWriteTime)	const	noexcept;
+
+			/**
+			*	@brief	Get the absolute path and content of the packed files included by a file, directly or through other headers,
+			*			so that they can be provided to libclang as unsaved files (generated files are never written to the output directory when they are packed).
+			*			Include directives are found by a lexical scan which ignores conditional compilation, so more files than needed may be returned.
+			*
+			*	@param sourceFile			File to parse.
+			*	@param includeDirectories	Directories searched for the included files, after the directory of the including file for quoted includes.
+			*
+			*	@return A copy of the path and content of the included packed files.
+			*/
+			std::vector<std::pair<std::string, std::string>>	getUnsavedFiles(fs::path const&					sourceFile,
+																				std::vector<fs::path> const&	includeDirectories)	const	noexcept;
+
+			/**
+			*	@brief	Write the packed files whose content changed since the last extraction (or whose extracted copy is missing) to a directory,
+			*			keeping their path relative to the output directory, and delete the extracted copy of the removed files.
+			*			Unchanged files are neither read nor written so that builds depending on them are not disturbed.
+			*
+			*	@param extractionDirectory Directory the files are extracted to.
+			*
+			*	@return true if all files have been extracted, else false.
+			*/
+			bool		extract(fs::path const& extractionDirectory)				noexcept;
+
+			/**
+			*	@brief	Write a clang VFS overlay in the output directory, redirecting each packed file path to its extracted copy.
+			*			Paths which are not packed fall through to the real filesystem.
+			*
+			*	@param extractionDirectory Directory the files are extracted to (see extract).
+			*
+			*	@return true if the overlay was written, else false.
+			*/
+			bool		writeVfsOverlay(fs::path const& extractionDirectory)	const	noexcept;
+
+			/**
+			*	@brief Getter for _outputDirectory.
+			*
+			*	@return _outputDirectory.
+			*/
+			fs::path const&	getOutputDirectory()							const	noexcept;
+	};
+}
\ No newline at end of file
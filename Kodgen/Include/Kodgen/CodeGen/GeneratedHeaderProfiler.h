@@ -0,0 +1,108 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <clang-c/Index.h>
+
+#include "Kodgen/CodeGen/GeneratedCodeContribution.h"
+#include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	//Forward declaration
+	class ParsingSettings;
+
+	/** Cost of compiling a single generated file, measured by parsing it in isolation. */
+	class GeneratedHeaderCost
+	{
+		public:
+			/** Path to the generated file. */
+			fs::path								generatedFile;
+
+			/** Time (in seconds) spent by libclang to parse the file. */
+			float									parseDuration	= 0.0f;
+
+			/** Memory (in bytes) used by libclang to hold the translation unit of the file. */
+			uint64									memory			= 0u;
+
+			/** Number of errors reported while parsing the file. Generated files often depend on their source file, so errors are expected. */
+			uint32									errorCount		= 0u;
+
+			/** Contribution of each module which generated code in the file, sorted by descending size. */
+			std::vector<GeneratedCodeContribution>	contributions;
+
+			/**
+			*	@brief Retrieve the string representation of one of this class instances.
+			*
+			*	@param contributorCount Maximum number of contributing modules to list.
+			*
+			*	@return The string representation of this instance.
+			*/
+			std::string	toString(size_t contributorCount)	const	noexcept;
+	};
+
+	/**
+	*	Analysis pass parsing each generated file in isolation with the project compilation arguments
+	*	to find the generated files which are the most expensive to compile, and the modules responsible for them.
+	*/
+	class GeneratedHeaderProfiler
+	{
+		private:
+			/**
+			*	@brief	Get the compilation arguments used to parse generated files.
+			*			Arguments are the ones of the parser, without the Kodgen parsing macro since generated files are compiled without it.
+			*
+			*	@param parsingSettings Initialized parsing settings of the project.
+			*
+			*	@return The compilation arguments.
+			*/
+			static std::vector<char const*>	getCompilationArguments(ParsingSettings const& parsingSettings)					noexcept;
+
+			/**
+			*	@brief Parse a generated file and measure its cost.
+			*
+			*	@param clangIndex			Index used to parse the file.
+			*	@param compilationArguments	Arguments passed to libclang.
+			*	@param inout_cost			Cost of the file. generatedFile must be set before the call.
+			*
+			*	@return true if libclang could parse the file, else false.
+			*/
+			bool							profileFile(CXIndex							clangIndex,
+														std::vector<char const*> const&	compilationArguments,
+														GeneratedHeaderCost&			inout_cost)				const	noexcept;
+
+		public:
+			/** Logger used to report the most expensive generated files. Can be nullptr. */
+			ILogger*	logger						= nullptr;
+
+			/** Number of most expensive generated files to report. */
+			size_t		reportedFileCount			= 10u;
+
+			/** Maximum number of contributing modules listed for each reported file. */
+			size_t		reportedContributorCount	= 3u;
+
+			/**
+			*	@brief	Parse the provided generated files one after the other (so that timings are not disturbed by other parsings),
+			*			and report the most expensive ones with the modules which contributed the most code to them.
+			*			Files which don't exist (or were not written) are skipped.
+			*
+			*	@param parsingSettings	Parsing settings of the project, initialized by the generation run (see ParsingSettings::init).
+			*	@param generatedFiles	Generated files with the contribution of each module, as returned in CodeGenResult::generatedFileContributions.
+			*							If a file appears several times, the last entry is used.
+			*
+			*	@return The reportedFileCount most expensive generated files, sorted by descending parse duration.
+			*/
+			std::vector<GeneratedHeaderCost>	profile(ParsingSettings const&							parsingSettings,
+														std::vector<GeneratedFileContributions> const&	generatedFiles)	const	noexcept;
+	};
+}
\ No newline at end of file
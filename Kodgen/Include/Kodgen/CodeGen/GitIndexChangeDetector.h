@@ -0,0 +1,161 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Kodgen/CodeGen/EGitFileState.h"
+#include "Kodgen/Misc/Filesystem.h"
+#include "Kodgen/Misc/FundamentalTypes.h"
+#include "Kodgen/Misc/ILogger.h"
+
+namespace kodgen
+{
+	/**
+	*	Detect which source files changed since the last generation by reading the local git index (.git/index) directly.
+	*
+	*	For each file tracked by git, the blob hash recorded in the index and the file size / last write time are compared
+	*	with the values saved in a manifest at the end of the previous successful run.
+	*	A tracked file whose values all match is unchanged since the last run, so the generated files don't need to be checked.
+	*	Files which are not tracked by git (or if the index can't be read) are not handled by this class.
+	*	A project can span several repositories (submodules, nested repositories): each file is looked up in the index of the
+	*	innermost repository containing it.
+	*/
+	class GitIndexChangeDetector
+	{
+		private:
+			struct FileRecord
+			{
+				/** Hex representation of the blob hash recorded in the git index. */
+				std::string	blobHash;
+
+				/** File size in bytes. */
+				uint64		size			= 0u;
+
+				/** File last write time, in the file clock ticks. */
+				int64		lastWriteTime	= 0;
+			};
+
+			/** Name of the manifest file saved in the generated files output directory. */
+			static constexpr char const*	_manifestFilename	= "KodgenGitManifest.txt";
+
+			struct Repository
+			{
+				/** Canonical path to the repository working tree root. */
+				fs::path										workingTreeRoot;
+
+				/** Blob hash of each tracked file, indexed by path relative to the working tree root (using / separators). */
+				std::unordered_map<std::string, std::string>	indexBlobHashes;
+			};
+
+			/** First line of the manifest, used to detect outdated formats. */
+			static constexpr char const*	_manifestHeader		= "KodgenGitManifest 2";
+
+			/** Loaded repositories. */
+			std::vector<Repository>							_repositories;
+
+			/** Directory containing the manifest, the records are indexed by path relative to it so that they don't depend on the repository. */
+			fs::path										_outputDirectory;
+
+			/** Records saved in the manifest of the previous run, indexed by path relative to the output directory. */
+			std::unordered_map<std::string, FileRecord>		_previousRecords;
+
+			/** Records of files checked during this run, indexed by path relative to the output directory. */
+			std::unordered_map<std::string, FileRecord>		_currentRecords;
+
+			/**
+			*	@brief Find the working tree root and the git directory containing the provided path.
+			*
+			*	@param path					Path located in the working tree.
+			*	@param out_workingTreeRoot	Found working tree root.
+			*	@param out_gitDirectory		Found git directory (usually workingTreeRoot/.git).
+			*
+			*	@return true if a git repository was found, else false.
+			*/
+			static bool		findRepository(fs::path const&	path,
+										   fs::path&		out_workingTreeRoot,
+										   fs::path&		out_gitDirectory)				noexcept;
+
+			/**
+			*	@brief Read the hash size (in bytes) used by the objects of the provided git repository.
+			*
+			*	@param gitDirectory Path to the git directory.
+			*
+			*	@return 32 if the repository uses SHA-256, else 20 (SHA-1).
+			*/
+			static size_t	getHashSize(fs::path const& gitDirectory)						noexcept;
+
+			/**
+			*	@brief Parse the content of a git index file (versions 2, 3 and 4).
+			*
+			*	@param data					Content of the index file.
+			*	@param hashSize				Size of the object hashes in bytes.
+			*	@param out_indexBlobHashes	Blob hash of each tracked file, indexed by path relative to the working tree root.
+			*
+			*	@return true if the index was successfully parsed, else false.
+			*/
+			static bool		parseIndex(std::string const&								data,
+									   size_t											hashSize,
+									   std::unordered_map<std::string, std::string>&	out_indexBlobHashes)	noexcept;
+
+			/**
+			*	@brief Get the key used to reference a file in the index entries of its repository.
+			*
+			*	@param file				Path to the file.
+			*	@param out_repository	Innermost loaded repository containing the file, nullptr if there is none.
+			*
+			*	@return The path of the file relative to the working tree root of its repository, or an empty string if the file is not in any loaded repository.
+			*/
+			std::string		getIndexKey(fs::path const&		file,
+										Repository const*&	out_repository)			const	noexcept;
+
+		public:
+			/**
+			*	@brief	Read the git index of the repositories containing the provided paths, and the manifest of the previous run.
+			*			The detector is cleared first. Repositories whose git files can't be read are left out.
+			*
+			*	@param repositoryPaths	Paths located in the git working trees, each path is resolved to its own repository.
+			*	@param outputDirectory	Directory containing the manifest of the previous run.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*
+			*	@return true if at least one git index was loaded, else false.
+			*/
+			bool	load(std::vector<fs::path> const&	repositoryPaths,
+						 fs::path const&				outputDirectory,
+						 ILogger*						logger)								noexcept;
+
+			/**
+			*	@brief	Check whether a file changed since the last run, using the file size and last write time only (the file content is never read).
+			*			The state of tracked files is recorded to be saved in the next manifest.
+			*
+			*	@param file Path to the file.
+			*
+			*	@return The file state.
+			*/
+			EGitFileState	getFileState(fs::path const& file)									noexcept;
+
+			/**
+			*	@brief	Save the manifest used by the next run, containing the records of all files checked during this run.
+			*			Records of the previous run files which were not checked this time are kept.
+			*
+			*	@param outputDirectory	Directory the manifest is written to.
+			*
+			*	@return true if the manifest was successfully written, else false.
+			*/
+			bool	saveManifest(fs::path const& outputDirectory)					const	noexcept;
+
+			/**
+			*	@brief Check whether a git index has been loaded.
+			*
+			*	@return true if a git index is loaded, else false.
+			*/
+			bool	isLoaded()														const	noexcept;
+	};
+}
\ No newline at end of file
@@ -106,6 +106,18 @@ namespace kodgen
 			*/
 			virtual uint8				getIterationCount()															const	noexcept;
 
+			/**
+			*	@brief	Check whether this generator needs the whole file context to generate the code of an entity.
+			*			A generator which doesn't need it only reads the entity it generates code for (with its nested and outer entities),
+			*			doesn't keep any state between two entities and only uses the parsedFile of CodeGenEnv::getFileParsingResult
+			*			in generateCodeForEntity. Top-level entities can then be generated while the remaining of their file is still
+			*			being parsed (see CodeGenUnitSettings::shouldStreamEntities).
+			*			Default implementation returns true.
+			* 
+			*	@return true if this generator needs the whole file context, else false.
+			*/
+			virtual bool				needsWholeFileContext()														const	noexcept;
+
 			ICodeGenerator& operator=(ICodeGenerator const&)	= default;
 			ICodeGenerator& operator=(ICodeGenerator&&)			= default;
 	};
@@ -8,14 +8,18 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include "Kodgen/CodeGen/CodeGenEnv.h"
 #include "Kodgen/CodeGen/Macro/ECodeGenLocation.h"
+#include "Kodgen/Misc/EAccessSpecifier.h"
 
 namespace kodgen
 {
 	//Forward declaration
 	class MacroCodeGenUnit;
+	class MacroCodeGenUnitSettings;
+	class StructClassInfo;
 
 	class MacroCodeGenEnv : public CodeGenEnv
 	{
@@ -36,6 +40,12 @@ namespace kodgen
 			/** Macro to use to hide a symbol when generated code is injected in a dynamic library. */
 			std::string			_internalSymbolMacro	= "";
 
+			/** Settings of the unit generating the code. */
+			MacroCodeGenUnitSettings const*								_settings						= nullptr;
+
+			/** Access specifier in effect where each class footer macro is used in the parsed file, indexed by macro name. */
+			std::unordered_map<std::string, EAccessSpecifier> const*	_classFooterAccessSpecifiers	= nullptr;
+
 		public:
 			virtual ~MacroCodeGenEnv() = default;
 
@@ -66,6 +76,23 @@ namespace kodgen
 			*	@return _internalSymbolMacro.
 			*/
 			inline std::string const&	getInternalSymbolMacro()	const	noexcept;
+
+			/**
+			*	@brief Getter for field _settings.
+			* 
+			*	@return The settings of the unit generating the code.
+			*/
+			inline MacroCodeGenUnitSettings const*	getSettings()	const	noexcept;
+
+			/**
+			*	@brief	Get the access specifier in effect where the class footer macro of a struct/class is used.
+			*			Class footer code changing the access must restore it, otherwise the members declared after the macro change access.
+			* 
+			*	@param structClassInfo The struct/class.
+			* 
+			*	@return The access specifier, or the default access of the struct/class if its class footer macro could not be found.
+			*/
+			EAccessSpecifier			getClassFooterAccessSpecifier(StructClassInfo const& structClassInfo)	const	noexcept;
 	};
 
 	#include "Kodgen/CodeGen/Macro/MacroCodeGenEnv.inl"
@@ -23,4 +23,9 @@ inline std::string const& MacroCodeGenEnv::getExportSymbolMacro() const noexcept
 inline std::string const& MacroCodeGenEnv::getInternalSymbolMacro() const noexcept
 {
 	return _internalSymbolMacro;
+}
+
+inline MacroCodeGenUnitSettings const* MacroCodeGenEnv::getSettings() const noexcept
+{
+	return _settings;
 }
\ No newline at end of file
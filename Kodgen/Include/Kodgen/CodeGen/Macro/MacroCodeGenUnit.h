@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <array>
 #include <unordered_map>
@@ -17,6 +18,7 @@
 namespace kodgen
 {
 	//Forward declaration
+	class GeneratedFile;
 	class MacroCodeGenUnitSettings;
 	class MacroCodeGenModule;
 
@@ -29,11 +31,23 @@ namespace kodgen
 			/** Separator used for each code location. */
 			static std::array<std::string, static_cast<size_t>(ECodeGenLocation::Count)> const _separators;
 
+			/** First line of the files written by generateProvisionalCode, so that they are never considered up-to-date. */
+			static constexpr char const*	_provisionalFileMarker = "//Kodgen provisional file, replaced once the source file has been parsed";
+
 			/** Array containing the generated code per location. ClassFooter value is not used since code is generated in _classFooterGeneratedCode. */
 			std::array<std::string, static_cast<size_t>(ECodeGenLocation::Count)>	_generatedCodePerLocation;
 
 			/** Map containing the class footer generated code for each struct/class. */
 			std::unordered_map<StructClassInfo const*, std::string>					_classFooterGeneratedCode;
+
+			/** Access specifier in effect where each class footer macro is used in _accessSpecifiersSourceFile, indexed by macro name. */
+			std::unordered_map<std::string, EAccessSpecifier>						_classFooterAccessSpecifiers;
+
+			/** Source file scanned to fill _classFooterAccessSpecifiers. */
+			fs::path																_accessSpecifiersSourceFile;
+
+			/** Last write time of _accessSpecifiersSourceFile when it was scanned. */
+			fs::file_time_type														_accessSpecifiersSourceFileLastWriteTime;
 			
 			//Make the addModule method taking a CodeGenModule private to replace it with a more restrictive method accepting MacroCodeGenModule only.
 			using CodeGenUnit::addModule;
@@ -51,6 +65,47 @@ namespace kodgen
 																		 CodeGenEnv&,
 																		 std::string&)>		generate)	noexcept;
 
+			/**
+			*	@brief Write the lines common to all generated headers (pragma and includes).
+			* 
+			*	@param generatedHeader The generated header to write to.
+			*/
+			void		writeHeaderFilePreamble(GeneratedFile& generatedHeader)					const	noexcept;
+
+			/**
+			*	@brief	Lexically scan a source file to find the footer macros it uses, without parsing it.
+			*			Collected macros are the header file footer macro and all identifiers matching the class footer macro pattern
+			*			(see MacroCodeGenUnitSettings::isClassFooterMacro).
+			* 
+			*	@param sourceFile		Path to the source file.
+			*	@param out_macroNames	Collection filled with the found macro names.
+			* 
+			*	@return true if the source file could be read, else false.
+			*/
+			bool		collectFooterMacroNames(fs::path const&			sourceFile,
+												std::set<std::string>&	out_macroNames)			const	noexcept;
+
+			/**
+			*	@brief	Lexically scan a source file to find the access specifier in effect where each class footer macro is used
+			*			(see MacroCodeGenEnv::getClassFooterAccessSpecifier).
+			* 
+			*	@param sourceFile			Path to the source file.
+			*	@param out_accessSpecifiers	Map filled with the access specifier of each found class footer macro.
+			* 
+			*	@return true if the source file could be read, else false.
+			*/
+			bool		collectClassFooterAccessSpecifiers(fs::path const&										sourceFile,
+														   std::unordered_map<std::string, EAccessSpecifier>&	out_accessSpecifiers)	const	noexcept;
+
+			/**
+			*	@brief Check whether a generated file was written by generateProvisionalCode (only its first line is read).
+			* 
+			*	@param generatedFile Path to the generated file.
+			* 
+			*	@return true if the generated file is a provisional file, else false.
+			*/
+			bool		isProvisionalFile(fs::path const& generatedFile)						const	noexcept;
+
 			/**
 			*	@brief	(Re)generate the header file.
 			* 
@@ -65,6 +120,14 @@ namespace kodgen
 			*/
 			void		generateSourceFile(MacroCodeGenEnv&	env)										noexcept;
 
+			/**
+			*	@brief	(Re)generate the C++20 module interface unit exporting the reflected entities of the parsed file,
+			*			if module interface units are enabled (see MacroCodeGenUnitSettings::getGeneratedModuleInterfaceFileName).
+			* 
+			*	@param env Generation environment.
+			*/
+			void		generateModuleInterfaceFile(MacroCodeGenEnv& env)								noexcept;
+
 			/**
 			*	@brief Compute the path of the header file generated from the provided source file.
 			* 
@@ -83,6 +146,15 @@ namespace kodgen
 			*/
 			fs::path	getGeneratedSourceFilePath(fs::path const& sourceFile)					const	noexcept;
 
+			/**
+			*	@brief Compute the path of the module interface unit generated from the provided source file.
+			* 
+			*	@param sourceFile Path to the source file.
+			* 
+			*	@return the path of the module interface unit generated from the provided source file, empty if module interface units are disabled.
+			*/
+			fs::path	getGeneratedModuleInterfaceFilePath(fs::path const& sourceFile)			const	noexcept;
+
 		protected:
 			/**
 			*	@brief	Instantiate a MacroCodeGenEnv object (using new).
@@ -149,6 +221,36 @@ namespace kodgen
 			*/
 			virtual bool				postGenerateCode(CodeGenEnv& env)										noexcept	override;
 
+			/**
+			*	@brief Macro code generation units support entity streaming.
+			* 
+			*	@return true.
+			*/
+			virtual bool				supportsEntityStreaming()										const	noexcept	override;
+
+			/**
+			*	@brief	Move the code generated for each location into the chunk code (indexed by ECodeGenLocation),
+			*			and the class footer code of each struct/class into the chunk entity code.
+			* 
+			*	@param out_chunk Chunk receiving the generated code.
+			*/
+			virtual void				takeGeneratedCode(GeneratedCodeChunk& out_chunk)						noexcept	override;
+
+			/**
+			*	@brief Append the code of a chunk filled by takeGeneratedCode to the code generated for each location and class footer.
+			* 
+			*	@param chunk Chunk containing the code to append.
+			*/
+			virtual void				appendGeneratedCode(GeneratedCodeChunk&& chunk)							noexcept	override;
+
+			/**
+			*	@brief	Compute the size of the code generated so far for the header file (all locations but SourceFileHeader,
+			*			and all class footers) and for the source file, in that order.
+			* 
+			*	@param out_sizes Vector filled with the generated header and source code sizes.
+			*/
+			virtual void				getGeneratedCodeSizes(std::vector<size_t>& out_sizes)			const	noexcept	override;
+
 		public:
 			/**
 			*	@brief	Check that both the generated header and source files are newer than the source file.
@@ -162,6 +264,36 @@ namespace kodgen
 			*/
 			virtual bool					isUpToDate(fs::path const& sourceFile)				const	noexcept	override;
 
+			/**
+			*	@brief	Explain why the generated header and source files are up-to-date or not.
+			*			If the generated header file doesn't exist, create it and leave it empty (see isUpToDate).
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return The explanation, referencing the missing or outdated generated file if any.
+			*/
+			virtual FileProcessingExplanation	explainIsUpToDate(fs::path const& sourceFile)	const	noexcept	override;
+
+			/**
+			*	@brief	Write a provisional generated header defining (empty) all footer macros found by a lexical scan of the source file,
+			*			and a minimal generated source file if it doesn't exist.
+			*			Nothing is written if the existing generated header already defines all found macros.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return true if the source file could be scanned, else false.
+			*/
+			virtual bool					generateProvisionalCode(fs::path const& sourceFile)	const	noexcept	override;
+
+			/**
+			*	@brief Get the paths to the header and source files generated for a given source file, in that order.
+			* 
+			*	@param sourceFile Path to the source file.
+			*
+			*	@return The paths to the generated header and source files.
+			*/
+			virtual std::vector<fs::path>	getGeneratedFilePaths(fs::path const& sourceFile)	const	noexcept	override;
+
 			/**
 			*	@brief	Add a module to the internal list of generation modules.
 			*			This method is a more restrictive replacement for the CodeGenUnit::addModule(CodeGenModule&) method.
@@ -49,6 +49,19 @@ namespace kodgen
 			*/
 			std::string		_generatedSourceFileNamePattern	= "##FILENAME##.src.h";
 
+			/**
+			*	Pattern to use to generate C++20 module interface units, exporting the reflected entities of each parsed file.
+			*	##FILENAME## will be replaced by the target file name.
+			*	Module interface units are not generated if the pattern is empty.
+			*/
+			std::string		_generatedModuleInterfaceFileNamePattern	= "";
+
+			/**
+			*	Pattern to use to name the generated modules.
+			*	##FILENAME## will be replaced by the target file name.
+			*/
+			std::string		_moduleNamePattern				= "kodgen.##FILENAME##";
+
 			/**
 			*	Pattern to use to generate class footer macro.
 			*	##CLASSNAME## and ##CLASSFULLNAME## will be replaced by the class name and full name respectively.
@@ -111,7 +124,7 @@ namespace kodgen
 											   ILogger*				logger)							noexcept	override;
 
 			/**
-			*	@brief Load the _generatedHeaderFileNamePattern and _generatedSourceFileNamePattern settings from toml.
+			*	@brief Load the _generatedHeaderFileNamePattern, _generatedSourceFileNamePattern and _generatedModuleInterfaceFileNamePattern settings from toml.
 			*
 			*	@param generationSettings	Toml content.
 			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
@@ -119,6 +132,15 @@ namespace kodgen
 			void			loadFileNamePatterns(toml::value const&	generationSettings,
 												 ILogger*			logger)							noexcept;
 
+			/**
+			*	@brief Load the module name pattern setting from toml.
+			*
+			*	@param generationSettings	Toml content.
+			*	@param logger				Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void			loadModuleNamePattern(toml::value const&	generationSettings,
+												  ILogger*				logger)						noexcept;
+
 			/**
 			*	@brief Load the class footer macro pattern setting from toml.
 			*
@@ -177,6 +199,20 @@ namespace kodgen
 			*/
 			void				setClassFooterMacroPattern(std::string const& classFooterMacroPattern)					noexcept;
 
+			/**
+			*	@brief Setter for _generatedModuleInterfaceFileNamePattern.
+			*	
+			*	@param generatedModuleInterfaceFileNamePattern Module interface unit file name pattern, empty to disable module interface units.
+			*/
+			void				setGeneratedModuleInterfaceFileNamePattern(std::string const& generatedModuleInterfaceFileNamePattern)	noexcept;
+
+			/**
+			*	@brief Setter for _moduleNamePattern.
+			*	
+			*	@param moduleNamePattern Module name pattern.
+			*/
+			void				setModuleNamePattern(std::string const& moduleNamePattern)								noexcept;
+
 			/**
 			*	@brief Setter for _headerFileFooterMacroPattern.
 			*
@@ -232,6 +268,41 @@ namespace kodgen
 			*/
 			fs::path			getGeneratedSourceFileName(fs::path const& targetFile)							const	noexcept;
 
+			/**
+			*	@brief Getter for _generatedModuleInterfaceFileNamePattern.
+			*
+			*	@return _generatedModuleInterfaceFileNamePattern.
+			*/
+			std::string const&	getGeneratedModuleInterfaceFileNamePattern()									const	noexcept;
+
+			/**
+			*	@brief Get the module interface unit file name generated for the given file.
+			*			This actually returns the module interface unit file name pattern by replacing all ##FILENAME## instances by the actual file name.
+			* 
+			*	@param targetFile Full path to the target file.
+			* 
+			*	@return The generated module interface unit file name (not full path, only file name + extension), empty if module interface units are disabled.
+			*/
+			fs::path			getGeneratedModuleInterfaceFileName(fs::path const& targetFile)					const	noexcept;
+
+			/**
+			*	@brief Getter for _moduleNamePattern.
+			*
+			*	@return _moduleNamePattern.
+			*/
+			std::string const&	getModuleNamePattern()															const	noexcept;
+
+			/**
+			*	@brief Get the name of the module generated for the given file.
+			*			This actually returns the module name pattern by replacing all ##FILENAME## instances by the actual file name.
+			*			Each dot-separated part of the name is sanitized to be a valid identifier.
+			* 
+			*	@param targetFile Full path to the target file.
+			* 
+			*	@return The generated module name.
+			*/
+			virtual std::string	getModuleName(fs::path const& targetFile)										const	noexcept;
+
 			/**
 			*	@brief Getter for _classFooterMacroPattern.
 			*
@@ -249,6 +320,16 @@ namespace kodgen
 			*/
 			virtual std::string	getClassFooterMacro(StructClassInfo const& structClassInfo)						const	noexcept;
 
+			/**
+			*	@brief	Check whether an identifier could be a class footer macro, without knowing the class.
+			*			The identifier must contain the parts of the pattern located before the first tag and after the last tag.
+			* 
+			*	@param identifier The identifier to check.
+			* 
+			*	@return true if the identifier matches the class footer macro pattern, else false.
+			*/
+			virtual bool		isClassFooterMacro(std::string const& identifier)								const	noexcept;
+
 			/**
 			*	@brief Getter for _headerFileFooterMacroPattern.
 			*
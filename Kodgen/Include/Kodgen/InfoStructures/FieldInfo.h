@@ -22,12 +22,16 @@ namespace kodgen
 			/** Is this field mutable qualified? */
 			bool							isMutable : 1;
 
+			/** Is this field a bit-field? Bit-fields can't be referred to by pointers (nor member pointers). */
+			bool							isBitField : 1;
+
 			/** Access of this field in its outer struct/class. */
 			EAccessSpecifier				accessSpecifier;
 
 			/** Memory offset in bytes. */
 			int64							memoryOffset;
 
+			FieldInfo()										= default;
 			FieldInfo(CXCursor const&			cursor,
 					  std::vector<Property>&&	propertyGroup)	noexcept;
 	};
@@ -51,6 +51,7 @@ namespace kodgen
 			/** Is this function static or not. */
 			bool isStatic	: 1;
 
+			FunctionInfo()									= default;
 			FunctionInfo(CXCursor const&			cursor,
 						 std::vector<Property>&&	properties)	noexcept;
 
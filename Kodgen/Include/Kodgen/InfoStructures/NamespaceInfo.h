@@ -42,6 +42,7 @@ namespace kodgen
 			/** Nested variables. */
 			std::vector<VariableInfo>		variables;
 
+			NamespaceInfo()									= default;
 			NamespaceInfo(CXCursor const&			cursor,
 						  std::vector<Property>&&	properties)	noexcept;
 
@@ -42,6 +42,7 @@ namespace kodgen
 			*/
 			std::string					name;
 
+			TemplateParamInfo()					= default;
 			TemplateParamInfo(CXCursor cursor)	noexcept;
 	};
 }
\ No newline at end of file
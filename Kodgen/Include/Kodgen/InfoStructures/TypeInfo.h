@@ -20,6 +20,8 @@ namespace kodgen
 {
 	class TypeInfo
 	{
+		friend class ParsingResultSnapshot;
+
 		private:
 			/** Internal keywords used for type splitting. */
 			static constexpr char const*	_classQualifier		= "class ";
@@ -128,6 +130,9 @@ namespace kodgen
 			/** Size of this type in bytes. */
 			size_t					sizeInBytes			= 0u;
 
+			/** Alignment requirement of this type in bytes, 0 if it could not be computed. */
+			size_t					alignment			= 0u;
+
 			TypeInfo()					= default;
 			TypeInfo(CXType cursorType)	noexcept;
 			TypeInfo(CXCursor cursor)	noexcept;
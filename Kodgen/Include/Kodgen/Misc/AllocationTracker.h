@@ -0,0 +1,127 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+#include "Kodgen/Misc/EAllocationStage.h"
+
+//Set by the KODGEN_ALLOCATION_TRACKING CMake option
+#ifndef KODGEN_ALLOCATION_TRACKING
+#define KODGEN_ALLOCATION_TRACKING 0
+#endif
+
+namespace kodgen
+{
+	struct AllocationStats
+	{
+		/** Number of allocations. */
+		uint64	allocationCount	= 0u;
+
+		/** Total number of allocated bytes. */
+		uint64	allocatedBytes	= 0u;
+	};
+
+	class AllocationReport
+	{
+		public:
+			/** Allocation stats of each stage, indexed by EAllocationStage. */
+			std::array<AllocationStats, static_cast<size_t>(EAllocationStage::Count)>	stages;
+
+			/**
+			*	@brief Get the allocations made since a previous report.
+			*
+			*	@param previousReport Report taken earlier.
+			*
+			*	@return A report containing the difference between this report and previousReport.
+			*/
+			AllocationReport	since(AllocationReport const& previousReport)	const	noexcept;
+
+			/**
+			*	@brief Check whether the report contains any allocation.
+			*
+			*	@return true if no allocation is recorded in any stage, else false.
+			*/
+			bool				isEmpty()										const	noexcept;
+
+			/**
+			*	@brief Get a human readable representation of the report, one line per stage containing allocations.
+			*
+			*	@return The report as a string.
+			*/
+			std::string			toString()										const	noexcept;
+	};
+
+	/**
+	*	Count the allocations made through the global operator new, per pipeline stage.
+	*
+	*	The stage of the running thread is set with AllocationStageScope.
+	*	Allocations are only counted if the library is built with the KODGEN_ALLOCATION_TRACKING CMake option,
+	*	which replaces the global operator new of the program linking Kodgen.
+	*	Allocations made by libclang are counted as long as it uses the program global operator new (not on Windows).
+	*/
+	class AllocationTracker
+	{
+		private:
+			/** Stage the allocations of the running thread are accounted to. */
+			static thread_local EAllocationStage	_currentStage;
+
+		public:
+			AllocationTracker()		= delete;
+			~AllocationTracker()	= delete;
+
+			/**
+			*	@brief Account an allocation to the stage of the running thread.
+			*
+			*	@param size Size of the allocation in bytes.
+			*/
+			static void				recordAllocation(size_t size)				noexcept;
+
+			/**
+			*	@brief Set the stage of the running thread.
+			*
+			*	@param stage The new stage.
+			*
+			*	@return The previous stage of the running thread.
+			*/
+			static EAllocationStage	setCurrentStage(EAllocationStage stage)		noexcept;
+
+			/**
+			*	@brief Get the allocations made by all threads since the program started.
+			*
+			*	@return The allocation report, empty if allocation tracking is disabled.
+			*/
+			static AllocationReport	getReport()									noexcept;
+	};
+
+	/**
+	*	Account all allocations made by the running thread during the lifetime of this object to a stage.
+	*	Compiles to nothing if allocation tracking is disabled.
+	*/
+	class AllocationStageScope
+	{
+		private:
+#if KODGEN_ALLOCATION_TRACKING
+			/** Stage restored when this scope is destroyed. */
+			EAllocationStage	_previousStage;
+#endif
+
+		public:
+			explicit AllocationStageScope(EAllocationStage stage)	noexcept;
+			AllocationStageScope(AllocationStageScope const&)		= delete;
+			AllocationStageScope(AllocationStageScope&&)			= delete;
+			~AllocationStageScope()									noexcept;
+
+			AllocationStageScope& operator=(AllocationStageScope const&)	= delete;
+			AllocationStageScope& operator=(AllocationStageScope&&)			= delete;
+	};
+
+	#include "Kodgen/Misc/AllocationTracker.inl"
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#if KODGEN_ALLOCATION_TRACKING
+
+inline AllocationStageScope::AllocationStageScope(EAllocationStage stage) noexcept:
+	_previousStage{AllocationTracker::setCurrentStage(stage)}
+{
+}
+
+inline AllocationStageScope::~AllocationStageScope() noexcept
+{
+	AllocationTracker::setCurrentStage(_previousStage);
+}
+
+#else
+
+inline AllocationStageScope::AllocationStageScope(EAllocationStage /* stage */) noexcept
+{
+}
+
+inline AllocationStageScope::~AllocationStageScope() noexcept
+{
+}
+
+#endif
\ No newline at end of file
@@ -65,6 +65,17 @@ namespace kodgen
 			static fs::path					getvswherePath()											noexcept;
 #endif
 
+			/**
+			*	@brief Launch the provided compiler to retrieve its native include directories, without using the cache.
+			*
+			*	@param normalizedCompilerExeName Normalized name of the compiler executable.
+			*	
+			*	@return A vector containing all native include directories for the provided compiler.
+			*
+			*	@exception std::runtime_error is thrown if the compiler has a valid name but include directories could not be queried on the executing computer.
+			*/
+			static std::vector<fs::path>	probeCompilerNativeIncludeDirectories(std::string const& normalizedCompilerExeName);
+
 			/**
 			*	@brief Normalize the provided compiler name (lower case).
 			*	
@@ -110,7 +121,8 @@ namespace kodgen
 			static bool						isGCC(std::string const& normalizedCompilerExeName)					noexcept;
 
 			/**
-			*	@brief Retrieve all native include directories of a given compiler on the executing computer.
+			*	@brief	Retrieve all native include directories of a given compiler on the executing computer.
+			*			Results are cached for the whole process lifetime, so each compiler is only launched once.
 			*
 			*	@param compiler Compiler we are looking the include directories of.
 			*	
@@ -0,0 +1,47 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	Pipeline stages allocations are accounted to (see AllocationTracker).
+	*/
+	enum class EAllocationStage : uint8
+	{
+		/** Allocations made outside of any tagged stage. */
+		Untagged = 0u,
+
+		/** Identification of the files to process. */
+		Discovery,
+
+		/** Translation unit parsing done by libclang. */
+		ClangParsing,
+
+		/** Cursors traversal and InfoStructures construction. */
+		EntityParsing,
+
+		/** Parsing of the properties attached to entities. */
+		PropertyParsing,
+
+		/** Code generation from the parsing results. */
+		Generation,
+
+		/** Writing of the generated code to the generated files. */
+		FileWriting,
+
+		/** Number of stages, not a valid stage. */
+		Count
+	};
+
+	std::string toString(EAllocationStage stage) noexcept;
+}
\ No newline at end of file
@@ -18,6 +18,7 @@
 #endif
 
 #include <functional>
+#include <string>
 
 namespace kodgen
 {
@@ -64,5 +65,18 @@ namespace kodgen
 			*/
 			static bool		isChildPath(fs::path const& child,
 										fs::path const& other)			noexcept;
+
+			/**
+			*	@brief	Check that a path matches a glob pattern, using / as separator.
+			*			* and ? match any characters except /, ** matches any characters including /.
+			*			Relative patterns can match at any directory level (as if they started with ** /).
+			*
+			*	@param path		Path to check.
+			*	@param pattern	Glob pattern.
+			*	
+			*	@return true if path matches the pattern, else false.
+			*/
+			static bool		matchesGlob(fs::path const&		path,
+										std::string const&	pattern)	noexcept;
 	};
 }
\ No newline at end of file
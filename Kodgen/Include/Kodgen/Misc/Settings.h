@@ -18,6 +18,18 @@ namespace kodgen
 	class Settings
 	{
 		protected:
+			/** Directory of the settings file being loaded by loadFromFile, empty when the settings are not loaded from a file. */
+			fs::path	_settingsFileDirectory;
+
+			/**
+			*	@brief Resolve a path read from the settings file.
+			*
+			*	@param path Path read from the settings file.
+			*
+			*	@return The path relative to the settings file directory if it is relative and the settings are loaded from a file, else path.
+			*/
+			fs::path		resolveSettingsPath(fs::path const& path)	const	noexcept;
+
 			/**
 			*	@brief Load all settings from the provided toml data.
 			* 
@@ -25,5 +25,15 @@ namespace kodgen
 			*	@return The result of the given command.
 			*/
 			static std::string executeCommand(std::string const& cmd);
+
+			/**
+			*	@brief Set an environment variable of the running process.
+			*	
+			*	@param name		Name of the variable.
+			*	@param value	Value of the variable.
+			*	
+			*	@return true if the variable was set, else false.
+			*/
+			static bool setEnvironmentVariable(std::string const& name, std::string const& value) noexcept;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	/**
+	*	How much work libclang does when parsing a file (see ParseProfile).
+	*/
+	enum class EParseMode : uint8
+	{
+		/**
+		*	The file and all its includes are parsed.
+		*	All entity information is available, including type sizes and field offsets.
+		*/
+		Full = 0u,
+
+		/**
+		*	Only the file itself is parsed, #include directives are skipped.
+		*	Entity names and properties are available, but types declared in other files are incomplete
+		*	(no size, no offset, unresolved canonical names), and clang errors are not reported.
+		*	Generated macros must be placed at the end of their scope since clang doesn't see their definition.
+		*/
+		Shallow
+	};
+
+	std::string toString(EParseMode parseMode) noexcept;
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <vector>
 #include <set>
 #include <memory>	//std::shared_ptr
+#include <functional>	//std::function
 
 #include <clang-c/Index.h>
 
@@ -24,12 +25,18 @@
 
 namespace kodgen
 {
+	//Forward declaration
+	class GeneratedFilePack;
+
 	class FileParser : public NamespaceParser
 	{
 		private:
 			/** Index used internally by libclang to process a translation unit. */
 			CXIndex								_clangIndex;
 
+			/** Global options of _clangIndex, only updated when ParsingSettings::shouldUseClangBackgroundPriority changes. */
+			uint32								_clangIndexGlobalOptions	= CXGlobalOpt_None;
+
 			/** Property parser used to parse properties of all entities. */
 			PropertyParser						_propertyParser;		
 
@@ -49,6 +56,52 @@ namespace kodgen
 														  CXCursor		parentCursor,
 														  CXClientData	clientData)						noexcept;
 
+			/**
+			*	@brief	Find the top-level declarations of the main file of a translation unit from the tokens of the main file,
+			*			so that the declarations of included headers are never visited.
+			*
+			*	@param translationUnit	The translation unit.
+			*	@param rootCursor		Translation unit cursor.
+			*
+			*	@return The top-level declarations of the main file, in the order they are visited by clang_visitChildren.
+			*/
+			static std::vector<CXCursor>	getMainFileTopLevelCursors(CXTranslationUnit const&	translationUnit,
+																	   CXCursor const&			rootCursor)		noexcept;
+
+			/**
+			*	@brief	Reserve enough space in the namespaces, structs, classes and enums of the result for all top-level entities of the file,
+			*			so that entities handed to topLevelEntityListener stay at the same address until the end of the parsing.
+			*
+			*	@param rootCursor		Translation unit cursor.
+			*	@param mainFileCursors	Top-level declarations of the main file, or nullptr to visit all the top-level declarations of the translation unit.
+			*	@param out_result		Result to reserve space in.
+			*/
+			static void					reserveTopLevelEntities(CXCursor const&					rootCursor,
+																std::vector<CXCursor> const*	mainFileCursors,
+																FileParsingResult&				out_result)			noexcept;
+
+			/**
+			*	@brief	Parse all the top-level entities of the main file of a translation unit and add them to the current context result.
+			*			Top-level declarations are found with getMainFileTopLevelCursors if ParsingSettings::shouldVisitMainFileOnly is set.
+			*
+			*	@param translationUnit	The translation unit.
+			*	@param rootCursor		Translation unit cursor.
+			*	@param out_result		Result to fill.
+			*
+			*	@return false if the parsing was aborted, else true.
+			*/
+			bool						parseTopLevelEntities(CXTranslationUnit const&	translationUnit,
+															  CXCursor const&			rootCursor,
+															  FileParsingResult&		out_result)				noexcept;
+
+			/**
+			*	@brief Refresh the outer entities of a top-level entity which has just been added, and hand it to topLevelEntityListener if any.
+			*
+			*	@param entity The added entity.
+			*/
+			template <typename EntityType>
+			void						notifyTopLevelEntity(EntityType& entity)						noexcept;
+
 			/**
 			*	@brief Push a new clean context to prepare translation unit parsing.
 			*
@@ -141,6 +194,21 @@ namespace kodgen
 				const kodgen::MacroCodeGenUnitSettings* codeGenSettings,
 				std::set<std::string>& notFoundGeneratedMacroNames) const	noexcept;
 
+			/**
+			*	@brief Parse a file with libclang.
+			*
+			*	@param toParseFile		Path to the file to parse.
+			*	@param profile			Parse profile used by the file. Can be nullptr.
+			*	@param isPreParsing		Should the file be parsed with the pre-parsing compilation arguments?
+			*	@param out_errorMessage	Error message describing the libclang error code if the translation unit could not be created.
+			*
+			*	@return The parsed translation unit, or nullptr if it could not be created.
+			*/
+			CXTranslationUnit			parseTranslationUnit(fs::path const&		toParseFile,
+															 ParseProfile const*	profile,
+															 bool					isPreParsing,
+															 std::string&			out_errorMessage)	noexcept;
+
 			/**
 			*	@brief Helper to get the ParsingResult contained in the context as a FileParsingResult.
 			*
@@ -169,6 +237,19 @@ namespace kodgen
 			/** Logger used to issue logs from the FileParser. Can be nullptr. */
 			ILogger*			logger	= nullptr;
 
+			/**
+			*	If set, called each time a top-level namespace, struct/class or enum of the parsed file has been completely parsed.
+			*	The entity outer entities are up-to-date, and the entity stays at the same address in the FileParsingResult
+			*	(and when the FileParsingResult is moved), so it can be processed while the remaining of the file is parsed.
+			*/
+			std::function<void(EntityInfo const&)>	topLevelEntityListener;
+
+			/**
+			*	If set, the packed generated files are provided to libclang as unsaved files,
+			*	since they are not written to the output directory (see CodeGenUnitSettings::shouldPackGeneratedFiles).
+			*/
+			GeneratedFilePack const*				generatedFilePack = nullptr;
+
 			FileParser()					noexcept;
 			FileParser(FileParser const&)	noexcept;
 			FileParser(FileParser&&)		noexcept;
@@ -16,4 +16,15 @@ inline ParsingSettings& FileParser::getSettings() noexcept
 	assert(_settings.use_count() != 0);
 
 	return *_settings;
+}
+
+template <typename EntityType>
+void FileParser::notifyTopLevelEntity(EntityType& entity) noexcept
+{
+	if (topLevelEntityListener)
+	{
+		entity.refreshOuterEntity();
+
+		topLevelEntityListener(entity);
+	}
 }
\ No newline at end of file
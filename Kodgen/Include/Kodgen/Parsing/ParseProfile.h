@@ -0,0 +1,57 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kodgen/Parsing/EParseMode.h"
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Parsing options applied to the files matching a set of glob patterns, on top of the ParsingSettings.
+	*/
+	struct ParseProfile
+	{
+		/** Name of the profile, used in logs. */
+		std::string					name;
+
+		/** Glob patterns of the files using this profile (see FilesystemHelpers::matchesGlob). */
+		std::vector<std::string>	patterns;
+
+		/** Parse mode used for the matching files. */
+		EParseMode					parseMode = EParseMode::Full;
+
+		/** Arguments appended to the ParsingSettings compilation arguments, one argument per entry. */
+		std::vector<std::string>	additionalClangArguments;
+
+		/**
+		*	Include directories searched before the project include directories.
+		*	Used to shadow expensive headers with lightweight stubs declaring only what the parsed files need.
+		*	Relative directories loaded from a settings file are relative to the settings file.
+		*/
+		std::vector<fs::path>		stubIncludeDirectories;
+
+		/**
+		*	Precompiled header (built by clang with -emit-pch) loaded before parsing the matching files. Unused if empty.
+		*	A relative path loaded from a settings file is relative to the settings file.
+		*/
+		fs::path					precompiledHeader;
+
+		/**
+		*	@brief Check whether a file uses this profile.
+		*
+		*	@param file Path to the file.
+		*
+		*	@return true if the file matches any of the profile patterns, else false.
+		*/
+		bool	matches(fs::path const& file)	const	noexcept;
+	};
+}
\ No newline at end of file
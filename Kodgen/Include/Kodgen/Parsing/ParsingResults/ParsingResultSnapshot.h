@@ -0,0 +1,95 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include "Kodgen/Parsing/ParsingResults/FileParsingResult.h"
+#include "Kodgen/Misc/Filesystem.h"
+
+namespace kodgen
+{
+	/**
+	*	Collection of FileParsingResults serialized in memory, which can be saved to and loaded from disk.
+	*
+	*	A snapshot recorded during a run (see CodeGenManager::parsingResultsRecorder) can be replayed later without
+	*	libclang (see CodeGenManager::replay), so that the code generation can be benchmarked in isolation.
+	*	The binary format depends on the machine endianness, snapshots are meant to be replayed on the machine which recorded them.
+	*/
+	class ParsingResultSnapshot
+	{
+		private:
+			class Writer;
+			class Reader;
+
+			/** First bytes of a snapshot file, used to detect outdated formats. */
+			static constexpr char const*	_fileHeader	= "KodgenParsingResultSnapshot 2\n";
+
+			/** Serialized results, each one prefixed by its size. */
+			std::string			_data;
+
+			/** Offset of each serialized result in _data. */
+			std::vector<size_t>	_resultOffsets;
+
+			/** Mutex used to add results from several threads. */
+			std::mutex			_mutex;
+
+		public:
+			/**
+			*	@brief	Serialize a parsing result and add it to the snapshot.
+			*			This method is thread-safe.
+			*
+			*	@param parsingResult The parsing result to add.
+			*/
+			void	add(FileParsingResult const& parsingResult)						noexcept;
+
+			/**
+			*	@brief Deserialize a parsing result of the snapshot.
+			*
+			*	@param index		Index of the result, in the order results were added.
+			*	@param out_result	Deserialized result. Must be empty.
+			*
+			*	@return true if the result was successfully deserialized, else false.
+			*/
+			bool	getResult(size_t				index,
+							  FileParsingResult&	out_result)				const	noexcept;
+
+			/**
+			*	@brief Get the number of results contained in the snapshot.
+			*
+			*	@return The number of results.
+			*/
+			size_t	getResultCount()										const	noexcept;
+
+			/**
+			*	@brief Remove all results from the snapshot.
+			*/
+			void	clear()															noexcept;
+
+			/**
+			*	@brief Write the snapshot to a file.
+			*
+			*	@param path Path to the written file.
+			*
+			*	@return true if the file was successfully written, else false.
+			*/
+			bool	save(fs::path const& path)								const	noexcept;
+
+			/**
+			*	@brief	Replace the snapshot content by the content of a file written by save.
+			*			The snapshot is left empty if the file can't be read.
+			*
+			*	@param path Path to the file.
+			*
+			*	@return true if the file was successfully loaded, else false.
+			*/
+			bool	load(fs::path const& path)										noexcept;
+	};
+}
\ No newline at end of file
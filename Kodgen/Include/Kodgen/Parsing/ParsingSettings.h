@@ -11,6 +11,7 @@
 #include <string>
 
 #include "Kodgen/Properties/PropertyParsingSettings.h"
+#include "Kodgen/Parsing/ParseProfile.h"
 #include "Kodgen/Misc/Settings.h"
 #include "Kodgen/Misc/Filesystem.h"
 #include "Kodgen/Misc/Optional.h"
@@ -21,6 +22,15 @@ namespace kodgen
 	class ParsingSettings : public Settings
 	{
 		private:
+			struct ProfileCompilationArguments
+			{
+				/** Arguments specific to the profile, referenced by the argument lists. */
+				std::vector<std::string>	ownedArguments;
+
+				std::vector<char const*>	compilationArguments;
+				std::vector<char const*>	preParsingCompilationArguments;
+			};
+
 			/** Section name used in the toml file for FileGenerator settings. */
 			static constexpr char const*			_tomlSectionName				= "ParsingSettings";
 
@@ -40,6 +50,9 @@ namespace kodgen
 
 			std::string                             _additionalClangArguments;
 
+			/** _additionalClangArguments split into individual arguments. */
+			std::vector<std::string>				_additionalClangArgumentList;
+
 			/** Variables used to build compilation command line. */
 			std::string								_kodgenParsingMacro			= "-D" + parsingMacro;
 			std::string								_cppVersionCommandLine;
@@ -55,8 +68,16 @@ namespace kodgen
 			std::string								_enumPropertyMacro;
 			std::string								_enumValuePropertyMacro;
 
+			std::string								_errorLimitCommandLine;
+
 			std::vector<char const*>				_compilationArguments;
 
+			/** Same arguments as _compilationArguments, without any error limit. */
+			std::vector<char const*>				_preParsingCompilationArguments;
+
+			/** Compilation arguments of each parse profile, in the same order as parseProfiles. */
+			std::vector<ProfileCompilationArguments>	_parseProfilesCompilationArguments;
+
 			/**
 			*	@brief Try to convert an integer to a ECppVersion enum value.
 			* 
@@ -74,7 +95,8 @@ namespace kodgen
 			void	refreshBuildCommandStrings(ILogger* logger)								noexcept;
 
 			/**
-			*	@brief Make a list of all arguments to pass to the compilation command and store it in _compilationArguments.
+			*	@brief	Make a list of all arguments to pass to the compilation command and store it in _compilationArguments.
+			*			_preParsingCompilationArguments and the parse profiles arguments are refreshed as well.
 			* 
 			*	@param logger Optional logger used to issue logs in case of error. Can be nullptr.
 			*/
@@ -107,6 +129,15 @@ namespace kodgen
 			void	loadShouldLogDiagnostic(toml::value const&	parsingSettings,
 											ILogger*			logger)						noexcept;
 
+			/**
+			*	@brief Load the shouldVisitMainFileOnly setting from toml.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadShouldVisitMainFileOnly(toml::value const&	parsingSettings,
+												ILogger*			logger)					noexcept;
+
 			/**
 			*	@brief Load the shouldAbortParsingOnFirstError setting from toml.
 			*
@@ -143,6 +174,42 @@ namespace kodgen
 			void	loadShouldFailCodeGenerationOnClangErrors(toml::value const&	parsingSettings,
 															  ILogger*				logger)	noexcept;
 
+			/**
+			*	@brief Load the clangErrorLimit setting from toml.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadClangErrorLimit(toml::value const&	parsingSettings,
+										ILogger*			logger)							noexcept;
+
+			/**
+			*	@brief	Load all libclang execution settings from toml:
+			*			shouldUseClangCrashRecovery, shouldRunClangOnCallingThread and shouldUseClangBackgroundPriority.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadClangExecutionSettings(toml::value const&	parsingSettings,
+											   ILogger*				logger)					noexcept;
+
+			/**
+			*	@brief	Apply the process-wide libclang execution settings.
+			*
+			*	@param logger Optional logger used to issue logs in case of error. Can be nullptr.
+			*/
+			void	applyClangExecutionSettings(ILogger* logger)							const	noexcept;
+
+			/**
+			*	@brief	Load the parseProfiles setting from toml.
+			*			Loaded profiles completely replace previous parseProfiles if any.
+			*
+			*	@param parsingSettings	Toml content.
+			*	@param logger			Optional logger used to issue loading logs. Can be nullptr.
+			*/
+			void	loadParseProfiles(toml::value const&	parsingSettings,
+									  ILogger*				logger)							noexcept;
+
 			/**
 			*	@brief	Load the _projectIncludeDirectories setting from toml.
 			*			Loaded directories completely replace previous _projectIncludeDirectories if any.
@@ -207,13 +274,68 @@ namespace kodgen
 			*/
 			bool									shouldLogDiagnostic				= false;
 
+			/**
+			*	Should the top-level entities of a parsed file be found from the tokens of the file instead of visiting
+			*	all the top-level declarations of its translation unit, including the ones of every included header?
+			*	Top-level traversal then scales with the size of the parsed file rather than with the size of the translation unit.
+			*/
+			bool									shouldVisitMainFileOnly			= false;
+
 			/**
 			*	Whether to fail code generation on any parsing errors or not.
 			*/
 			bool									shouldFailCodeGenerationOnClangErrors = false;
 
+			/**
+			*	Maximum number of errors clang reports for a parsed file before it stops (-ferror-limit). 0 means no limit.
+			*	The pre-parsing step always runs without limit since it must find all missing generated macros.
+			*/
+			uint32									clangErrorLimit					= 20u;
+
+			/**
+			*	Should libclang recover from crashes happening during parsing?
+			*	Disabling it saves the crash recovery setup of each parse, but a crash in libclang then terminates the whole process.
+			*	This setting is process-wide: it is applied when the settings are initialized.
+			*/
+			bool									shouldUseClangCrashRecovery		= true;
+
+			/**
+			*	Should libclang parse files directly on the calling thread (LIBCLANG_NOTHREADS)?
+			*	By default, libclang spawns and joins a thread with an 8MB stack for every parse, which this setting avoids.
+			*	The parse then runs on the ThreadPool worker stack, so make sure it is large enough for deeply nested code.
+			*	This setting is process-wide: LIBCLANG_NOTHREADS is set the first time settings enabling it are initialized,
+			*	then it applies to all parsers of the process (including the ones whose settings disable it) and is never unset.
+			*	If LIBCLANG_NOTHREADS is already set in the environment, it is left untouched.
+			*/
+			bool									shouldRunClangOnCallingThread	= false;
+
+			/**
+			*	Should libclang run its parsing threads with a background priority?
+			*	Useful to keep the machine responsive when the code generation runs alongside other tasks.
+			*/
+			bool									shouldUseClangBackgroundPriority = false;
+
+			/**
+			*	Parsing options of specific files. A file uses the first profile it matches,
+			*	or the parsing settings alone if it doesn't match any profile.
+			*	Must be set before the settings are initialized.
+			*/
+			std::vector<ParseProfile>				parseProfiles;
+
 			virtual ~ParsingSettings() = default;
 
+			/**
+			*	@brief	Split a command line into individual arguments.
+			*			Arguments are separated by whitespaces, and can be quoted with " or ' to contain whitespaces.
+			*			A backslash escapes a following quote or whitespace (only \" inside double quotes, nothing inside single quotes),
+			*			other backslashes are kept so that Windows paths don't need to be escaped.
+			* 
+			*	@param commandLine The command line to split.
+			* 
+			*	@return The list of arguments, without quotes.
+			*/
+			static std::vector<std::string>		splitArguments(std::string const& commandLine)	noexcept;
+
 			/**
 			*	@brief	Initialize the build command forwarded to libclang to parse C++ files using
 			*			the current settings.
@@ -266,6 +388,40 @@ namespace kodgen
 			*/
 			std::vector<char const*> const&					getCompilationArguments()							const	noexcept;
 
+			/**
+			*	@brief Getter for _preParsingCompilationArguments.
+			* 
+			*	@return _preParsingCompilationArguments field.
+			*/
+			std::vector<char const*> const&					getPreParsingCompilationArguments()					const	noexcept;
+
+			/**
+			*	@brief Get the parse profile used by a file.
+			* 
+			*	@param file Path to the file.
+			* 
+			*	@return The first profile of parseProfiles matching the file, or nullptr if none matches.
+			*/
+			ParseProfile const*								findParseProfile(fs::path const& file)				const	noexcept;
+
+			/**
+			*	@brief Get the compilation arguments used to parse files with a given parse profile.
+			* 
+			*	@param profile Parse profile returned by findParseProfile. Can be nullptr.
+			* 
+			*	@return The compilation arguments of the profile, or _compilationArguments if profile is nullptr.
+			*/
+			std::vector<char const*> const&					getCompilationArguments(ParseProfile const* profile)			const	noexcept;
+
+			/**
+			*	@brief Get the compilation arguments used to pre-parse files with a given parse profile.
+			* 
+			*	@param profile Parse profile returned by findParseProfile. Can be nullptr.
+			* 
+			*	@return The pre-parsing compilation arguments of the profile, or _preParsingCompilationArguments if profile is nullptr.
+			*/
+			std::vector<char const*> const&					getPreParsingCompilationArguments(ParseProfile const* profile)	const	noexcept;
+
 			/**
 			*	@brief	Setter for _compilerExeName field.
 			*			This will also check that the compiler is indeed available on the running computer.
@@ -0,0 +1,264 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include "Kodgen/Threading/Coroutine.h"
+
+#if KODGEN_COROUTINES
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <utility>		//std::exchange
+#include <exception>	//std::terminate
+#include <type_traits>	//std::conditional_t, std::enable_if_t
+#include <cassert>
+
+#include "Kodgen/Misc/Optional.h"
+
+namespace kodgen
+{
+	//Forward declaration
+	template <typename ResultType>
+	class AsyncTask;
+
+	/**
+	*	Base of the promise of all AsyncTask coroutines.
+	*/
+	class AsyncTaskPromiseBase
+	{
+		private:
+			/** Awaiter resuming the coroutine which awaited the task, if any, when the task completes. */
+			class FinalAwaiter
+			{
+				public:
+					bool	await_ready()	const	noexcept;
+					void	await_resume()	const	noexcept;
+
+					template <typename PromiseType>
+					std::coroutine_handle<>	await_suspend(std::coroutine_handle<PromiseType> coroutine) noexcept;
+			};
+
+		public:
+			/** Coroutine awaiting the task. */
+			std::coroutine_handle<>	continuation;
+
+			std::suspend_always	initial_suspend()		const	noexcept;
+			FinalAwaiter		final_suspend()			const	noexcept;
+			void				unhandled_exception()	const	noexcept;
+	};
+
+	/**
+	*	Promise of AsyncTask coroutines returning a value.
+	*/
+	template <typename ResultType>
+	class AsyncTaskPromise : public AsyncTaskPromiseBase
+	{
+		public:
+			/** Value returned by the coroutine. */
+			opt::optional<ResultType>	result;
+
+			AsyncTask<ResultType>	get_return_object()						noexcept;
+
+			template <typename ValueType>
+			void					return_value(ValueType&& value)			noexcept;
+	};
+
+	/**
+	*	Promise of AsyncTask coroutines returning nothing.
+	*/
+	template <>
+	class AsyncTaskPromise<void> : public AsyncTaskPromiseBase
+	{
+		public:
+			AsyncTask<void>	get_return_object()	noexcept;
+			void			return_void()		const	noexcept;
+	};
+
+	/**
+	*	C++20 coroutine running on a ThreadPool, available if the including code is compiled as C++20 (see KODGEN_COROUTINES).
+	*	The coroutine is lazily started by the first co_await (or AsyncTaskHelper::syncWait) and runs on the awaiting thread
+	*	until it awaits ThreadPool::schedule, which resumes it on a worker. A pipeline can then be written as a straight-line
+	*	coroutine suspending on its dependencies instead of blocking a worker:
+	*
+	*		AsyncTask<bool> processFile(ThreadPool& pool, fs::path file)
+	*		{
+	*			co_await pool.schedule("Parsing " + file.string());
+	*			FileParsingResult result = parse(file);
+	*			co_return co_await generate(pool, std::move(result));
+	*		}
+	*
+	*	The result of a task is moved out when it is awaited, so a task must only be awaited once.
+	*/
+	template <typename ResultType = void>
+	class AsyncTask
+	{
+		friend AsyncTaskPromise<ResultType>;
+
+		public:
+			using promise_type = AsyncTaskPromise<ResultType>;
+
+		private:
+			/** Awaiter starting the task and resuming the awaiting coroutine when the task completes. */
+			class Awaiter
+			{
+				private:
+					/** Awaited coroutine. */
+					std::coroutine_handle<promise_type>	_coroutine;
+
+				public:
+					Awaiter(std::coroutine_handle<promise_type> coroutine)				noexcept;
+
+					bool					await_ready()						const	noexcept;
+					std::coroutine_handle<>	await_suspend(std::coroutine_handle<> awaitingCoroutine)	noexcept;
+					ResultType				await_resume()								noexcept;
+			};
+
+			/** Coroutine owned by this task. */
+			std::coroutine_handle<promise_type>	_coroutine;
+
+			AsyncTask(std::coroutine_handle<promise_type> coroutine)		noexcept;
+
+		public:
+			AsyncTask()														= default;
+			AsyncTask(AsyncTask const&)										= delete;
+			AsyncTask(AsyncTask&& other)									noexcept;
+			~AsyncTask()													noexcept;
+
+			/**
+			*	@brief Check whether the task coroutine has completed.
+			*
+			*	@return true if the coroutine has completed (or if there is no coroutine), else false.
+			*/
+			bool	isReady()										const	noexcept;
+
+			Awaiter	operator co_await()								const	noexcept;
+
+			AsyncTask& operator=(AsyncTask const&)							= delete;
+			AsyncTask& operator=(AsyncTask&& other)							noexcept;
+	};
+
+	class AsyncTaskHelper
+	{
+		private:
+			/** Value stored when an awaited task completes, a simple flag for tasks returning nothing. */
+			template <typename ResultType>
+			using ResultStorage = opt::optional<std::conditional_t<std::is_void_v<ResultType>, bool, ResultType>>;
+
+			/** Coroutine starting immediately and destroying itself when it completes. */
+			class DetachedCoroutine
+			{
+				public:
+					class promise_type
+					{
+						public:
+							DetachedCoroutine	get_return_object()		const	noexcept;
+							std::suspend_never	initial_suspend()		const	noexcept;
+							std::suspend_never	final_suspend()			const	noexcept;
+							void				return_void()			const	noexcept;
+							void				unhandled_exception()	const	noexcept;
+					};
+			};
+
+			/** Counter resuming a coroutine once a given number of tasks completed. */
+			class CompletionLatch
+			{
+				private:
+					/** Number of tasks left, plus one for the awaiting coroutine. */
+					std::atomic<size_t>		_count;
+
+					/** Coroutine to resume when all tasks completed. */
+					std::coroutine_handle<>	_continuation;
+
+				public:
+					CompletionLatch(size_t taskCount)									noexcept;
+
+					/**
+					*	@brief Notify that a task completed, resuming the awaiting coroutine if it was the last one.
+					*/
+					void	notify()													noexcept;
+
+					bool	await_ready()										const	noexcept;
+					bool	await_suspend(std::coroutine_handle<> continuation)			noexcept;
+					void	await_resume()										const	noexcept;
+			};
+
+			/** Blocking event set when a task completes. */
+			class CompletionEvent
+			{
+				private:
+					std::mutex				_mutex;
+					std::condition_variable	_condition;
+					bool					_isSet	= false;
+
+				public:
+					/**
+					*	@brief Set the event, waking the waiting thread up.
+					*/
+					void	notify()	noexcept;
+
+					/**
+					*	@brief Block the calling thread until the event is set.
+					*/
+					void	wait()		noexcept;
+			};
+
+			/**
+			*	@brief Await a task, store its result and notify the completion.
+			*
+			*	@param task			Task to await.
+			*	@param out_result	Storage filled with the task result.
+			*	@param notifier		Object notified once the result is stored.
+			*/
+			template <typename ResultType, typename NotifierType>
+			static DetachedCoroutine	awaitAndNotify(AsyncTask<ResultType>&		task,
+													   ResultStorage<ResultType>&	out_result,
+													   NotifierType&				notifier)	noexcept;
+
+		public:
+			AsyncTaskHelper()	= delete;
+			~AsyncTaskHelper()	= delete;
+
+			/**
+			*	@brief	Start all the provided tasks and complete once all of them completed.
+			*			Tasks run concurrently as soon as they schedule themselves on a ThreadPool.
+			*
+			*	@param tasks Tasks to await.
+			*
+			*	@return A task returning the result of each task, in the same order.
+			*/
+			template <typename ResultType, typename = typename std::enable_if_t<!std::is_same_v<ResultType, void>>>
+			static AsyncTask<std::vector<ResultType>>	whenAll(std::vector<AsyncTask<ResultType>> tasks)	noexcept;
+
+			/**
+			*	@brief	Start all the provided tasks and complete once all of them completed.
+			*			Tasks run concurrently as soon as they schedule themselves on a ThreadPool.
+			*
+			*	@param tasks Tasks to await.
+			*
+			*	@return A task completing after all the provided tasks.
+			*/
+			static AsyncTask<void>						whenAll(std::vector<AsyncTask<void>> tasks)			noexcept;
+
+			/**
+			*	@brief	Start a task and block the calling thread until it completes.
+			*			Must not be called from a ThreadPool worker, which could be needed to run the task.
+			*
+			*	@param task Task to run.
+			*
+			*	@return The result of the task.
+			*/
+			template <typename ResultType>
+			static ResultType							syncWait(AsyncTask<ResultType> task)				noexcept;
+	};
+
+	#include "Kodgen/Threading/AsyncTask.inl"
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,284 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+inline bool AsyncTaskPromiseBase::FinalAwaiter::await_ready() const noexcept
+{
+	return false;
+}
+
+inline void AsyncTaskPromiseBase::FinalAwaiter::await_resume() const noexcept
+{
+}
+
+template <typename PromiseType>
+std::coroutine_handle<> AsyncTaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<PromiseType> coroutine) noexcept
+{
+	//Symmetric transfer to the awaiting coroutine so that long chains of tasks don't grow the stack
+	std::coroutine_handle<> continuation = coroutine.promise().continuation;
+
+	return (continuation) ? continuation : std::noop_coroutine();
+}
+
+inline std::suspend_always AsyncTaskPromiseBase::initial_suspend() const noexcept
+{
+	return {};
+}
+
+inline AsyncTaskPromiseBase::FinalAwaiter AsyncTaskPromiseBase::final_suspend() const noexcept
+{
+	return {};
+}
+
+inline void AsyncTaskPromiseBase::unhandled_exception() const noexcept
+{
+	//Threading API is noexcept, an exception escaping a task can't be reported
+	std::terminate();
+}
+
+template <typename ResultType>
+AsyncTask<ResultType> AsyncTaskPromise<ResultType>::get_return_object() noexcept
+{
+	return AsyncTask<ResultType>(std::coroutine_handle<AsyncTaskPromise<ResultType>>::from_promise(*this));
+}
+
+template <typename ResultType>
+template <typename ValueType>
+void AsyncTaskPromise<ResultType>::return_value(ValueType&& value) noexcept
+{
+	result.emplace(std::forward<ValueType>(value));
+}
+
+inline AsyncTask<void> AsyncTaskPromise<void>::get_return_object() noexcept
+{
+	return AsyncTask<void>(std::coroutine_handle<AsyncTaskPromise<void>>::from_promise(*this));
+}
+
+inline void AsyncTaskPromise<void>::return_void() const noexcept
+{
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>::Awaiter::Awaiter(std::coroutine_handle<promise_type> coroutine) noexcept:
+	_coroutine{coroutine}
+{
+}
+
+template <typename ResultType>
+bool AsyncTask<ResultType>::Awaiter::await_ready() const noexcept
+{
+	return !_coroutine || _coroutine.done();
+}
+
+template <typename ResultType>
+std::coroutine_handle<> AsyncTask<ResultType>::Awaiter::await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept
+{
+	_coroutine.promise().continuation = awaitingCoroutine;
+
+	//Start the task on the awaiting thread
+	return _coroutine;
+}
+
+template <typename ResultType>
+ResultType AsyncTask<ResultType>::Awaiter::await_resume() noexcept
+{
+	if constexpr (!std::is_void_v<ResultType>)
+	{
+		assert(_coroutine && _coroutine.promise().result.has_value());
+
+		return std::move(*_coroutine.promise().result);
+	}
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>::AsyncTask(std::coroutine_handle<promise_type> coroutine) noexcept:
+	_coroutine{coroutine}
+{
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>::AsyncTask(AsyncTask&& other) noexcept:
+	_coroutine{std::exchange(other._coroutine, nullptr)}
+{
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>::~AsyncTask() noexcept
+{
+	if (_coroutine)
+	{
+		_coroutine.destroy();
+	}
+}
+
+template <typename ResultType>
+bool AsyncTask<ResultType>::isReady() const noexcept
+{
+	return !_coroutine || _coroutine.done();
+}
+
+template <typename ResultType>
+typename AsyncTask<ResultType>::Awaiter AsyncTask<ResultType>::operator co_await() const noexcept
+{
+	return Awaiter(_coroutine);
+}
+
+template <typename ResultType>
+AsyncTask<ResultType>& AsyncTask<ResultType>::operator=(AsyncTask&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (_coroutine)
+		{
+			_coroutine.destroy();
+		}
+
+		_coroutine = std::exchange(other._coroutine, nullptr);
+	}
+
+	return *this;
+}
+
+inline AsyncTaskHelper::DetachedCoroutine AsyncTaskHelper::DetachedCoroutine::promise_type::get_return_object() const noexcept
+{
+	return {};
+}
+
+inline std::suspend_never AsyncTaskHelper::DetachedCoroutine::promise_type::initial_suspend() const noexcept
+{
+	return {};
+}
+
+inline std::suspend_never AsyncTaskHelper::DetachedCoroutine::promise_type::final_suspend() const noexcept
+{
+	return {};
+}
+
+inline void AsyncTaskHelper::DetachedCoroutine::promise_type::return_void() const noexcept
+{
+}
+
+inline void AsyncTaskHelper::DetachedCoroutine::promise_type::unhandled_exception() const noexcept
+{
+	std::terminate();
+}
+
+inline AsyncTaskHelper::CompletionLatch::CompletionLatch(size_t taskCount) noexcept:
+	_count{taskCount + 1u}
+{
+}
+
+inline void AsyncTaskHelper::CompletionLatch::notify() noexcept
+{
+	//The awaiting coroutine already suspended if this is the last reference to the counter
+	if (_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+	{
+		_continuation.resume();
+	}
+}
+
+inline bool AsyncTaskHelper::CompletionLatch::await_ready() const noexcept
+{
+	return _count.load(std::memory_order_acquire) == 1u;
+}
+
+inline bool AsyncTaskHelper::CompletionLatch::await_suspend(std::coroutine_handle<> continuation) noexcept
+{
+	_continuation = continuation;
+
+	//Don't suspend if all tasks completed in the meantime
+	return _count.fetch_sub(1u, std::memory_order_acq_rel) > 1u;
+}
+
+inline void AsyncTaskHelper::CompletionLatch::await_resume() const noexcept
+{
+}
+
+inline void AsyncTaskHelper::CompletionEvent::notify() noexcept
+{
+	//Notify while locked, the waiting thread destroys the event as soon as it sees it set
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_isSet = true;
+	_condition.notify_all();
+}
+
+inline void AsyncTaskHelper::CompletionEvent::wait() noexcept
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_condition.wait(lock, [this]() { return _isSet; });
+}
+
+template <typename ResultType, typename NotifierType>
+AsyncTaskHelper::DetachedCoroutine AsyncTaskHelper::awaitAndNotify(AsyncTask<ResultType>& task, ResultStorage<ResultType>& out_result, NotifierType& notifier) noexcept
+{
+	if constexpr (std::is_void_v<ResultType>)
+	{
+		co_await task;
+
+		out_result.emplace(true);
+	}
+	else
+	{
+		out_result.emplace(co_await task);
+	}
+
+	notifier.notify();
+}
+
+template <typename ResultType, typename>
+AsyncTask<std::vector<ResultType>> AsyncTaskHelper::whenAll(std::vector<AsyncTask<ResultType>> tasks) noexcept
+{
+	std::vector<ResultStorage<ResultType>>	results(tasks.size());
+	CompletionLatch							latch(tasks.size());
+
+	for (size_t i = 0u; i < tasks.size(); i++)
+	{
+		awaitAndNotify(tasks[i], results[i], latch);
+	}
+
+	co_await latch;
+
+	std::vector<ResultType> out_results;
+	out_results.reserve(results.size());
+
+	for (ResultStorage<ResultType>& result : results)
+	{
+		out_results.emplace_back(std::move(*result));
+	}
+
+	co_return out_results;
+}
+
+inline AsyncTask<void> AsyncTaskHelper::whenAll(std::vector<AsyncTask<void>> tasks) noexcept
+{
+	std::vector<ResultStorage<void>>	results(tasks.size());
+	CompletionLatch						latch(tasks.size());
+
+	for (size_t i = 0u; i < tasks.size(); i++)
+	{
+		awaitAndNotify(tasks[i], results[i], latch);
+	}
+
+	co_await latch;
+}
+
+template <typename ResultType>
+ResultType AsyncTaskHelper::syncWait(AsyncTask<ResultType> task) noexcept
+{
+	ResultStorage<ResultType>	result{};
+	CompletionEvent				event;
+
+	awaitAndNotify(task, result, event);
+
+	event.wait();
+
+	if constexpr (!std::is_void_v<ResultType>)
+	{
+		return std::move(*result);
+	}
+}
\ No newline at end of file
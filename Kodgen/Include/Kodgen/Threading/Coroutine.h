@@ -0,0 +1,16 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+//The coroutine layer of the threading API is only available to code compiled as C++20 or later
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	#include <coroutine>
+	#define KODGEN_COROUTINES 1
+#else
+	#define KODGEN_COROUTINES 0
+#endif
\ No newline at end of file
@@ -14,12 +14,15 @@
 #include <condition_variable>
 #include <mutex>
 #include <atomic>		//std::atomic_uint
+#include <chrono>
 #include <functional>	//std::bind
 #include <memory>		//std::shared_ptr
 #include <type_traits>	//std::invoke_result
 
 #include "Kodgen/Threading/Task.h"
+#include "Kodgen/Threading/Coroutine.h"
 #include "Kodgen/Threading/ETerminationMode.h"
+#include "Kodgen/Threading/ThreadPoolStatistics.h"
 #include "Kodgen/Misc/FundamentalTypes.h"
 
 namespace kodgen
@@ -27,6 +30,26 @@ namespace kodgen
 	class ThreadPool
 	{
 		private:
+			/**
+			*	Statistics counters of a worker, only written by the worker itself.
+			*	Aligned on a cache line so that workers updating their own counters don't invalidate the counters of their neighbours.
+			*	64 bytes rather than std::hardware_destructive_interference_size, which is missing from some standard libraries and not ABI stable.
+			*/
+			struct alignas(64) WorkerCounters
+			{
+				std::atomic<uint64>	submittedTaskCount	{0u};
+				std::atomic<uint64>	executedTaskCount	{0u};
+				std::atomic<uint64>	executionTime		{0u};
+				std::atomic<uint64>	idleTime			{0u};
+				std::atomic<uint64>	taskMutexWaitTime	{0u};
+			};
+
+			/** Pool owning the worker running on the current thread, nullptr if the current thread is not a worker. */
+			static thread_local ThreadPool const*	_currentThreadPool;
+
+			/** Index of the worker running on the current thread in _currentThreadPool. */
+			static thread_local uint32				_currentWorkerIndex;
+
 			/** Are workers allowed to process queued tasks? */
 			bool									_isRunning	= true;
 
@@ -48,10 +71,47 @@ namespace kodgen
 			/** Number of workers currently running a task. */
 			std::atomic_uint						_workingWorkers;
 
+			/** Statistics counters of each worker, indexed by worker. */
+			std::vector<WorkerCounters>				_workerCounters;
+
+			/** Number of tasks submitted from threads which are not workers of this pool. */
+			std::atomic<uint64>						_externalSubmittedTaskCount	{0u};
+
+			/** Queue statistics, only written while _taskMutex is locked but readable at any time. */
+			std::atomic<uint64>						_queueLengthHighWaterMark	{0u};
+			std::atomic<uint64>						_readinessScanCount			{0u};
+			std::atomic<uint64>						_scannedTaskCount			{0u};
+			std::atomic<uint64>						_longestReadinessScan		{0u};
+
+			/**
+			*	Time of the last call to resetStatistics.
+			*	Durations measured by workers start no earlier than this time, so that a worker idle (or running a task)
+			*	while the statistics are reset doesn't report the time elapsed before the reset.
+			*/
+			std::atomic<std::chrono::steady_clock::time_point>	_statisticsResetTime	{};
+
 			/**
 			*	@brief Routine run by workers.
+			*
+			*	@param workerIndex Index of the worker running the routine.
 			*/
-			void						workerRoutine()				noexcept;
+			void						workerRoutine(uint32 workerIndex)		noexcept;
+
+			/**
+			*	@brief	Update the statistics after a task has been queued.
+			*			This method must be called while the task mutex is locked.
+			*
+			*	@param queueLength Number of queued tasks, including the new one.
+			*/
+			void						recordSubmittedTask(size_t queueLength)	noexcept;
+
+			/**
+			*	@brief	Update the statistics after the queue has been scanned for a ready task.
+			*			This method must be called while the task mutex is locked.
+			*
+			*	@param scannedTaskCount Number of tasks checked by the scan.
+			*/
+			void						recordReadinessScan(uint64 scannedTaskCount)	noexcept;
 
 			/**
 			*	@brief	Retrieve a task which is ready to execute.
@@ -69,6 +129,31 @@ namespace kodgen
 			bool						shouldKeepRunning()	const	noexcept;
 
 		public:
+#if KODGEN_COROUTINES
+			/** Awaitable resuming the awaiting coroutine on a worker of the pool (see ThreadPool::schedule). */
+			class ScheduleAwaitable
+			{
+				private:
+					/** Pool the coroutine is resumed on. */
+					ThreadPool&								_threadPool;
+
+					/** Name of the task resuming the coroutine. */
+					std::string								_taskName;
+
+					/** Tasks which must be finished before the coroutine is resumed. */
+					std::vector<std::shared_ptr<TaskBase>>	_dependencies;
+
+				public:
+					ScheduleAwaitable(ThreadPool&								threadPool,
+									  std::string							taskName,
+									  std::vector<std::shared_ptr<TaskBase>>&&	dependencies)	noexcept;
+
+					bool	await_ready()								const	noexcept;
+					void	await_suspend(std::coroutine_handle<> coroutine)	noexcept;
+					void	await_resume()								const	noexcept;
+			};
+#endif
+
 			/** Termination mode to apply when this Thread pool will be destroyed. */
 			ETerminationMode	terminationMode = ETerminationMode::FinishAll;
 
@@ -104,6 +189,40 @@ namespace kodgen
 			*/
 			void						setIsRunning(bool isRunning)									noexcept;
 
+			/**
+			*	@brief Get the number of workers of this pool.
+			*
+			*	@return The number of workers.
+			*/
+			uint32						getWorkerCount()										const	noexcept;
+
+			/**
+			*	@brief	Get the statistics of this pool since it was created or since the last call to resetStatistics.
+			*			Statistics can be read while tasks are running, in which case they are not necessarily consistent with each other.
+			*
+			*	@return The statistics of this pool.
+			*/
+			ThreadPoolStatistics		getStatistics()											const	noexcept;
+
+			/**
+			*	@brief Reset all the statistics of this pool.
+			*/
+			void						resetStatistics()												noexcept;
+
+#if KODGEN_COROUTINES
+			/**
+			*	@brief	Suspend the awaiting coroutine and resume it on a worker of the pool, once all the provided tasks are finished.
+			*			The worker is not blocked while the dependencies are running, the coroutine is submitted as a regular task.
+			*
+			*	@param taskName		Name of the task resuming the coroutine.
+			*	@param dependencies	Tasks which must be finished before the coroutine is resumed.
+			*
+			*	@return The awaitable to co_await.
+			*/
+			ScheduleAwaitable			schedule(std::string								taskName		= "Coroutine",
+												 std::vector<std::shared_ptr<TaskBase>>&&	dependencies	= {})	noexcept;
+#endif
+
 			ThreadPool& operator=(ThreadPool const&)	= delete;
 			ThreadPool& operator=(ThreadPool&&)			= delete;
 	};
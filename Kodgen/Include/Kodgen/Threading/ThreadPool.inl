@@ -18,9 +18,40 @@ std::shared_ptr<TaskBase> ThreadPool::submitTask(std::string const& taskName, Ca
 
 	_taskMutex.lock();
 	_tasks.emplace_back(newTask);
+	recordSubmittedTask(_tasks.size());
 	_taskMutex.unlock();
 
 	_taskCondition.notify_one();
 
 	return newTask;
-}
\ No newline at end of file
+}
+
+#if KODGEN_COROUTINES
+
+inline ThreadPool::ScheduleAwaitable::ScheduleAwaitable(ThreadPool& threadPool, std::string taskName, std::vector<std::shared_ptr<TaskBase>>&& dependencies) noexcept:
+	_threadPool{threadPool},
+	_taskName{std::move(taskName)},
+	_dependencies{std::forward<std::vector<std::shared_ptr<TaskBase>>>(dependencies)}
+{
+}
+
+inline bool ThreadPool::ScheduleAwaitable::await_ready() const noexcept
+{
+	return false;
+}
+
+inline void ThreadPool::ScheduleAwaitable::await_suspend(std::coroutine_handle<> coroutine) noexcept
+{
+	_threadPool.submitTask(_taskName, [coroutine](TaskBase*) { coroutine.resume(); }, std::move(_dependencies));
+}
+
+inline void ThreadPool::ScheduleAwaitable::await_resume() const noexcept
+{
+}
+
+inline ThreadPool::ScheduleAwaitable ThreadPool::schedule(std::string taskName, std::vector<std::shared_ptr<TaskBase>>&& dependencies) noexcept
+{
+	return ScheduleAwaitable(*this, std::move(taskName), std::forward<std::vector<std::shared_ptr<TaskBase>>>(dependencies));
+}
+
+#endif
\ No newline at end of file
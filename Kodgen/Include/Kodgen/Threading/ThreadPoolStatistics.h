@@ -0,0 +1,77 @@
+/**
+*	Copyright (c) 2021 Julien SOYSOUVANH - All Rights Reserved
+*
+*	This file is part of the Kodgen library project which is released under the MIT License.
+*	See the LICENSE.md file for full license details.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Kodgen/Misc/FundamentalTypes.h"
+
+namespace kodgen
+{
+	struct WorkerStatistics
+	{
+		/** Number of tasks submitted by tasks running on this worker. */
+		uint64	submittedTaskCount	= 0u;
+
+		/** Number of tasks executed by this worker. */
+		uint64	executedTaskCount	= 0u;
+
+		/** Time spent executing tasks, in nanoseconds. */
+		uint64	executionTime		= 0u;
+
+		/** Time spent waiting for new tasks, in nanoseconds. */
+		uint64	idleTime			= 0u;
+
+		/** Time spent waiting to lock the pool task mutex, in nanoseconds. */
+		uint64	taskMutexWaitTime	= 0u;
+	};
+
+	class ThreadPoolStatistics
+	{
+		public:
+			/** Statistics of each worker of the pool, indexed by worker. */
+			std::vector<WorkerStatistics>	workers;
+
+			/** Number of tasks submitted from threads which are not workers of the pool. */
+			uint64							externalSubmittedTaskCount	= 0u;
+
+			/** Highest number of queued tasks. */
+			uint64							queueLengthHighWaterMark	= 0u;
+
+			/** Number of times the queue has been scanned for a ready task. */
+			uint64							readinessScanCount			= 0u;
+
+			/** Total number of tasks checked by all readiness scans. */
+			uint64							scannedTaskCount			= 0u;
+
+			/** Highest number of tasks checked by a single readiness scan. */
+			uint64							longestReadinessScan		= 0u;
+
+			/**
+			*	@brief Get the total number of tasks submitted to the pool.
+			*
+			*	@return The number of submitted tasks, from workers and external threads.
+			*/
+			uint64		getSubmittedTaskCount()	const	noexcept;
+
+			/**
+			*	@brief Get the total number of tasks executed by the pool.
+			*
+			*	@return The number of tasks executed by all workers.
+			*/
+			uint64		getExecutedTaskCount()	const	noexcept;
+
+			/**
+			*	@brief Get a human readable representation of the statistics, with one line per worker.
+			*
+			*	@return The statistics as a string.
+			*/
+			std::string	toString()				const	noexcept;
+	};
+}
\ No newline at end of file
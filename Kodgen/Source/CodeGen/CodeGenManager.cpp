@@ -10,23 +10,72 @@ CodeGenManager::CodeGenManager(uint32 threadCount) noexcept:
 {
 }
 
-std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& codeGenUnit, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
+bool CodeGenManager::shouldProcessFile(CodeGenManagerSettings& projectSettings, GitIndexChangeDetector& gitIndexChangeDetector, CodeGenUnit const& codeGenUnit, fs::path const& file, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
 {
+	EGitFileState				gitFileState	= (gitIndexChangeDetector.isLoaded()) ? gitIndexChangeDetector.getFileState(file) : EGitFileState::Untracked;
+	FileProcessingExplanation	explanation;
+
+	fs::path					missingGeneratedFile;
+
+	//Already up-to-date after the last run, only check that the generated files have not been deleted since then
+	if (gitFileState == EGitFileState::Unchanged && !codeGenUnit.findMissingGeneratedFile(file, missingGeneratedFile))
+	{
+		explanation.file	= file;
+		explanation.reason	= EFileProcessingReason::UnchangedSinceLastRun;
+	}
+	else
+	{
+		explanation = codeGenUnit.explainIsUpToDate(file);
+
+		//File content may have changed without its generated files timestamps noticing (branch switch restoring old timestamps...)
+		if (explanation.reason == EFileProcessingReason::UpToDate && gitFileState == EGitFileState::Changed)
+		{
+			explanation.reason = EFileProcessingReason::ChangedSinceLastRun;
+		}
+	}
+
+	if (!explanation.isProcessed() && forceRegenerateAll)
+	{
+		explanation.reason = EFileProcessingReason::ForcedRegeneration;
+	}
+
+	bool isProcessed = explanation.isProcessed();
+
+	if (!isProcessed)
+	{
+		out_genResult.upToDateFiles.push_back(file);
+	}
+
+	if (projectSettings.shouldExplainFileProcessing)
+	{
+		if (logger != nullptr)
+		{
+			logger->log("[Explain] " + explanation.toString(), ILogger::ELogSeverity::Info);
+		}
+
+		out_genResult.fileProcessingExplanations.emplace_back(std::move(explanation));
+	}
+
+	return isProcessed;
+}
+
+std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenManagerSettings& projectSettings, GitIndexChangeDetector& gitIndexChangeDetector, CodeGenUnit const& codeGenUnit, CodeGenResult& out_genResult, bool forceRegenerateAll) noexcept
+{
+	AllocationStageScope allocationStageScope(EAllocationStage::Discovery);
+
 	std::set<fs::path> result;
 
+	loadGitIndexChangeDetector(projectSettings, gitIndexChangeDetector, codeGenUnit);
+
 	//Iterate over all "toParseFiles"
-	for (fs::path path : settings.getToProcessFiles())
+	for (fs::path path : projectSettings.getToProcessFiles())
 	{
 		if (fs::exists(path) && !fs::is_directory(path))
 		{
-			if (!codeGenUnit.isUpToDate(path) || forceRegenerateAll)
+			if (shouldProcessFile(projectSettings, gitIndexChangeDetector, codeGenUnit, path, out_genResult, forceRegenerateAll))
 			{
 				result.emplace(path);
 			}
-			else
-			{
-				out_genResult.upToDateFiles.push_back(path);
-			}
 		}
 		else if (logger != nullptr)
 		{
@@ -36,7 +85,7 @@ std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& cod
 	}
 
 	//Iterate over all "toParseDirectories"
-	for (fs::path pathToIncludedDir : settings.getToProcessDirectories())
+	for (fs::path pathToIncludedDir : projectSettings.getToProcessDirectories())
 	{
 		if (fs::exists(pathToIncludedDir) && fs::is_directory(pathToIncludedDir))
 		{
@@ -49,19 +98,15 @@ std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& cod
 				{
 					if (entry.is_regular_file())
 					{
-						if (settings.isSupportedFileExtension(entry.path().extension()) && !settings.isIgnoredFile(entry.path()))
+						if (projectSettings.isSupportedFileExtension(entry.path().extension()) && !projectSettings.isIgnoredFile(entry.path()))
 						{
-							if (!codeGenUnit.isUpToDate(entry.path()) || forceRegenerateAll)
+							if (shouldProcessFile(projectSettings, gitIndexChangeDetector, codeGenUnit, entry.path(), out_genResult, forceRegenerateAll))
 							{
 								result.emplace(entry.path());
 							}
-							else
-							{
-								out_genResult.upToDateFiles.push_back(entry.path());
-							}
 						}
 					}
-					else if (entry.is_directory() && settings.isIgnoredDirectory(entry.path()))
+					else if (entry.is_directory() && projectSettings.isIgnoredDirectory(entry.path()))
 					{
 						//Don't iterate on ignored directory content
 						directoryIt.disable_recursion_pending();
@@ -79,6 +124,134 @@ std::set<fs::path> CodeGenManager::identifyFilesToProcess(CodeGenUnit const& cod
 	return result;
 }
 
+std::vector<std::shared_ptr<TaskBase>> CodeGenManager::generateProvisionalFiles(CodeGenUnit const& codeGenUnit, std::set<fs::path> const& toProcessFiles) noexcept
+{
+	std::vector<std::shared_ptr<TaskBase>> provisionalTasks;
+	provisionalTasks.reserve(toProcessFiles.size());
+
+	//Lock the thread pool until all tasks have been pushed to avoid competing for the tasks mutex
+	_threadPool.setIsRunning(false);
+
+	for (fs::path const& file : toProcessFiles)
+	{
+		auto provisionalTaskLambda = [this, &codeGenUnit, &file](TaskBase*) -> bool
+		{
+			bool result = codeGenUnit.generateProvisionalCode(file);
+
+			if (!result && logger != nullptr)
+			{
+				logger->log("Failed to generate provisional files for " + file.string() + ".", ILogger::ELogSeverity::Warning);
+			}
+
+			return result;
+		};
+
+		provisionalTasks.emplace_back(_threadPool.submitTask(std::string("Provisional generation ") + file.string(), provisionalTaskLambda));
+	}
+
+	//Don't wait for the provisional tasks, the full generation tasks are queued behind them
+	_threadPool.setIsRunning(true);
+
+	if (logger != nullptr)
+	{
+		logger->log("Generating provisional files for " + std::to_string(toProcessFiles.size()) + " file(s).", ILogger::ELogSeverity::Info);
+	}
+
+	return provisionalTasks;
+}
+
+void CodeGenManager::reportAllocations(AllocationReport const& allocationsAtStart, CodeGenResult& out_genResult) const noexcept
+{
+	out_genResult.allocationReport = AllocationTracker::getReport().since(allocationsAtStart);
+
+	if (logger != nullptr && !out_genResult.allocationReport.isEmpty())
+	{
+		logger->log("Allocations per stage:\n" + out_genResult.allocationReport.toString(), ILogger::ELogSeverity::Info);
+	}
+}
+
+void CodeGenManager::reportThreadPoolStatistics(CodeGenResult& out_genResult) const noexcept
+{
+	out_genResult.threadPoolStatistics = _threadPool.getStatistics();
+
+	if (logger != nullptr && out_genResult.threadPoolStatistics.getExecutedTaskCount() != 0u)
+	{
+		logger->log("Thread pool statistics:\n" + out_genResult.threadPoolStatistics.toString(), ILogger::ELogSeverity::Info);
+	}
+}
+
+void CodeGenManager::startProgressTracking() noexcept
+{
+	_progressTracker.start(progressCallback, shouldDisplayProgress, progressReportInterval, _threadPool.getWorkerCount());
+}
+
+void CodeGenManager::saveFileCostHistory(FileCostHistory& fileCostHistory, CodeGenUnit const& codeGenUnit, std::set<fs::path> const& processedFiles) noexcept
+{
+	for (fs::path const& file : processedFiles)
+	{
+		float cost = _progressTracker.getMeasuredCost(file);
+
+		if (cost >= 0.0f)
+		{
+			fileCostHistory.setCost(file, cost);
+		}
+	}
+
+	if (!fileCostHistory.save(codeGenUnit.getSettings()->getOutputDirectory()) && logger != nullptr)
+	{
+		logger->log("Failed to save the file cost history.", ILogger::ELogSeverity::Warning);
+	}
+}
+
+void CodeGenManager::loadGitIndexChangeDetector(CodeGenManagerSettings& projectSettings, GitIndexChangeDetector& gitIndexChangeDetector, CodeGenUnit const& codeGenUnit) noexcept
+{
+	//Reset the detector so that a disabled setting or a failed load never uses the index of a previous run
+	gitIndexChangeDetector = GitIndexChangeDetector();
+
+	if (projectSettings.shouldUseGitIndexChangeDetection)
+	{
+		//Each directory to process may belong to another repository (submodules, nested repositories)
+		std::set<fs::path> repositoryPaths(projectSettings.getToProcessDirectories().cbegin(), projectSettings.getToProcessDirectories().cend());
+
+		for (fs::path const& file : projectSettings.getToProcessFiles())
+		{
+			repositoryPaths.insert(file.parent_path());
+		}
+
+		if (!repositoryPaths.empty())
+		{
+			gitIndexChangeDetector.load(std::vector<fs::path>(repositoryPaths.cbegin(), repositoryPaths.cend()), codeGenUnit.getSettings()->getOutputDirectory(), logger);
+		}
+	}
+}
+
+void CodeGenManager::saveGitIndexChangeDetectorManifest(GitIndexChangeDetector const& gitIndexChangeDetector, CodeGenUnit const& codeGenUnit, CodeGenResult const& genResult) noexcept
+{
+	if (gitIndexChangeDetector.isLoaded() && genResult.completed)
+	{
+		if (!gitIndexChangeDetector.saveManifest(codeGenUnit.getSettings()->getOutputDirectory()) && logger != nullptr)
+		{
+			logger->log("Failed to save the git index change detection manifest.", ILogger::ELogSeverity::Warning);
+		}
+	}
+}
+
+void CodeGenManager::loadGeneratedFilePack(CodeGenUnit& codeGenUnit) noexcept
+{
+	if (!codeGenUnit.loadGeneratedFilePack() && logger != nullptr)
+	{
+		logger->log("No valid generated file pack in " + codeGenUnit.getSettings()->getOutputDirectory().string() + ", a new one is created.");
+	}
+}
+
+void CodeGenManager::saveGeneratedFilePack(CodeGenUnit const& codeGenUnit) noexcept
+{
+	if (!codeGenUnit.saveGeneratedFilePack() && logger != nullptr)
+	{
+		logger->log("Failed to save or extract the generated file pack.", ILogger::ELogSeverity::Warning);
+	}
+}
+
 uint32 CodeGenManager::getThreadCount(uint32 initialThreadCount) const noexcept
 {
 	if (initialThreadCount == 0)
@@ -123,7 +296,7 @@ void CodeGenManager::generateMacrosFile(ParsingSettings const& parsingSettings,
 	defineMacroIfNdef(parsingSettings.propertyParsingSettings.functionMacroName);
 }
 
-bool CodeGenManager::checkGenerationSetup(FileParser const& /* fileParser */, CodeGenUnit const& codeGenUnit) noexcept
+bool CodeGenManager::checkGenerationSetup(CodeGenManagerSettings& projectSettings, FileParser const& /* fileParser */, CodeGenUnit const& codeGenUnit) noexcept
 {
 	bool canLog	= logger != nullptr;
 	
@@ -132,9 +305,9 @@ bool CodeGenManager::checkGenerationSetup(FileParser const& /* fileParser */, Co
 		//Emit a warning if the output directory content is going to be parsed
 		if (fs::exists(codeGenUnitSettings->getOutputDirectory()) &&					//abort check if the output directory doesn't exist
 			!fs::is_empty(codeGenUnitSettings->getOutputDirectory()) &&					//abort check if the output directory contains no file
-			!settings.isIgnoredDirectory(codeGenUnitSettings->getOutputDirectory()))	//abort check if the output directory is already ignored
+			!projectSettings.isIgnoredDirectory(codeGenUnitSettings->getOutputDirectory()))	//abort check if the output directory is already ignored
 		{
-			for (fs::path const& parsedDirectory : settings.getToProcessDirectories())
+			for (fs::path const& parsedDirectory : projectSettings.getToProcessDirectories())
 			{
 				if (FilesystemHelpers::isChildPath(codeGenUnitSettings->getOutputDirectory(), parsedDirectory))
 				{
@@ -2,6 +2,7 @@
 
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/Helpers.h"
 
 using namespace kodgen;
 
@@ -40,6 +41,9 @@ bool CodeGenManagerSettings::loadSettingsValues(toml::value const& tomlData, ILo
 		loadToProcessDirectories(tomlGeneratorSettings, logger);
 		loadIgnoredFiles(tomlGeneratorSettings, logger);
 		loadIgnoredDirectories(tomlGeneratorSettings, logger);
+		loadShouldExplainFileProcessing(tomlGeneratorSettings, logger);
+		loadShouldUseGitIndexChangeDetection(tomlGeneratorSettings, logger);
+		loadShouldGenerateProvisionalFiles(tomlGeneratorSettings, logger);
 
 		return true;
 	}
@@ -178,6 +182,30 @@ bool CodeGenManagerSettings::isIgnoredDirectory(fs::path const& directory) noexc
 	return _ignoredDirectories.find(fs::exists(directory) ? FilesystemHelpers::sanitizePath(directory) : directory) != _ignoredDirectories.end();
 }
 
+void CodeGenManagerSettings::loadShouldExplainFileProcessing(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldExplainFileProcessing", shouldExplainFileProcessing, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldExplainFileProcessing: " + Helpers::toString(shouldExplainFileProcessing));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldUseGitIndexChangeDetection(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldUseGitIndexChangeDetection", shouldUseGitIndexChangeDetection, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUseGitIndexChangeDetection: " + Helpers::toString(shouldUseGitIndexChangeDetection));
+	}
+}
+
+void CodeGenManagerSettings::loadShouldGenerateProvisionalFiles(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldGenerateProvisionalFiles", shouldGenerateProvisionalFiles, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldGenerateProvisionalFiles: " + Helpers::toString(shouldGenerateProvisionalFiles));
+	}
+}
+
 void CodeGenManagerSettings::loadSupportedFileExtensions(toml::value const& generationSettings, ILogger* logger) noexcept
 {
 	//Clear supported extensions before loading
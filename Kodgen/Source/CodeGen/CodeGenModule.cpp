@@ -1,6 +1,12 @@
 #include "Kodgen/CodeGen/CodeGenModule.h"
 
 #include <algorithm>
+#include <typeinfo>
+#include <cstdlib>	//std::free
+
+#if defined(__GNUG__)
+#include <cxxabi.h>	//abi::__cxa_demangle
+#endif
 
 #include "Kodgen/CodeGen/PropertyCodeGen.h"
 #include "Kodgen/CodeGen/CodeGenEnv.h"
@@ -18,6 +24,35 @@ int32 CodeGenModule::getGenerationOrder() const noexcept
 	return (*it)->getIterationCount();
 }
 
+std::string CodeGenModule::getName() const noexcept
+{
+	std::string name = typeid(*this).name();
+
+#if defined(__GNUG__)
+	//GCC and Clang return the mangled name of the type
+	int		status;
+	char*	demangledName = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+
+	if (status == 0 && demangledName != nullptr)
+	{
+		name = demangledName;
+	}
+
+	std::free(demangledName);
+#else
+	//MSVC returns the declaration of the type (class Name)
+	for (char const* prefix : { "class ", "struct " })
+	{
+		if (name.rfind(prefix, 0u) == 0u)
+		{
+			name.erase(0u, std::char_traits<char>::length(prefix));
+		}
+	}
+#endif
+
+	return name;
+}
+
 ETraversalBehaviour CodeGenModule::generateCodeForEntity(EntityInfo const& entity, CodeGenEnv& env, std::string& inout_result, void const* /* data */) noexcept
 {
 	return generateCodeForEntity(entity, env, inout_result);
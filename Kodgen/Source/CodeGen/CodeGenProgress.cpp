@@ -0,0 +1,46 @@
+#include "Kodgen/CodeGen/CodeGenProgress.h"
+
+#include <cmath>	//std::ceil
+
+using namespace kodgen;
+
+size_t CodeGenProgress::getCompletedFileCount() const noexcept
+{
+	return writtenFileCount + failedFileCount;
+}
+
+std::string CodeGenProgress::toString() const noexcept
+{
+	//Keep a single decimal, a full float is too verbose for a status line
+	auto toDecimalString = [](float value)
+	{
+		std::string result = std::to_string(static_cast<int>(value * 10.0f + 0.5f));
+
+		if (result.size() < 2u)
+		{
+			result.insert(0u, "0");
+		}
+
+		return result.insert(result.size() - 1u, ".");
+	};
+
+	std::string result = std::to_string(getCompletedFileCount()) + "/" + std::to_string(queuedFileCount) + " files";
+
+	if (failedFileCount != 0u)
+	{
+		result += " (" + std::to_string(failedFileCount) + " failed)";
+	}
+
+	result += " | parsing " + std::to_string(parsingFileCount) +
+			  " | generating " + std::to_string(generatingFileCount) +
+			  " | " + toDecimalString(throughput) + " files/s" +
+			  " | ETA " + ((estimatedRemainingTime < 0.0f) ? std::string("?") : std::to_string(static_cast<int>(std::ceil(estimatedRemainingTime))) + "s");
+
+	if (!inFlightFiles.empty())
+	{
+		result += " | slowest: " + inFlightFiles.front().file.filename().string() + " " + toDecimalString(inFlightFiles.front().duration) + "s" +
+				  ((inFlightFiles.front().isParsing) ? " (parsing)" : " (generating)");
+	}
+
+	return result;
+}
\ No newline at end of file
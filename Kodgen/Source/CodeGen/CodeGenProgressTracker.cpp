@@ -0,0 +1,326 @@
+#include "Kodgen/CodeGen/CodeGenProgressTracker.h"
+
+#include <iostream>
+#include <algorithm>	//std::sort, std::clamp
+
+using namespace kodgen;
+
+CodeGenProgressTracker::~CodeGenProgressTracker() noexcept
+{
+	stop();
+}
+
+void CodeGenProgressTracker::start(std::function<void(CodeGenProgress const&)> callback, bool shouldDisplay, float reportInterval, uint32 threadCount) noexcept
+{
+	//A tracker can't be started twice
+	stop();
+
+	if (!callback && !shouldDisplay)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_callback				= std::move(callback);
+		_shouldDisplay			= shouldDisplay;
+		_displayedLineLength	= 0u;
+		_threadCount			= std::max(threadCount, 1u);
+		_startTime				= Clock::now();
+		_firstProcessingStart	= Clock::time_point();
+		_counters				= CodeGenProgress();
+		_completedCost			= 0.0f;
+		_isStopRequested		= false;
+
+		_files.clear();
+	}
+
+	_isTracking = true;
+
+	_reportThread = std::thread(&CodeGenProgressTracker::reportRoutine, this, reportInterval);
+}
+
+void CodeGenProgressTracker::stop() noexcept
+{
+	if (!_isTracking)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_isStopRequested = true;
+	}
+
+	_stopCondition.notify_all();
+	_reportThread.join();
+
+	//Final report so that the last progress reflects the end of the run
+	report();
+
+	if (_shouldDisplay)
+	{
+		std::cout << std::endl;
+	}
+
+	_isTracking = false;
+}
+
+bool CodeGenProgressTracker::isTracking() const noexcept
+{
+	return _isTracking;
+}
+
+void CodeGenProgressTracker::reportRoutine(float reportInterval) noexcept
+{
+	std::chrono::duration<float> interval(std::max(reportInterval, 0.01f));
+
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (!_stopCondition.wait_for(lock, interval, [this]() { return _isStopRequested; }))
+	{
+		lock.unlock();
+		report();
+		lock.lock();
+	}
+}
+
+void CodeGenProgressTracker::report() noexcept
+{
+	CodeGenProgress progress = getProgress();
+
+	if (_callback)
+	{
+		_callback(progress);
+	}
+
+	if (_shouldDisplay)
+	{
+		std::string line = "[Progress] " + progress.toString();
+
+		//Erase the remaining of the previous line if it was longer
+		size_t lineLength = line.size();
+
+		if (lineLength < _displayedLineLength)
+		{
+			line.append(_displayedLineLength - lineLength, ' ');
+		}
+
+		_displayedLineLength = lineLength;
+
+		std::cout << "\r" << line << std::flush;
+	}
+}
+
+CodeGenProgress CodeGenProgressTracker::buildProgress() const noexcept
+{
+	CodeGenProgress		progress	= _counters;
+	Clock::time_point	now			= Clock::now();
+	size_t				completed	= progress.getCompletedFileCount();
+
+	progress.elapsedTime	= std::chrono::duration<float>(now - _startTime).count();
+	progress.throughput		= (progress.elapsedTime > 0.0f) ? completed / progress.elapsedTime : 0.0f;
+
+	//Files without history are estimated with the average cost of the completed processings, or of the files with history
+	float	knownCostSum	= 0.0f;
+	size_t	knownCostCount	= 0u;
+
+	for (auto const& [file, state] : _files)
+	{
+		if (state.estimatedCost >= 0.0f)
+		{
+			knownCostSum += state.estimatedCost;
+			knownCostCount++;
+		}
+	}
+
+	float	defaultCost		= (completed != 0u) ? _completedCost / completed : (knownCostCount != 0u) ? knownCostSum / knownCostCount : -1.0f;
+	float	remainingCost	= 0.0f;
+	float	inFlightCost	= 0.0f;
+	bool	isEstimable		= true;
+
+	for (auto const& [file, state] : _files)
+	{
+		float cost = (state.estimatedCost >= 0.0f) ? state.estimatedCost : defaultCost;
+
+		if (state.isParsing || state.isGenerating)
+		{
+			float processingDuration = std::chrono::duration<float>(now - state.processingStart).count();
+
+			inFlightCost += processingDuration;
+
+			progress.inFlightFiles.push_back({ file, state.isParsing, std::chrono::duration<float>(now - state.stageStart).count() });
+
+			if (state.pendingProcessingCount != 0u)
+			{
+				//The current processing is pending as well, only its remaining part is left
+				remainingCost += std::max(cost - processingDuration, 0.0f) + cost * (state.pendingProcessingCount - 1u);
+			}
+		}
+		else
+		{
+			remainingCost += cost * state.pendingProcessingCount;
+		}
+
+		isEstimable &= state.pendingProcessingCount == 0u || cost >= 0.0f;
+	}
+
+	std::sort(progress.inFlightFiles.begin(), progress.inFlightFiles.end(), [](CodeGenProgress::InFlightFile const& lhs, CodeGenProgress::InFlightFile const& rhs)
+			  {
+				  return lhs.duration > rhs.duration;
+			  });
+
+	if (isEstimable)
+	{
+		//Use the parallelism observed since the first processing started, which includes the time threads spent waiting
+		float parallelism			= static_cast<float>(_threadCount);
+		float processingDuration	= std::chrono::duration<float>(now - _firstProcessingStart).count();
+
+		if (completed != 0u && processingDuration > 0.0f)
+		{
+			parallelism = std::clamp((_completedCost + inFlightCost) / processingDuration, 1.0f, parallelism);
+		}
+
+		progress.estimatedRemainingTime = remainingCost / parallelism;
+	}
+
+	return progress;
+}
+
+CodeGenProgress CodeGenProgressTracker::getProgress() const noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return buildProgress();
+}
+
+void CodeGenProgressTracker::addDiscoveredFiles(size_t fileCount) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_counters.discoveredFileCount += fileCount;
+	}
+}
+
+void CodeGenProgressTracker::queueFile(fs::path const& file, float estimatedCost, size_t processingCount) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		FileState& state = _files[file];
+
+		if (estimatedCost >= 0.0f)
+		{
+			state.estimatedCost = estimatedCost;
+		}
+
+		state.pendingProcessingCount	+= processingCount;
+		_counters.queuedFileCount		+= processingCount;
+	}
+}
+
+void CodeGenProgressTracker::onParsingStarted(fs::path const& file) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		FileState& state = _files[file];
+
+		state.processingStart	= Clock::now();
+		state.stageStart		= state.processingStart;
+		state.isParsing			= true;
+
+		if (_firstProcessingStart == Clock::time_point())
+		{
+			_firstProcessingStart = state.processingStart;
+		}
+
+		_counters.parsingFileCount++;
+	}
+}
+
+void CodeGenProgressTracker::onParsingEnded(fs::path const& file, bool succeeded) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		FileState& state = _files[file];
+
+		state.isParsing = false;
+		_counters.parsingFileCount--;
+
+		if (!succeeded)
+		{
+			endProcessing(state, false);
+		}
+	}
+}
+
+void CodeGenProgressTracker::onGenerationStarted(fs::path const& file) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		FileState& state = _files[file];
+
+		state.stageStart	= Clock::now();
+		state.isGenerating	= true;
+
+		_counters.generatingFileCount++;
+	}
+}
+
+void CodeGenProgressTracker::onGenerationEnded(fs::path const& file, bool succeeded) noexcept
+{
+	if (_isTracking)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		FileState& state = _files[file];
+
+		state.isGenerating = false;
+		_counters.generatingFileCount--;
+
+		endProcessing(state, succeeded);
+	}
+}
+
+void CodeGenProgressTracker::endProcessing(FileState& state, bool succeeded) noexcept
+{
+	float cost = std::chrono::duration<float>(Clock::now() - state.processingStart).count();
+
+	state.measuredCost += cost;
+	state.completedProcessingCount++;
+	_completedCost += cost;
+
+	if (state.pendingProcessingCount != 0u)
+	{
+		state.pendingProcessingCount--;
+	}
+
+	if (succeeded)
+	{
+		_counters.writtenFileCount++;
+	}
+	else
+	{
+		_counters.failedFileCount++;
+	}
+}
+
+float CodeGenProgressTracker::getMeasuredCost(fs::path const& file) const noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto it = _files.find(file);
+
+	return (it != _files.cend() && it->second.completedProcessingCount != 0u) ? it->second.measuredCost / it->second.completedProcessingCount : -1.0f;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include "Kodgen/CodeGen/CodeGenReplayResult.h"
+
+using namespace kodgen;
+
+float CodeGenReplayResult::getEntitiesPerSecond() const noexcept
+{
+	return (duration > 0.0f) ? static_cast<float>(entityCount) / duration : 0.0f;
+}
+
+float CodeGenReplayResult::getBytesPerSecond() const noexcept
+{
+	return (duration > 0.0f) ? static_cast<float>(generatedBytes) / duration : 0.0f;
+}
\ No newline at end of file
@@ -6,6 +6,8 @@ void CodeGenResult::mergeResult(CodeGenResult&& otherResult) noexcept
 {
 	parsedFiles.insert(parsedFiles.cend(), std::make_move_iterator(otherResult.parsedFiles.cbegin()), std::make_move_iterator(otherResult.parsedFiles.cend()));
 	upToDateFiles.insert(upToDateFiles.cend(), std::make_move_iterator(otherResult.upToDateFiles.cbegin()), std::make_move_iterator(otherResult.upToDateFiles.cend()));
+	fileProcessingExplanations.insert(fileProcessingExplanations.cend(), std::make_move_iterator(otherResult.fileProcessingExplanations.begin()), std::make_move_iterator(otherResult.fileProcessingExplanations.end()));
+	generatedFileContributions.insert(generatedFileContributions.cend(), std::make_move_iterator(otherResult.generatedFileContributions.begin()), std::make_move_iterator(otherResult.generatedFileContributions.end()));
 
 	completed &= otherResult.completed;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "Kodgen/CodeGen/CodeGenHelpers.h"
 #include "Kodgen/CodeGen/PropertyCodeGen.h"
+#include "Kodgen/Misc/AllocationTracker.h"
 
 #define HANDLE_NESTED_ENTITY_ITERATION_RESULT(result)																\
 	if (result == ETraversalBehaviour::Break)																		\
@@ -19,6 +20,8 @@ using namespace kodgen;
 
 CodeGenUnit::CodeGenUnit(CodeGenUnit const& other) noexcept:
 	_isCopy{true},
+	_generatedFilePack{other._generatedFilePack},
+	_areProvisionalFilesEnabled{other._areProvisionalFilesEnabled},
 	settings{other.settings},
 	logger{other.logger}
 {
@@ -101,8 +104,114 @@ bool CodeGenUnit::isFileNewerThan(fs::path const& file, fs::path const& referenc
 	return fs::last_write_time(file) > fs::last_write_time(referenceFile);
 }
 
-bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
+bool CodeGenUnit::generatedFileExists(fs::path const& generatedFile) const noexcept
 {
+	fs::file_time_type lastWriteTime;
+
+	return (_generatedFilePack != nullptr) ? _generatedFilePack->getLastWriteTime(generatedFile, lastWriteTime) : fs::exists(generatedFile);
+}
+
+bool CodeGenUnit::isGeneratedFileNewerThan(fs::path const& generatedFile, fs::path const& referenceFile) const noexcept
+{
+	fs::file_time_type lastWriteTime;
+
+	if (_generatedFilePack != nullptr)
+	{
+		return _generatedFilePack->getLastWriteTime(generatedFile, lastWriteTime) && lastWriteTime > fs::last_write_time(referenceFile);
+	}
+
+	return isFileNewerThan(generatedFile, referenceFile);
+}
+
+bool CodeGenUnit::loadGeneratedFilePack() noexcept
+{
+	if (settings == nullptr || !settings->shouldPackGeneratedFiles)
+	{
+		_generatedFilePack.reset();
+
+		return true;
+	}
+
+	_generatedFilePack = std::make_shared<GeneratedFilePack>(settings->getOutputDirectory());
+
+	return _generatedFilePack->load();
+}
+
+bool CodeGenUnit::saveGeneratedFilePack() const noexcept
+{
+	if (_generatedFilePack == nullptr)
+	{
+		return true;
+	}
+
+	//Files generated from deleted source files would be extracted and listed in the overlay forever
+	_generatedFilePack->removeOrphanedFiles();
+
+	bool result = _generatedFilePack->save();
+
+	if (!settings->packExtractionDirectory.empty())
+	{
+		result &= _generatedFilePack->extract(settings->packExtractionDirectory);
+		result &= _generatedFilePack->writeVfsOverlay(settings->packExtractionDirectory);
+	}
+
+	return result;
+}
+
+GeneratedFilePack* CodeGenUnit::getGeneratedFilePack() const noexcept
+{
+	return _generatedFilePack.get();
+}
+
+void CodeGenUnit::setProvisionalFilesEnabled(bool enabled) noexcept
+{
+	_areProvisionalFilesEnabled = enabled;
+}
+
+bool CodeGenUnit::areProvisionalFilesEnabled() const noexcept
+{
+	return _areProvisionalFilesEnabled;
+}
+
+bool CodeGenUnit::generateProvisionalCode(fs::path const& /* sourceFile */) const noexcept
+{
+	return true;
+}
+
+std::vector<fs::path> CodeGenUnit::getGeneratedFilePaths(fs::path const& /* sourceFile */) const noexcept
+{
+	return {};
+}
+
+bool CodeGenUnit::findMissingGeneratedFile(fs::path const& sourceFile, fs::path& out_missingFile) const noexcept
+{
+	for (fs::path& generatedFile : getGeneratedFilePaths(sourceFile))
+	{
+		if (!generatedFileExists(generatedFile))
+		{
+			out_missingFile = std::move(generatedFile);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FileProcessingExplanation CodeGenUnit::explainIsUpToDate(fs::path const& sourceFile) const noexcept
+{
+	FileProcessingExplanation result;
+
+	result.file		= sourceFile;
+	result.reason	= isUpToDate(sourceFile) ? EFileProcessingReason::UpToDate : EFileProcessingReason::OutOfDate;
+
+	return result;
+}
+
+bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult, StreamedEntitiesCode* streamedEntitiesCode) noexcept
+{
+	AllocationStageScope allocationStageScope(EAllocationStage::Generation);
+
 	//TODO: Should probably use std::unique_ptr here instead of a raw pointer to be exception-safe
 	CodeGenEnv* env = createCodeGenEnv();
 	
@@ -118,19 +227,31 @@ bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
 	{
 		std::vector<ICodeGenerator*> const& codeGenerators = getSortedCodeGenerators();
 
+		//Measure the code generated by each module until the post-generation step
+		_isMeasuringContributions = settings != nullptr && settings->shouldMeasureModuleContributions;
+		_moduleContributions.clear();
+
+		if (_isMeasuringContributions)
+		{
+			getGeneratedCodeSizes(_lastGeneratedCodeSizes);
+			_moduleContributions.assign(_generationModules.size(), std::vector<uint64>(_lastGeneratedCodeSizes.size(), 0u));
+		}
+
 		//Call initialGenerateCode on all ICodeGenerators first
 		initialGenerateCodeInternal(codeGenerators, *env);
 
 		if (result)
 		{
 			//Iterate over each module and entity and generate code
-			result &= foreachCodeGenEntityPair(std::bind(&CodeGenUnit::generateCodeForEntityInternal, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), *env) != ETraversalBehaviour::AbortWithFailure;
+			result &= foreachCodeGenEntityPair(std::bind(&CodeGenUnit::generateCodeForEntityInternal, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), *env, streamedEntitiesCode) != ETraversalBehaviour::AbortWithFailure;
 
 			if (result)
 			{
 				//Final call to generate code with a nullptr entity
 				finalGenerateCodeInternal(codeGenerators, *env);
 
+				_isMeasuringContributions = false;
+
 				//Post-generation step, runs only if all previous steps succeeded
 				if (result)
 				{
@@ -140,11 +261,68 @@ bool CodeGenUnit::generateCode(FileParsingResult const& parsingResult) noexcept
 		}
 	}
 
+	_isMeasuringContributions = false;
+
 	delete env;
 
 	return result;
 }
 
+bool CodeGenUnit::generateStreamedEntityCode(EntityInfo const& entity, fs::path const& parsedFile, std::vector<GeneratedCodeChunk>& out_chunks) noexcept
+{
+	AllocationStageScope allocationStageScope(EAllocationStage::Generation);
+
+	//Generators don't need the whole file context, the environment only references the parsed file
+	FileParsingResult fileParsingResult;
+	fileParsingResult.parsedFile = parsedFile;
+
+	CodeGenEnv* env = createCodeGenEnv();
+
+	//If you assert/crash here, means the createCodeGenEnv method returned nullptr
+	//Check the implementation in the CodeGenUnit you use.
+	assert(env != nullptr);
+
+	bool result = preGenerateCode(fileParsingResult, *env);
+
+	if (result)
+	{
+		std::vector<ICodeGenerator*> const& codeGenerators = getSortedCodeGenerators();
+
+		//Let generators initialize as they would for the whole file, the initial code itself is generated with the whole file
+		GeneratedCodeChunk initialCode;
+
+		initialGenerateCodeInternal(codeGenerators, *env);
+		takeGeneratedCode(initialCode);
+
+		auto visitor = std::bind(&CodeGenUnit::generateCodeForEntityInternal, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+
+		out_chunks.resize(codeGenerators.size());
+
+		for (size_t i = 0u; i < codeGenerators.size(); i++)
+		{
+			out_chunks[i].traversalResult = foreachCodeGenEntityPairInTopLevelEntity(*codeGenerators[i], entity, *env, visitor);
+
+			takeGeneratedCode(out_chunks[i]);
+		}
+	}
+
+	delete env;
+
+	return result;
+}
+
+bool CodeGenUnit::canStreamEntities() const noexcept
+{
+	if (!supportsEntityStreaming())
+	{
+		return false;
+	}
+
+	std::vector<ICodeGenerator*> const& codeGenerators = getSortedCodeGenerators();
+
+	return std::none_of(codeGenerators.cbegin(), codeGenerators.cend(), [](ICodeGenerator const* codeGenerator) { return codeGenerator->needsWholeFileContext(); });
+}
+
 bool CodeGenUnit::initialGenerateCodeInternal(std::vector<ICodeGenerator*> const& codeGenerators, CodeGenEnv& env) noexcept
 {
 	bool result = true;
@@ -158,6 +336,8 @@ bool CodeGenUnit::initialGenerateCodeInternal(std::vector<ICodeGenerator*> const
 
 		//Result will be altered when generateLambda will be called from the CodeGenUnit::initialGenerateCode override
 		initialGenerateCode(env, generateLambda);
+
+		recordContribution(*codeGenerator);
 	}
 	
 	return result;
@@ -176,6 +356,8 @@ bool CodeGenUnit::finalGenerateCodeInternal(std::vector<ICodeGenerator*> const&
 
 		//Result will be altered when generateLambda will be called from the CodeGenUnit::initialGenerateCode override
 		finalGenerateCode(env, generateLambda);
+
+		recordContribution(*codeGenerator);
 	}
 
 	return result;
@@ -246,39 +428,143 @@ bool CodeGenUnit::postGenerateCode(CodeGenEnv& /* env */) noexcept
 	//Default implementation does nothing
 	return true;
 }
-ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPair(std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor, CodeGenEnv& env) noexcept
+
+bool CodeGenUnit::supportsEntityStreaming() const noexcept
+{
+	return false;
+}
+
+void CodeGenUnit::takeGeneratedCode(GeneratedCodeChunk& /* out_chunk */) noexcept
+{
+	//Default implementation does nothing
+}
+
+void CodeGenUnit::appendGeneratedCode(GeneratedCodeChunk&& /* chunk */) noexcept
+{
+	//Default implementation does nothing
+}
+
+void CodeGenUnit::getGeneratedCodeSizes(std::vector<size_t>& out_sizes) const noexcept
+{
+	out_sizes.clear();
+}
+
+void CodeGenUnit::recordContribution(ICodeGenerator const& codeGenerator) noexcept
+{
+	if (!_isMeasuringContributions)
+	{
+		return;
+	}
+
+	std::vector<size_t> generatedCodeSizes;
+	getGeneratedCodeSizes(generatedCodeSizes);
+
+	//Property code generators contribute to the module they are attached to
+	auto moduleIt = std::find_if(_generationModules.cbegin(), _generationModules.cend(), [&codeGenerator](CodeGenModule const* codeGenModule)
+	{
+		std::vector<PropertyCodeGen*> const& propertyCodeGens = codeGenModule->getPropertyCodeGenerators();
+
+		return static_cast<ICodeGenerator const*>(codeGenModule) == &codeGenerator ||
+			   std::any_of(propertyCodeGens.cbegin(), propertyCodeGens.cend(), [&codeGenerator](PropertyCodeGen const* propertyCodeGen) { return static_cast<ICodeGenerator const*>(propertyCodeGen) == &codeGenerator; });
+	});
+
+	if (moduleIt != _generationModules.cend())
+	{
+		std::vector<uint64>& contributions = _moduleContributions[std::distance(_generationModules.cbegin(), moduleIt)];
+
+		for (size_t i = 0u; i < contributions.size() && i < generatedCodeSizes.size() && i < _lastGeneratedCodeSizes.size(); i++)
+		{
+			//Generated code is only appended during the generation
+			if (generatedCodeSizes[i] > _lastGeneratedCodeSizes[i])
+			{
+				contributions[i] += generatedCodeSizes[i] - _lastGeneratedCodeSizes[i];
+			}
+		}
+	}
+
+	_lastGeneratedCodeSizes = std::move(generatedCodeSizes);
+}
+
+std::vector<GeneratedFileContributions> CodeGenUnit::getGeneratedCodeContributions(fs::path const& sourceFile) const noexcept
+{
+	if (settings == nullptr || !settings->shouldMeasureModuleContributions)
+	{
+		return {};
+	}
+
+	std::vector<fs::path>					generatedFiles = getGeneratedFilePaths(sourceFile);
+	std::vector<GeneratedFileContributions>	result(generatedFiles.size());
+
+	for (size_t i = 0u; i < generatedFiles.size(); i++)
+	{
+		result[i].generatedFile = std::move(generatedFiles[i]);
+
+		for (size_t moduleIndex = 0u; moduleIndex < _moduleContributions.size(); moduleIndex++)
+		{
+			if (i < _moduleContributions[moduleIndex].size() && _moduleContributions[moduleIndex][i] > 0u)
+			{
+				result[i].contributions.push_back({ _generationModules[moduleIndex]->getName(), _moduleContributions[moduleIndex][i] });
+			}
+		}
+
+		std::sort(result[i].contributions.begin(), result[i].contributions.end(), [](GeneratedCodeContribution const& lhs, GeneratedCodeContribution const& rhs)
+		{
+			return lhs.size > rhs.size;
+		});
+	}
+
+	return result;
+}
+
+ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPair(std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor, CodeGenEnv& env,
+														  StreamedEntitiesCode* streamedEntitiesCode) noexcept
 {
 	assert(visitor != nullptr);
 
-	ETraversalBehaviour result;
+	ETraversalBehaviour						result;
+	std::vector<ICodeGenerator*> const&		codeGenerators = getSortedCodeGenerators();
 
 	//Call visitor on all code generators
-	for (ICodeGenerator* codeGenerator : getSortedCodeGenerators())
+	for (size_t i = 0u; i < codeGenerators.size(); i++)
 	{
+		ICodeGenerator* codeGenerator = codeGenerators[i];
+
 		for (NamespaceInfo const& namespace_ : env.getFileParsingResult()->namespaces)
 		{
-			result = foreachCodeGenEntityPairInNamespace(*codeGenerator, namespace_, env, visitor);
+			if (!appendStreamedEntityCode(namespace_, i, streamedEntitiesCode, result))
+			{
+				result = foreachCodeGenEntityPairInNamespace(*codeGenerator, namespace_, env, visitor);
+			}
 
 			HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
 		}
 
 		for (StructClassInfo const& struct_ : env.getFileParsingResult()->structs)
 		{
-			result = foreachCodeGenEntityPairInStruct(*codeGenerator, struct_, env, visitor);
+			if (!appendStreamedEntityCode(struct_, i, streamedEntitiesCode, result))
+			{
+				result = foreachCodeGenEntityPairInStruct(*codeGenerator, struct_, env, visitor);
+			}
 
 			HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
 		}
 
 		for (StructClassInfo const& class_ : env.getFileParsingResult()->classes)
 		{
-			result = foreachCodeGenEntityPairInStruct(*codeGenerator, class_, env, visitor);
+			if (!appendStreamedEntityCode(class_, i, streamedEntitiesCode, result))
+			{
+				result = foreachCodeGenEntityPairInStruct(*codeGenerator, class_, env, visitor);
+			}
 
 			HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
 		}
 
 		for (EnumInfo const& enum_ : env.getFileParsingResult()->enums)
 		{
-			result = foreachCodeGenEntityPairInEnum(*codeGenerator, enum_, env, visitor);
+			if (!appendStreamedEntityCode(enum_, i, streamedEntitiesCode, result))
+			{
+				result = foreachCodeGenEntityPairInEnum(*codeGenerator, enum_, env, visitor);
+			}
 
 			HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
 		}
@@ -296,11 +582,57 @@ ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPair(std::function<ETravers
 
 			HANDLE_NESTED_ENTITY_ITERATION_RESULT(result);
 		}
+
+		recordContribution(*codeGenerator);
 	}
 
 	return ETraversalBehaviour::Recurse;
 }
 
+ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPairInTopLevelEntity(ICodeGenerator& codeGenerator, EntityInfo const& entity, CodeGenEnv& env,
+																		  std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor) noexcept
+{
+	switch (entity.entityType)
+	{
+		case EEntityType::Namespace:
+			return foreachCodeGenEntityPairInNamespace(codeGenerator, static_cast<NamespaceInfo const&>(entity), env, visitor);
+
+		case EEntityType::Struct:
+			[[fallthrough]];
+		case EEntityType::Class:
+			return foreachCodeGenEntityPairInStruct(codeGenerator, static_cast<StructClassInfo const&>(entity), env, visitor);
+
+		case EEntityType::Enum:
+			return foreachCodeGenEntityPairInEnum(codeGenerator, static_cast<EnumInfo const&>(entity), env, visitor);
+
+		default:
+			assert(false);	//Only namespaces, structs/classes and enums can be streamed
+			return ETraversalBehaviour::AbortWithFailure;
+	}
+}
+
+bool CodeGenUnit::appendStreamedEntityCode(EntityInfo const& entity, size_t codeGeneratorIndex, StreamedEntitiesCode* streamedEntitiesCode, ETraversalBehaviour& out_result) noexcept
+{
+	if (streamedEntitiesCode == nullptr)
+	{
+		return false;
+	}
+
+	auto it = streamedEntitiesCode->find(&entity);
+
+	if (it == streamedEntitiesCode->end() || codeGeneratorIndex >= it->second.size())
+	{
+		return false;
+	}
+
+	GeneratedCodeChunk& chunk = it->second[codeGeneratorIndex];
+
+	out_result = chunk.traversalResult;
+	appendGeneratedCode(std::move(chunk));
+
+	return true;
+}
+
 ETraversalBehaviour CodeGenUnit::foreachCodeGenEntityPairInNamespace(ICodeGenerator& codeGenerator, NamespaceInfo const& namespace_, CodeGenEnv& env,
 																	 std::function<ETraversalBehaviour(ICodeGenerator&, EntityInfo const&, CodeGenEnv&, void const*)> visitor) noexcept
 {
@@ -502,6 +834,7 @@ CodeGenUnit& CodeGenUnit::operator=(CodeGenUnit const& other) noexcept
 {
 	settings = other.settings;
 	logger = other.logger;
+	_generatedFilePack = other._generatedFilePack;
 
 	//Correctly release memory if the instance is already a copy
 	if (_isCopy)
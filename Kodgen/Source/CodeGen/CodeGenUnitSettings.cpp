@@ -2,6 +2,7 @@
 
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
+#include "Kodgen/Misc/Helpers.h"
 
 using namespace kodgen;
 
@@ -12,6 +13,11 @@ bool CodeGenUnitSettings::loadSettingsValues(toml::value const& tomlData, ILogge
 		toml::value const& tomlGeneratorSettings = toml::find(tomlData, tomlSectionName);
 
 		loadOutputDirectory(tomlGeneratorSettings, logger);
+		loadShouldWriteGeneratedFilesOnlyIfChanged(tomlGeneratorSettings, logger);
+		loadShouldStreamEntities(tomlGeneratorSettings, logger);
+		loadShouldPackGeneratedFiles(tomlGeneratorSettings, logger);
+		loadPackExtractionDirectory(tomlGeneratorSettings, logger);
+		loadShouldMeasureModuleContributions(tomlGeneratorSettings, logger);
 		
 		return true;
 	}
@@ -45,6 +51,55 @@ void CodeGenUnitSettings::loadOutputDirectory(toml::value const& generationSetti
 	}
 }
 
+void CodeGenUnitSettings::loadShouldWriteGeneratedFilesOnlyIfChanged(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldWriteGeneratedFilesOnlyIfChanged", shouldWriteGeneratedFilesOnlyIfChanged, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldWriteGeneratedFilesOnlyIfChanged: " + Helpers::toString(shouldWriteGeneratedFilesOnlyIfChanged));
+	}
+}
+
+void CodeGenUnitSettings::loadShouldStreamEntities(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldStreamEntities", shouldStreamEntities, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldStreamEntities: " + Helpers::toString(shouldStreamEntities));
+	}
+}
+
+void CodeGenUnitSettings::loadShouldPackGeneratedFiles(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldPackGeneratedFiles", shouldPackGeneratedFiles, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldPackGeneratedFiles: " + Helpers::toString(shouldPackGeneratedFiles));
+	}
+}
+
+void CodeGenUnitSettings::loadShouldMeasureModuleContributions(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(generationSettings, "shouldMeasureModuleContributions", shouldMeasureModuleContributions, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldMeasureModuleContributions: " + Helpers::toString(shouldMeasureModuleContributions));
+	}
+}
+
+void CodeGenUnitSettings::loadPackExtractionDirectory(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	std::string loadedPackExtractionDirectory;
+
+	if (TomlUtility::updateSetting(generationSettings, "packExtractionDirectory", loadedPackExtractionDirectory, logger) && !loadedPackExtractionDirectory.empty())
+	{
+		std::error_code error;
+
+		packExtractionDirectory = fs::absolute(fs::path(loadedPackExtractionDirectory).make_preferred(), error);
+
+		if (logger != nullptr)
+		{
+			logger->log("[TOML] Load pack extraction directory: " + packExtractionDirectory.string());
+		}
+	}
+}
+
 fs::path const& CodeGenUnitSettings::getOutputDirectory() const noexcept
 {
 	return _outputDirectory;
@@ -0,0 +1,41 @@
+#include "Kodgen/CodeGen/EFileProcessingReason.h"
+
+using namespace kodgen;
+
+std::string kodgen::toString(EFileProcessingReason reason) noexcept
+{
+	std::string result;
+
+	switch (reason)
+	{
+		case EFileProcessingReason::UpToDate:
+			result = "UpToDate";
+			break;
+
+		case EFileProcessingReason::ForcedRegeneration:
+			result = "ForcedRegeneration";
+			break;
+
+		case EFileProcessingReason::MissingGeneratedFile:
+			result = "MissingGeneratedFile";
+			break;
+
+		case EFileProcessingReason::OutdatedGeneratedFile:
+			result = "OutdatedGeneratedFile";
+			break;
+
+		case EFileProcessingReason::OutOfDate:
+			result = "OutOfDate";
+			break;
+
+		case EFileProcessingReason::UnchangedSinceLastRun:
+			result = "UnchangedSinceLastRun";
+			break;
+
+		case EFileProcessingReason::ChangedSinceLastRun:
+			result = "ChangedSinceLastRun";
+			break;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "Kodgen/CodeGen/EntityStreamingQueue.h"
+
+#include "Kodgen/CodeGen/CodeGenUnit.h"
+
+using namespace kodgen;
+
+void EntityStreamingQueue::push(EntityInfo const& entity) noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_pendingEntities.push_back(&entity);
+}
+
+bool EntityStreamingQueue::hasPendingEntities() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return !_pendingEntities.empty();
+}
+
+bool EntityStreamingQueue::generateNext(CodeGenUnit& codeGenUnit, fs::path const& parsedFile) noexcept
+{
+	EntityInfo const* entity;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_pendingEntities.empty())
+		{
+			return false;
+		}
+
+		entity = _pendingEntities.front();
+		_pendingEntities.pop_front();
+		_runningGenerationCount++;
+	}
+
+	std::vector<GeneratedCodeChunk>	chunks;
+	bool							success = codeGenUnit.generateStreamedEntityCode(*entity, parsedFile, chunks);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		//Entities without code are traversed again when the whole file is generated
+		if (success)
+		{
+			_generatedCode.emplace(entity, std::move(chunks));
+		}
+
+		_runningGenerationCount--;
+	}
+
+	_generationEndCondition.notify_all();
+
+	return true;
+}
+
+void EntityStreamingQueue::waitForRunningGenerations() noexcept
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	_generationEndCondition.wait(lock, [this]() { return _runningGenerationCount == 0u; });
+}
+
+StreamedEntitiesCode EntityStreamingQueue::takeGeneratedCode() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return std::move(_generatedCode);
+}
\ No newline at end of file
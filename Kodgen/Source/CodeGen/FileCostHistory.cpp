@@ -0,0 +1,70 @@
+#include "Kodgen/CodeGen/FileCostHistory.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace kodgen;
+
+bool FileCostHistory::load(fs::path const& outputDirectory) noexcept
+{
+	_costs.clear();
+
+	//A missing or outdated history simply makes all costs unknown
+	std::ifstream	history(outputDirectory / _historyFilename);
+	std::string		line;
+
+	if (!history.is_open() || !std::getline(history, line) || line != _historyHeader)
+	{
+		return false;
+	}
+
+	while (std::getline(history, line))
+	{
+		std::istringstream	lineStream(line);
+		float				cost;
+
+		if (lineStream >> cost)
+		{
+			std::string path;
+
+			//The path is the remaining of the line, it may contain spaces
+			lineStream.get();
+			std::getline(lineStream, path);
+
+			_costs[std::move(path)] = cost;
+		}
+	}
+
+	return true;
+}
+
+bool FileCostHistory::save(fs::path const& outputDirectory) const noexcept
+{
+	std::ofstream history(outputDirectory / _historyFilename, std::ios::trunc);
+
+	if (!history.is_open())
+	{
+		return false;
+	}
+
+	history << _historyHeader << "\n";
+
+	for (auto const& [path, cost] : _costs)
+	{
+		history << cost << " " << path << "\n";
+	}
+
+	return history.good();
+}
+
+float FileCostHistory::getCost(fs::path const& file) const noexcept
+{
+	auto it = _costs.find(file.string());
+
+	return (it != _costs.cend()) ? it->second : -1.0f;
+}
+
+void FileCostHistory::setCost(fs::path const& file, float cost) noexcept
+{
+	_costs[file.string()] = cost;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "Kodgen/CodeGen/FileProcessingExplanation.h"
+
+using namespace kodgen;
+
+bool FileProcessingExplanation::isProcessed() const noexcept
+{
+	return reason != EFileProcessingReason::UpToDate && reason != EFileProcessingReason::UnchangedSinceLastRun;
+}
+
+std::string FileProcessingExplanation::toString() const noexcept
+{
+	std::string result = file.string() + (isProcessed() ? ": scheduled (" : ": skipped (");
+
+	switch (reason)
+	{
+		case EFileProcessingReason::UpToDate:
+			result += "generated files are up-to-date";
+			break;
+
+		case EFileProcessingReason::ForcedRegeneration:
+			result += "generated files are up-to-date but regeneration is forced";
+			break;
+
+		case EFileProcessingReason::MissingGeneratedFile:
+			result += "missing generated file " + generatedFile.string();
+			break;
+
+		case EFileProcessingReason::OutdatedGeneratedFile:
+			result += "source file is newer than generated file " + generatedFile.string();
+			break;
+
+		case EFileProcessingReason::OutOfDate:
+			result += "generated code is out of date";
+			break;
+
+		case EFileProcessingReason::UnchangedSinceLastRun:
+			result += "git index and stat data unchanged since last run";
+			break;
+
+		case EFileProcessingReason::ChangedSinceLastRun:
+			result += "git index or stat data changed since last run";
+			break;
+	}
+
+	return result + ")";
+}
\ No newline at end of file
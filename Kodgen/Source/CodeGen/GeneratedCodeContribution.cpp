@@ -0,0 +1,15 @@
+#include "Kodgen/CodeGen/GeneratedCodeContribution.h"
+
+using namespace kodgen;
+
+uint64 GeneratedFileContributions::getTotalSize() const noexcept
+{
+	uint64 result = 0u;
+
+	for (GeneratedCodeContribution const& contribution : contributions)
+	{
+		result += contribution.size;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -1,27 +1,104 @@
 #include "Kodgen/CodeGen/GeneratedFile.h"
 
+#include "Kodgen/CodeGen/GeneratedFilePack.h"
+#include "Kodgen/Misc/AllocationTracker.h"
+
 using namespace kodgen;
 
-GeneratedFile::GeneratedFile(fs::path&& generatedFilePath, fs::path const& sourceFilePath) noexcept:
+std::atomic<uint64> GeneratedFile::_totalGeneratedBytes = 0u;
+
+GeneratedFile::GeneratedFile(fs::path&& generatedFilePath, fs::path const& sourceFilePath, bool writeOnlyIfChanged, GeneratedFilePack* pack) noexcept:
 	_path{std::forward<fs::path>(generatedFilePath)},
 	_sourceFilePath{sourceFilePath},
-	_streamToFile(_path.string(), std::ios::out | std::ios::trunc)
+	_writeOnlyIfChanged{writeOnlyIfChanged},
+	_pack{pack}
 {
+	AllocationStageScope allocationStageScope(EAllocationStage::FileWriting);
+
+	if (!_writeOnlyIfChanged && _pack == nullptr)
+	{
+		_streamToFile.open(_path.string(), std::ios::out | std::ios::trunc);
+	}
 }
 
 GeneratedFile::~GeneratedFile() noexcept
 {
+	AllocationStageScope allocationStageScope(EAllocationStage::FileWriting);
+
+	if (_pack != nullptr)
+	{
+		_pack->writeFile(_path, _sourceFilePath, _bufferedContent.str());
+	}
+	else if (_writeOnlyIfChanged)
+	{
+		flushBufferedContentIfChanged();
+	}
+	else
+	{
+		_streamToFile.close();
+	}
+}
+
+std::ostream& GeneratedFile::getStream() noexcept
+{
+	return (_writeOnlyIfChanged || _pack != nullptr) ? static_cast<std::ostream&>(_bufferedContent) : _streamToFile;
+}
+
+void GeneratedFile::flushBufferedContentIfChanged() noexcept
+{
+	std::string		newContent = _bufferedContent.str();
+	std::ifstream	existingFile(_path, std::ios::in | std::ios::binary);
+
+	if (existingFile.is_open())
+	{
+		std::ostringstream existingContent;
+		existingContent << existingFile.rdbuf();
+
+		if (existingContent.str() == newContent)
+		{
+			existingFile.close();
+
+			//The file must still look newer than its source file, otherwise it would be considered outdated (and the source file reparsed) on every run
+			if (!_sourceFilePath.empty())
+			{
+				std::error_code		sourceErrorCode;
+				std::error_code		generatedErrorCode;
+				fs::file_time_type	sourceLastWriteTime		= fs::last_write_time(_sourceFilePath, sourceErrorCode);
+				fs::file_time_type	generatedLastWriteTime	= fs::last_write_time(_path, generatedErrorCode);
+
+				if (!sourceErrorCode && !generatedErrorCode && generatedLastWriteTime <= sourceLastWriteTime)
+				{
+					fs::last_write_time(_path, fs::file_time_type::clock::now(), generatedErrorCode);
+				}
+			}
+
+			return;
+		}
+
+		existingFile.close();
+	}
+
+	_streamToFile.open(_path.string(), std::ios::out | std::ios::trunc | std::ios::binary);
+	_streamToFile << newContent;
 	_streamToFile.close();
 }
 
 void GeneratedFile::writeLine(std::string const& line) noexcept
 {
-	_streamToFile << line << "\n";
+	AllocationStageScope allocationStageScope(EAllocationStage::FileWriting);
+
+	_totalGeneratedBytes.fetch_add(line.size() + 1u, std::memory_order_relaxed);
+
+	getStream() << line << "\n";
 }
 
 void GeneratedFile::writeLine(std::string&& line) noexcept
 {
-	_streamToFile << std::forward<std::string>(line) << "\n";
+	AllocationStageScope allocationStageScope(EAllocationStage::FileWriting);
+
+	_totalGeneratedBytes.fetch_add(line.size() + 1u, std::memory_order_relaxed);
+
+	getStream() << std::forward<std::string>(line) << "\n";
 }
 
 void GeneratedFile::writeLines(std::string const& line) noexcept
@@ -62,4 +139,9 @@ fs::path const& GeneratedFile::getPath() const noexcept
 fs::path const& GeneratedFile::getSourceFilePath() const noexcept
 {
 	return _sourceFilePath;
+}
+
+uint64 GeneratedFile::getTotalGeneratedBytes() noexcept
+{
+	return _totalGeneratedBytes.load(std::memory_order_relaxed);
 }
\ No newline at end of file
@@ -0,0 +1,481 @@
+#include "Kodgen/CodeGen/GeneratedFilePack.h"
+
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <iterator>
+
+using namespace kodgen;
+
+GeneratedFilePack::GeneratedFilePack(fs::path outputDirectory) noexcept:
+	_outputDirectory{std::move(outputDirectory)}
+{
+}
+
+std::string GeneratedFilePack::getKey(fs::path const& generatedFile) const noexcept
+{
+	fs::path relativePath = generatedFile.lexically_normal().lexically_relative(_outputDirectory.lexically_normal());
+
+	//Files outside of the output directory are keyed by their full path
+	return (relativePath.empty() || *relativePath.begin() == "..") ? generatedFile.generic_string() : relativePath.generic_string();
+}
+
+bool GeneratedFilePack::load() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_entries.clear();
+	_isDirty = false;
+
+	//A missing or outdated pack simply makes all files regenerate
+	std::ifstream	pack(_outputDirectory / packFilename, std::ios::in | std::ios::binary);
+	std::string		line;
+	size_t			entryCount;
+
+	if (!pack.is_open() || !std::getline(pack, line) || line != _packHeader || !std::getline(pack, line))
+	{
+		return false;
+	}
+
+	std::istringstream(line) >> entryCount;
+
+	std::vector<std::pair<std::string, size_t>> index;
+	index.reserve(entryCount);
+
+	for (size_t i = 0u; i < entryCount; i++)
+	{
+		std::istringstream	lineStream;
+		size_t				size;
+		Entry				entry;
+		std::string			path;
+		std::string			sourceFile;
+
+		if (!std::getline(pack, line) || !std::getline(pack, sourceFile))
+		{
+			_entries.clear();
+			return false;
+		}
+
+		lineStream.str(line);
+
+		if (!(lineStream >> size >> entry.lastWriteTime))
+		{
+			_entries.clear();
+			return false;
+		}
+
+		//The path is the remaining of the line, it may contain spaces
+		lineStream.get();
+		std::getline(lineStream, path);
+
+		entry.sourceFile = std::move(sourceFile);
+
+		index.emplace_back(path, size);
+		_entries.emplace(std::move(path), std::move(entry));
+	}
+
+	//Contents are stored after the index, in index order
+	for (auto& [path, size] : index)
+	{
+		std::string& content = _entries[path].content;
+
+		content.resize(size);
+
+		if (!pack.read(content.data(), static_cast<std::streamsize>(size)))
+		{
+			_entries.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GeneratedFilePack::save() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (!_isDirty)
+	{
+		return true;
+	}
+
+	std::ofstream pack(_outputDirectory / packFilename, std::ios::out | std::ios::trunc | std::ios::binary);
+
+	if (!pack.is_open())
+	{
+		return false;
+	}
+
+	pack << _packHeader << "\n" << _entries.size() << "\n";
+
+	for (auto const& [path, entry] : _entries)
+	{
+		pack << entry.content.size() << " " << entry.lastWriteTime << " " << path << "\n"
+			 << entry.sourceFile.string() << "\n";
+	}
+
+	for (auto const& [path, entry] : _entries)
+	{
+		pack.write(entry.content.data(), static_cast<std::streamsize>(entry.content.size()));
+	}
+
+	_isDirty = !pack.good();
+
+	return !_isDirty;
+}
+
+void GeneratedFilePack::writeFile(fs::path const& generatedFile, fs::path const& sourceFile, std::string&& content) noexcept
+{
+	std::string key = getKey(generatedFile);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	Entry& entry = _entries[std::move(key)];
+
+	if (entry.content != content)
+	{
+		entry.content	= std::forward<std::string>(content);
+		entry.isDirty	= true;
+	}
+
+	//The write time is updated even if the content didn't change so that the file is considered up-to-date with its source
+	entry.sourceFile	= sourceFile;
+	entry.lastWriteTime	= static_cast<int64>(fs::file_time_type::clock::now().time_since_epoch().count());
+	_isDirty			= true;
+}
+
+void GeneratedFilePack::appendToFile(fs::path const& generatedFile, fs::path const& sourceFile, std::string const& content) noexcept
+{
+	std::string key = getKey(generatedFile);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto [it, isInserted] = _entries.try_emplace(std::move(key));
+
+	//A file which has never been generated must look older than any source file
+	if (isInserted)
+	{
+		it->second.sourceFile		= sourceFile;
+		it->second.lastWriteTime	= static_cast<int64>(fs::file_time_type::min().time_since_epoch().count());
+	}
+
+	it->second.content	+= content;
+	it->second.isDirty	|= isInserted || !content.empty();
+	_isDirty			= true;
+}
+
+size_t GeneratedFilePack::removeOrphanedFiles() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	size_t removedCount = 0u;
+
+	for (auto it = _entries.begin(); it != _entries.end(); )
+	{
+		if (!it->second.sourceFile.empty() && !fs::exists(it->second.sourceFile))
+		{
+			_removedEntries.push_back(it->first);
+
+			it = _entries.erase(it);
+			removedCount++;
+		}
+		else
+		{
+			it++;
+		}
+	}
+
+	_isDirty |= (removedCount != 0u);
+
+	return removedCount;
+}
+
+bool GeneratedFilePack::getLastWriteTime(fs::path const& generatedFile, fs::file_time_type& out_lastWriteTime) const noexcept
+{
+	std::string key = getKey(generatedFile);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto it = _entries.find(key);
+
+	if (it == _entries.cend())
+	{
+		return false;
+	}
+
+	out_lastWriteTime = fs::file_time_type(fs::file_time_type::duration(it->second.lastWriteTime));
+
+	return true;
+}
+
+/**
+*	@brief Find the files included by #include, #include_next and #import directives.
+*
+*	@param content				Content of the including file.
+*	@param out_includedFiles	Included files, paired with true if they are quoted (searched from the including file directory first).
+*/
+static void findIncludeDirectives(std::string const& content, std::vector<std::pair<std::string, bool>>& out_includedFiles) noexcept
+{
+	std::string::size_type pos = 0u;
+
+	while (pos < content.size())
+	{
+		std::string::size_type lineEnd = content.find('\n', pos);
+
+		if (lineEnd == std::string::npos)
+		{
+			lineEnd = content.size();
+		}
+
+		std::string::size_type i = content.find_first_not_of(" \t", pos);
+
+		if (i < lineEnd && content[i] == '#')
+		{
+			i = content.find_first_not_of(" \t", i + 1u);
+
+			if (i < lineEnd && (content.compare(i, 7u, "include") == 0 || content.compare(i, 6u, "import") == 0))
+			{
+				i = content.find_first_of("\"<", i);
+
+				if (i < lineEnd)
+				{
+					char					closingDelimiter	= (content[i] == '"') ? '"' : '>';
+					std::string::size_type	end					= content.find(closingDelimiter, i + 1u);
+
+					if (end < lineEnd)
+					{
+						out_includedFiles.emplace_back(content.substr(i + 1u, end - i - 1u), closingDelimiter == '"');
+					}
+				}
+			}
+		}
+
+		pos = lineEnd + 1u;
+	}
+}
+
+std::vector<std::pair<std::string, std::string>> GeneratedFilePack::getUnsavedFiles(fs::path const& sourceFile, std::vector<fs::path> const& includeDirectories) const noexcept
+{
+	std::vector<std::pair<std::string, std::string>>	result;
+	std::vector<fs::path>								toScan			= { sourceFile.lexically_normal() };
+	std::set<fs::path>									visitedFiles	= { toScan.front() };
+	std::vector<std::pair<std::string, bool>>			includedFiles;
+	std::error_code										errorCode;
+
+	//Only the packed files reachable from the source file are copied, copying the whole pack for each parsed file would be quadratic
+	while (!toScan.empty())
+	{
+		fs::path	file = std::move(toScan.back());
+		std::string	content;
+		bool		isPacked;
+
+		toScan.pop_back();
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto it = _entries.find(getKey(file));
+
+			isPacked = (it != _entries.cend());
+
+			if (isPacked)
+			{
+				content = it->second.content;
+			}
+		}
+
+		if (isPacked)
+		{
+			result.emplace_back(file.string(), content);
+		}
+		else
+		{
+			std::ifstream stream(file, std::ios::in | std::ios::binary);
+
+			if (!stream.is_open())
+			{
+				continue;
+			}
+
+			content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+
+		includedFiles.clear();
+		findIncludeDirectives(content, includedFiles);
+
+		for (auto const& [includedFile, isQuoted] : includedFiles)
+		{
+			//Resolve the include as the preprocessor would, the first directory containing the file wins
+			fs::path resolvedFile;
+
+			auto tryDirectory = [&](fs::path const& directory) -> bool
+			{
+				fs::path candidate = (directory / includedFile).lexically_normal();
+
+				bool exists;
+
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+
+					exists = _entries.find(getKey(candidate)) != _entries.cend();
+				}
+
+				if (exists || fs::is_regular_file(candidate, errorCode))
+				{
+					resolvedFile = std::move(candidate);
+					return true;
+				}
+
+				return false;
+			};
+
+			if (!(isQuoted && tryDirectory(file.parent_path())))
+			{
+				for (fs::path const& directory : includeDirectories)
+				{
+					if (tryDirectory(directory))
+					{
+						break;
+					}
+				}
+			}
+
+			if (!resolvedFile.empty() && visitedFiles.insert(resolvedFile).second)
+			{
+				toScan.push_back(std::move(resolvedFile));
+			}
+		}
+	}
+
+	return result;
+}
+
+bool GeneratedFilePack::extract(fs::path const& extractionDirectory) noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::error_code	errorCode;
+	bool			success = true;
+
+	for (std::string const& path : _removedEntries)
+	{
+		fs::remove(extractionDirectory / fs::path(path), errorCode);
+	}
+
+	_removedEntries.clear();
+
+	for (auto& [path, entry] : _entries)
+	{
+		fs::path extractedFile = extractionDirectory / fs::path(path);
+
+		//Files loaded from the pack are not dirty, but their extracted copy may have been deleted
+		if (!entry.isDirty && fs::exists(extractedFile, errorCode))
+		{
+			continue;
+		}
+
+		fs::create_directories(extractedFile.parent_path(), errorCode);
+
+		std::ofstream file(extractedFile, std::ios::out | std::ios::trunc | std::ios::binary);
+
+		file.write(entry.content.data(), static_cast<std::streamsize>(entry.content.size()));
+
+		//Failed files are extracted again next time
+		entry.isDirty = !file.good();
+		success &= !entry.isDirty;
+	}
+
+	return success;
+}
+
+/**
+*	@brief Quote a string for a YAML file.
+*
+*	@param str The string to quote.
+*
+*	@return The double-quoted and escaped string.
+*/
+static std::string quoteYamlString(std::string const& str) noexcept
+{
+	std::string result = "\"";
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			result += '\\';
+		}
+
+		result += c;
+	}
+
+	return result + "\"";
+}
+
+bool GeneratedFilePack::writeVfsOverlay(fs::path const& extractionDirectory) const noexcept
+{
+	std::ostringstream overlay;
+
+	overlay << "{\n"
+			<< "\t\"version\": 0,\n"
+			<< "\t\"roots\": [\n"
+			<< "\t\t{\n"
+			<< "\t\t\t\"type\": \"directory\",\n"
+			<< "\t\t\t\"name\": " << quoteYamlString(_outputDirectory.generic_string()) << ",\n"
+			<< "\t\t\t\"contents\": [\n";
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		bool isFirstEntry = true;
+
+		for (auto const& [path, entry] : _entries)
+		{
+			if (!isFirstEntry)
+			{
+				overlay << ",\n";
+			}
+
+			overlay << "\t\t\t\t{ \"type\": \"file\", \"name\": " << quoteYamlString(path)
+					<< ", \"external-contents\": " << quoteYamlString((extractionDirectory / fs::path(path)).generic_string()) << " }";
+
+			isFirstEntry = false;
+		}
+	}
+
+	overlay << "\n\t\t\t]\n"
+			<< "\t\t}\n"
+			<< "\t]\n"
+			<< "}\n";
+
+	//Rewriting an identical overlay would invalidate the builds depending on it
+	std::string		newContent = overlay.str();
+	fs::path		overlayPath = _outputDirectory / vfsOverlayFilename;
+	std::ifstream	existingFile(overlayPath, std::ios::in | std::ios::binary);
+
+	if (existingFile.is_open())
+	{
+		std::ostringstream existingContent;
+		existingContent << existingFile.rdbuf();
+
+		if (existingContent.str() == newContent)
+		{
+			return true;
+		}
+
+		existingFile.close();
+	}
+
+	std::ofstream file(overlayPath, std::ios::out | std::ios::trunc | std::ios::binary);
+
+	file << newContent;
+
+	return file.good();
+}
+
+fs::path const& GeneratedFilePack::getOutputDirectory() const noexcept
+{
+	return _outputDirectory;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "Kodgen/CodeGen/GeneratedHeaderProfiler.h"
+
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+
+#include "Kodgen/Parsing/ParsingSettings.h"
+
+using namespace kodgen;
+
+std::string GeneratedHeaderCost::toString(size_t contributorCount) const noexcept
+{
+	std::string result = generatedFile.string() + ": " + std::to_string(parseDuration) + "s, " + std::to_string(memory / 1024u) + " KiB";
+
+	if (errorCount != 0u)
+	{
+		result += ", " + std::to_string(errorCount) + " error(s)";
+	}
+
+	for (size_t i = 0u; i < contributions.size() && i < contributorCount; i++)
+	{
+		result += ((i == 0u) ? " | " : ", ") + contributions[i].moduleName + " " + std::to_string(contributions[i].size) + " bytes";
+	}
+
+	return result;
+}
+
+std::vector<char const*> GeneratedHeaderProfiler::getCompilationArguments(ParsingSettings const& parsingSettings) noexcept
+{
+	std::string const			parsingMacroArgument	= "-D" + ParsingSettings::parsingMacro;
+	std::vector<char const*>	result;
+
+	for (char const* argument : parsingSettings.getCompilationArguments())
+	{
+		if (argument != parsingMacroArgument)
+		{
+			result.push_back(argument);
+		}
+	}
+
+	return result;
+}
+
+bool GeneratedHeaderProfiler::profileFile(CXIndex clangIndex, std::vector<char const*> const& compilationArguments, GeneratedHeaderCost& inout_cost) const noexcept
+{
+	CXTranslationUnit	translationUnit	= nullptr;
+	auto				start			= std::chrono::high_resolution_clock::now();
+
+	//Keep function bodies and template instantiations, they are part of the compilation cost
+	CXErrorCode errorCode = clang_parseTranslationUnit2(clangIndex, inout_cost.generatedFile.string().c_str(), compilationArguments.data(), static_cast<int32>(compilationArguments.size()),
+														nullptr, 0, CXTranslationUnit_KeepGoing, &translationUnit);
+
+	inout_cost.parseDuration = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+
+	if (errorCode != CXError_Success)
+	{
+		if (logger != nullptr)
+		{
+			logger->log("Failed to profile the generated file " + inout_cost.generatedFile.string() + ": libclang error code " + std::to_string(errorCode) + ".", ILogger::ELogSeverity::Warning);
+		}
+
+		return false;
+	}
+
+	CXTUResourceUsage resourceUsage = clang_getCXTUResourceUsage(translationUnit);
+
+	for (uint32 i = 0u; i < resourceUsage.numEntries; i++)
+	{
+		if (resourceUsage.entries[i].kind >= CXTUResourceUsage_MEMORY_IN_BYTES_BEGIN && resourceUsage.entries[i].kind <= CXTUResourceUsage_MEMORY_IN_BYTES_END)
+		{
+			inout_cost.memory += resourceUsage.entries[i].amount;
+		}
+	}
+
+	clang_disposeCXTUResourceUsage(resourceUsage);
+
+	for (uint32 i = 0u; i < clang_getNumDiagnostics(translationUnit); i++)
+	{
+		CXDiagnostic diagnostic = clang_getDiagnostic(translationUnit, i);
+
+		if (clang_getDiagnosticSeverity(diagnostic) >= CXDiagnostic_Error)
+		{
+			inout_cost.errorCount++;
+		}
+
+		clang_disposeDiagnostic(diagnostic);
+	}
+
+	clang_disposeTranslationUnit(translationUnit);
+
+	return true;
+}
+
+std::vector<GeneratedHeaderCost> GeneratedHeaderProfiler::profile(ParsingSettings const& parsingSettings, std::vector<GeneratedFileContributions> const& generatedFiles) const noexcept
+{
+	std::vector<GeneratedHeaderCost>		costs;
+	std::unordered_map<std::string, size_t>	fileIndices;
+
+	//Files generated by several iterations only keep their last contributions
+	for (GeneratedFileContributions const& generatedFile : generatedFiles)
+	{
+		auto [it, inserted] = fileIndices.emplace(generatedFile.generatedFile.string(), costs.size());
+
+		if (inserted)
+		{
+			costs.emplace_back().generatedFile = generatedFile.generatedFile;
+		}
+
+		costs[it->second].contributions = generatedFile.contributions;
+	}
+
+	std::vector<GeneratedHeaderCost>	result;
+	std::vector<char const*> const		compilationArguments	= getCompilationArguments(parsingSettings);
+	CXIndex								clangIndex				= clang_createIndex(0, 0);
+
+	for (GeneratedHeaderCost& cost : costs)
+	{
+		if (fs::is_regular_file(cost.generatedFile) && profileFile(clangIndex, compilationArguments, cost))
+		{
+			result.emplace_back(std::move(cost));
+		}
+	}
+
+	clang_disposeIndex(clangIndex);
+
+	std::sort(result.begin(), result.end(), [](GeneratedHeaderCost const& lhs, GeneratedHeaderCost const& rhs)
+	{
+		return lhs.parseDuration > rhs.parseDuration;
+	});
+
+	if (result.size() > reportedFileCount)
+	{
+		result.resize(reportedFileCount);
+	}
+
+	if (logger != nullptr)
+	{
+		logger->log("Most expensive generated files (" + std::to_string(result.size()) + " of " + std::to_string(fileIndices.size()) + "):", ILogger::ELogSeverity::Info);
+
+		for (GeneratedHeaderCost const& cost : result)
+		{
+			logger->log("    " + cost.toString(reportedContributorCount), ILogger::ELogSeverity::Info);
+		}
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,428 @@
+#include "Kodgen/CodeGen/GitIndexChangeDetector.h"
+
+#include <fstream>
+#include <algorithm>	//std::any_of
+#include <sstream>
+#include <iterator>	//std::istreambuf_iterator
+
+using namespace kodgen;
+
+namespace
+{
+	/**
+	*	@brief Read a whole file content.
+	*
+	*	@param path			Path to the file.
+	*	@param out_content	Read content.
+	*
+	*	@return true if the file was successfully read, else false.
+	*/
+	bool readFile(fs::path const& path, std::string& out_content) noexcept
+	{
+		std::ifstream stream(path, std::ios::binary);
+
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		out_content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+		return !stream.bad();
+	}
+
+	/**
+	*	@brief Read a big endian unsigned integer.
+	*
+	*	@param data		Pointer to the first byte of the integer.
+	*	@param size		Size of the integer in bytes.
+	*
+	*	@return The read integer.
+	*/
+	uint32 readBigEndian(char const* data, size_t size) noexcept
+	{
+		uint32 result = 0u;
+
+		for (size_t i = 0u; i < size; i++)
+		{
+			result = (result << 8u) | static_cast<unsigned char>(data[i]);
+		}
+
+		return result;
+	}
+}
+
+bool GitIndexChangeDetector::findRepository(fs::path const& path, fs::path& out_workingTreeRoot, fs::path& out_gitDirectory) noexcept
+{
+	std::error_code errorCode;
+	fs::path		current = fs::canonical(path, errorCode);
+
+	if (errorCode)
+	{
+		return false;
+	}
+
+	while (true)
+	{
+		fs::path dotGit = current / ".git";
+
+		if (fs::is_directory(dotGit, errorCode))
+		{
+			out_workingTreeRoot	= current;
+			out_gitDirectory	= std::move(dotGit);
+
+			return true;
+		}
+		else if (fs::is_regular_file(dotGit, errorCode))
+		{
+			//Worktrees and submodules use a .git file containing "gitdir: <path>"
+			std::string content;
+
+			if (readFile(dotGit, content) && content.compare(0, 8, "gitdir: ") == 0)
+			{
+				content.erase(content.find_last_not_of("\r\n") + 1);
+
+				fs::path gitDirectory = content.substr(8);
+
+				out_workingTreeRoot	= current;
+				out_gitDirectory	= gitDirectory.is_absolute() ? gitDirectory : current / gitDirectory;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		if (!current.has_parent_path() || current.parent_path() == current)
+		{
+			return false;
+		}
+
+		current = current.parent_path();
+	}
+}
+
+size_t GitIndexChangeDetector::getHashSize(fs::path const& gitDirectory) noexcept
+{
+	std::string config;
+
+	//Worktrees share the config of the main repository, which is not read here: SHA-1 repositories are the vast majority
+	if (readFile(gitDirectory / "config", config))
+	{
+		std::istringstream	stream(config);
+		std::string			line;
+
+		while (std::getline(stream, line))
+		{
+			if (line.find("objectformat") != std::string::npos && line.find("sha256") != std::string::npos)
+			{
+				return 32u;
+			}
+		}
+	}
+
+	return 20u;
+}
+
+bool GitIndexChangeDetector::parseIndex(std::string const& data, size_t hashSize, std::unordered_map<std::string, std::string>& out_indexBlobHashes) noexcept
+{
+	static constexpr char const	hexDigits[]			= "0123456789abcdef";
+	static constexpr size_t		headerSize			= 12u;
+	static constexpr size_t		statDataSize		= 40u;
+	static constexpr uint32		extendedFlag		= 0x4000u;
+	static constexpr uint32		stageMask			= 0x3000u;
+	static constexpr uint32		nameLengthMask		= 0x0FFFu;
+
+	if (data.size() < headerSize || data.compare(0, 4, "DIRC") != 0)
+	{
+		return false;
+	}
+
+	uint32 version		= readBigEndian(data.data() + 4, 4u);
+	uint32 entryCount	= readBigEndian(data.data() + 8, 4u);
+
+	if (version < 2u || version > 4u)
+	{
+		return false;
+	}
+
+	size_t		offset			= headerSize;
+	std::string	previousName;
+
+	out_indexBlobHashes.reserve(entryCount);
+
+	for (uint32 i = 0u; i < entryCount; i++)
+	{
+		size_t entryStart	= offset;
+		size_t flagsOffset	= offset + statDataSize + hashSize;
+
+		if (flagsOffset + 2u > data.size())
+		{
+			return false;
+		}
+
+		uint32 flags = readBigEndian(data.data() + flagsOffset, 2u);
+		offset = flagsOffset + 2u;
+
+		if (version >= 3u && (flags & extendedFlag))
+		{
+			offset += 2u;
+		}
+
+		std::string name;
+
+		if (version == 4u)
+		{
+			//Name is prefix compressed: remove N bytes from the previous name and append a NUL terminated suffix
+			size_t removedLength = 0u;
+
+			for (bool isFirstByte = true; ; isFirstByte = false)
+			{
+				if (offset >= data.size())
+				{
+					return false;
+				}
+
+				unsigned char byte = static_cast<unsigned char>(data[offset++]);
+
+				removedLength = (isFirstByte) ? (byte & 0x7Fu) : (((removedLength + 1u) << 7u) | (byte & 0x7Fu));
+
+				if (!(byte & 0x80u))
+				{
+					break;
+				}
+			}
+
+			size_t suffixEnd = data.find('\0', offset);
+
+			if (removedLength > previousName.size() || suffixEnd == std::string::npos)
+			{
+				return false;
+			}
+
+			name	= previousName.substr(0u, previousName.size() - removedLength) + data.substr(offset, suffixEnd - offset);
+			offset	= suffixEnd + 1u;
+		}
+		else
+		{
+			size_t nameLength	= flags & nameLengthMask;
+			size_t nameEnd		= (nameLength < nameLengthMask) ? offset + nameLength : data.find('\0', offset);
+
+			if (nameEnd == std::string::npos || nameEnd > data.size())
+			{
+				return false;
+			}
+
+			name = data.substr(offset, nameEnd - offset);
+
+			//Entries are padded with 1 to 8 NUL bytes to keep a size multiple of 8
+			offset = entryStart + ((nameEnd - entryStart + 8u) & ~size_t(7u));
+		}
+
+		//Unmerged entries don't have a meaningful blob hash: leave them out so that they are always considered changed
+		if ((flags & stageMask) == 0u)
+		{
+			std::string blobHash;
+			blobHash.reserve(hashSize * 2u);
+
+			for (size_t j = 0u; j < hashSize; j++)
+			{
+				unsigned char byte = static_cast<unsigned char>(data[entryStart + statDataSize + j]);
+
+				blobHash.push_back(hexDigits[byte >> 4u]);
+				blobHash.push_back(hexDigits[byte & 0x0Fu]);
+			}
+
+			out_indexBlobHashes[name] = std::move(blobHash);
+		}
+		else
+		{
+			out_indexBlobHashes[name].clear();
+		}
+
+		previousName = std::move(name);
+	}
+
+	return true;
+}
+
+std::string GitIndexChangeDetector::getIndexKey(fs::path const& file, Repository const*& out_repository) const noexcept
+{
+	fs::path	normalizedFile = file.lexically_normal();
+	std::string	result;
+
+	out_repository = nullptr;
+
+	//Nested repositories are inside their parent working tree: the innermost repository is the one with the shortest relative path
+	for (Repository const& repository : _repositories)
+	{
+		fs::path relativePath = normalizedFile.lexically_relative(repository.workingTreeRoot);
+
+		if (!relativePath.empty() && *relativePath.begin() != ".." && (out_repository == nullptr || relativePath.generic_string().size() < result.size()))
+		{
+			out_repository	= &repository;
+			result			= relativePath.generic_string();
+		}
+	}
+
+	return result;
+}
+
+bool GitIndexChangeDetector::load(std::vector<fs::path> const& repositoryPaths, fs::path const& outputDirectory, ILogger* logger) noexcept
+{
+	_repositories.clear();
+	_previousRecords.clear();
+	_currentRecords.clear();
+
+	std::error_code errorCode;
+
+	_outputDirectory = fs::absolute(outputDirectory, errorCode).lexically_normal();
+
+	for (fs::path const& repositoryPath : repositoryPaths)
+	{
+		Repository	repository;
+		fs::path	gitDirectory;
+		std::string	indexData;
+
+		if (!findRepository(repositoryPath, repository.workingTreeRoot, gitDirectory))
+		{
+			if (logger != nullptr)
+			{
+				logger->log("Could not find a git repository containing " + repositoryPath.string() + ", git index change detection is disabled for its files.", ILogger::ELogSeverity::Warning);
+			}
+
+			continue;
+		}
+
+		if (std::any_of(_repositories.cbegin(), _repositories.cend(), [&repository](Repository const& loadedRepository) { return loadedRepository.workingTreeRoot == repository.workingTreeRoot; }))
+		{
+			continue;
+		}
+
+		if (!readFile(gitDirectory / "index", indexData) || !parseIndex(indexData, getHashSize(gitDirectory), repository.indexBlobHashes))
+		{
+			if (logger != nullptr)
+			{
+				logger->log("Could not read the git index of " + repository.workingTreeRoot.string() + ", git index change detection is disabled for its files.", ILogger::ELogSeverity::Warning);
+			}
+
+			continue;
+		}
+
+		_repositories.push_back(std::move(repository));
+	}
+
+	if (_repositories.empty())
+	{
+		return false;
+	}
+
+	//Load the previous run manifest, a missing or outdated manifest simply makes all files changed
+	std::ifstream manifest(outputDirectory / _manifestFilename);
+	std::string	  line;
+
+	if (manifest.is_open() && std::getline(manifest, line) && line == _manifestHeader)
+	{
+		while (std::getline(manifest, line))
+		{
+			std::istringstream	lineStream(line);
+			FileRecord			record;
+
+			if (lineStream >> record.blobHash >> record.size >> record.lastWriteTime)
+			{
+				std::string path;
+
+				//The path is the remaining of the line, it may contain spaces
+				lineStream.get();
+				std::getline(lineStream, path);
+
+				_previousRecords.emplace(std::move(path), std::move(record));
+			}
+		}
+	}
+
+	return true;
+}
+
+EGitFileState GitIndexChangeDetector::getFileState(fs::path const& file) noexcept
+{
+	Repository const*	repository;
+	std::string			indexKey = getIndexKey(file, repository);
+
+	if (repository == nullptr)
+	{
+		return EGitFileState::Untracked;
+	}
+
+	auto indexIt = repository->indexBlobHashes.find(indexKey);
+
+	if (indexIt == repository->indexBlobHashes.cend())
+	{
+		return EGitFileState::Untracked;
+	}
+
+	std::error_code	errorCode;
+	FileRecord		record;
+	std::string		key = fs::absolute(file, errorCode).lexically_normal().lexically_relative(_outputDirectory).generic_string();
+
+	record.blobHash			= indexIt->second;
+	record.size				= static_cast<uint64>(fs::file_size(file, errorCode));
+	record.lastWriteTime	= errorCode ? 0 : static_cast<int64>(fs::last_write_time(file, errorCode).time_since_epoch().count());
+
+	if (errorCode || record.blobHash.empty())
+	{
+		//Can't compare anything (unreadable or unmerged file), consider the file changed and don't record it
+		return EGitFileState::Changed;
+	}
+
+	auto			previousIt	= _previousRecords.find(key);
+	EGitFileState	result		= EGitFileState::Unknown;
+
+	if (previousIt != _previousRecords.cend())
+	{
+		result = (previousIt->second.blobHash == record.blobHash &&
+				  previousIt->second.size == record.size &&
+				  previousIt->second.lastWriteTime == record.lastWriteTime) ? EGitFileState::Unchanged : EGitFileState::Changed;
+	}
+
+	_currentRecords[key] = std::move(record);
+
+	return result;
+}
+
+bool GitIndexChangeDetector::saveManifest(fs::path const& outputDirectory) const noexcept
+{
+	std::ofstream manifest(outputDirectory / _manifestFilename, std::ios::trunc);
+
+	if (!manifest.is_open())
+	{
+		return false;
+	}
+
+	manifest << _manifestHeader << "\n";
+
+	auto writeRecord = [&manifest](std::string const& path, FileRecord const& record)
+	{
+		manifest << record.blobHash << " " << record.size << " " << record.lastWriteTime << " " << path << "\n";
+	};
+
+	for (auto const& [path, record] : _currentRecords)
+	{
+		writeRecord(path, record);
+	}
+
+	for (auto const& [path, record] : _previousRecords)
+	{
+		if (_currentRecords.find(path) == _currentRecords.cend())
+		{
+			writeRecord(path, record);
+		}
+	}
+
+	return manifest.good();
+}
+
+bool GitIndexChangeDetector::isLoaded() const noexcept
+{
+	return !_repositories.empty();
+}
\ No newline at end of file
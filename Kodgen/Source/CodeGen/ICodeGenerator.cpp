@@ -10,4 +10,9 @@ int32 ICodeGenerator::getGenerationOrder() const noexcept
 uint8 ICodeGenerator::getIterationCount() const noexcept
 {
 	return 1u;
+}
+
+bool ICodeGenerator::needsWholeFileContext() const noexcept
+{
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Kodgen/CodeGen/Macro/MacroCodeGenEnv.h"
+
+#include "Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h"
+#include "Kodgen/InfoStructures/StructClassInfo.h"
+
+using namespace kodgen;
+
+EAccessSpecifier MacroCodeGenEnv::getClassFooterAccessSpecifier(StructClassInfo const& structClassInfo) const noexcept
+{
+	if (_settings != nullptr && _classFooterAccessSpecifiers != nullptr)
+	{
+		auto it = _classFooterAccessSpecifiers->find(_settings->getClassFooterMacro(structClassInfo));
+
+		if (it != _classFooterAccessSpecifiers->cend())
+		{
+			return it->second;
+		}
+	}
+
+	return (structClassInfo.entityType == EEntityType::Class) ? EAccessSpecifier::Private : EAccessSpecifier::Public;
+}
\ No newline at end of file
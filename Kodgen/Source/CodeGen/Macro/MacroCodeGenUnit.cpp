@@ -6,8 +6,128 @@
 #include "Kodgen/CodeGen/Macro/MacroCodeGenUnitSettings.h"
 #include "Kodgen/CodeGen/Macro/MacroCodeGenModule.h"
 
+#include <cctype>		//std::isalnum, std::isspace
+#include <fstream>
+#include <sstream>
+
 using namespace kodgen;
 
+namespace
+{
+	/**
+	*	@brief	Lexically split source code into identifiers and punctuation characters ("::" is a single token),
+	*			skipping comments, string and char literals.
+	* 
+	*	@param content			The source code.
+	*	@param skipDirectives	Should the preprocessor directives be skipped?
+	*	@param visitor			Function called with each token.
+	*/
+	void foreachToken(std::string const& content, bool skipDirectives, std::function<void(std::string const&)> const& visitor) noexcept
+	{
+		auto	isIdentifierChar	= [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+		bool	isLineStart			= true;
+
+		for (size_t i = 0u; i < content.size(); )
+		{
+			if (content[i] == '\n')
+			{
+				isLineStart = true;
+				i++;
+
+				continue;
+			}
+			else if (content[i] == ' ' || content[i] == '\t' || content[i] == '\r')
+			{
+				i++;
+
+				continue;
+			}
+
+			if (content[i] == '#' && isLineStart && skipDirectives)
+			{
+				//Skip the directive, including its continuation lines
+				while (i < content.size() && content[i] != '\n')
+				{
+					i += (content[i] == '\\') ? 2u : 1u;
+				}
+			}
+			else if (content.compare(i, 2, "//") == 0)
+			{
+				i = content.find('\n', i);
+			}
+			else if (content.compare(i, 2, "/*") == 0)
+			{
+				i = content.find("*/", i + 2u);
+				i = (i == std::string::npos) ? i : i + 2u;
+			}
+			else if (content[i] == '"' || content[i] == '\'')
+			{
+				//Skip string and char literals, handling escaped characters
+				char delimiter = content[i++];
+
+				while (i < content.size() && content[i] != delimiter && content[i] != '\n')
+				{
+					i += (content[i] == '\\') ? 2u : 1u;
+				}
+
+				i++;
+			}
+			else if (isIdentifierChar(content[i]))
+			{
+				size_t identifierEnd = i;
+
+				while (identifierEnd < content.size() && isIdentifierChar(content[identifierEnd]))
+				{
+					identifierEnd++;
+				}
+
+				visitor(content.substr(i, identifierEnd - i));
+
+				i = identifierEnd;
+			}
+			else if (content.compare(i, 2, "::") == 0)
+			{
+				visitor("::");
+
+				i += 2u;
+			}
+			else
+			{
+				visitor(std::string(1u, content[i]));
+
+				i++;
+			}
+
+			isLineStart = false;
+		}
+	}
+
+	/**
+	*	@brief Read the whole content of a file.
+	* 
+	*	@param file			Path to the file.
+	*	@param out_content	String filled with the file content.
+	* 
+	*	@return true if the file could be read, else false.
+	*/
+	bool readFile(fs::path const& file, std::string& out_content) noexcept
+	{
+		std::ifstream stream(file, std::ios::in | std::ios::binary);
+
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		std::ostringstream contentStream;
+		contentStream << stream.rdbuf();
+
+		out_content = contentStream.str();
+
+		return true;
+	}
+}
+
 std::array<std::string, static_cast<size_t>(ECodeGenLocation::Count)> const MacroCodeGenUnit::_separators =
 {
 	"\n",	//HeaderFileHeader is not wrapped inside a macro, so can use \n without breaking the code
@@ -91,6 +211,23 @@ bool MacroCodeGenUnit::preGenerateCode(FileParsingResult const& parsingResult, C
 		MacroCodeGenEnv& macroEnv = static_cast<MacroCodeGenEnv&>(env);
 		macroEnv._exportSymbolMacro = getSettings()->getExportSymbolMacroName();
 		macroEnv._internalSymbolMacro = getSettings()->getInternalSymbolMacroName();
+		macroEnv._settings = getSettings();
+
+		//Entities streamed from the same file share the scan
+		std::error_code		errorCode;
+		fs::file_time_type	sourceFileLastWriteTime = fs::last_write_time(parsingResult.parsedFile, errorCode);
+
+		if (parsingResult.parsedFile != _accessSpecifiersSourceFile || sourceFileLastWriteTime != _accessSpecifiersSourceFileLastWriteTime)
+		{
+			_classFooterAccessSpecifiers.clear();
+
+			collectClassFooterAccessSpecifiers(parsingResult.parsedFile, _classFooterAccessSpecifiers);
+
+			_accessSpecifiersSourceFile					= parsingResult.parsedFile;
+			_accessSpecifiersSourceFileLastWriteTime	= sourceFileLastWriteTime;
+		}
+
+		macroEnv._classFooterAccessSpecifiers = &_classFooterAccessSpecifiers;
 
 		//Reset variables before the generation step begins
 		_classFooterGeneratedCode.clear();
@@ -111,16 +248,83 @@ bool MacroCodeGenUnit::postGenerateCode(CodeGenEnv& env) noexcept
 	//Create generated header & generated source files
 	generateHeaderFile(static_cast<MacroCodeGenEnv&>(env));
 	generateSourceFile(static_cast<MacroCodeGenEnv&>(env));
+	generateModuleInterfaceFile(static_cast<MacroCodeGenEnv&>(env));
 
 	return true;
 }
 
-void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
+bool MacroCodeGenUnit::supportsEntityStreaming() const noexcept
 {
-	GeneratedFile generatedHeader(getGeneratedHeaderFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile);
+	return true;
+}
 
-	MacroCodeGenUnitSettings const* castSettings = getSettings();
+void MacroCodeGenUnit::takeGeneratedCode(GeneratedCodeChunk& out_chunk) noexcept
+{
+	out_chunk.code.resize(_generatedCodePerLocation.size());
+
+	for (size_t i = 0u; i < _generatedCodePerLocation.size(); i++)
+	{
+		out_chunk.code[i] = std::move(_generatedCodePerLocation[i]);
+		_generatedCodePerLocation[i].clear();
+	}
+
+	for (auto& [struct_, generatedCode] : _classFooterGeneratedCode)
+	{
+		out_chunk.entityCode.emplace(struct_, std::move(generatedCode));
+	}
+
+	_classFooterGeneratedCode.clear();
+}
+
+void MacroCodeGenUnit::appendGeneratedCode(GeneratedCodeChunk&& chunk) noexcept
+{
+	for (size_t i = 0u; i < chunk.code.size() && i < _generatedCodePerLocation.size(); i++)
+	{
+		_generatedCodePerLocation[i] += chunk.code[i];
+	}
+
+	//Entity code is always attached to a struct/class by takeGeneratedCode
+	for (auto& [entity, generatedCode] : chunk.entityCode)
+	{
+		_classFooterGeneratedCode[static_cast<StructClassInfo const*>(entity)] += generatedCode;
+	}
+}
+
+void MacroCodeGenUnit::getGeneratedCodeSizes(std::vector<size_t>& out_sizes) const noexcept
+{
+	size_t headerSize = 0u;
+
+	for (size_t i = 0u; i < _generatedCodePerLocation.size(); i++)
+	{
+		if (i != static_cast<size_t>(ECodeGenLocation::SourceFileHeader))
+		{
+			headerSize += _generatedCodePerLocation[i].size();
+		}
+	}
+
+	for (auto const& [struct_, generatedCode] : _classFooterGeneratedCode)
+	{
+		headerSize += generatedCode.size();
+	}
+
+	out_sizes = { headerSize, _generatedCodePerLocation[static_cast<size_t>(ECodeGenLocation::SourceFileHeader)].size() };
+}
+
+std::vector<fs::path> MacroCodeGenUnit::getGeneratedFilePaths(fs::path const& sourceFile) const noexcept
+{
+	std::vector<fs::path>	result						= { getGeneratedHeaderFilePath(sourceFile), getGeneratedSourceFilePath(sourceFile) };
+	fs::path				generatedModuleInterface	= getGeneratedModuleInterfaceFilePath(sourceFile);
 
+	if (!generatedModuleInterface.empty())
+	{
+		result.emplace_back(std::move(generatedModuleInterface));
+	}
+
+	return result;
+}
+
+void MacroCodeGenUnit::writeHeaderFilePreamble(GeneratedFile& generatedHeader) const noexcept
+{
 	generatedHeader.writeLine("#pragma once\n");
 
 	//Include the entity file
@@ -130,6 +334,180 @@ void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
 	generatedHeader.writeLine("#include \"GcPtr.h\"");
 	//Include rfk::Object
 	generatedHeader.writeLine("#include \"Refureku/Object.h\"\n");
+}
+
+bool MacroCodeGenUnit::collectFooterMacroNames(fs::path const& sourceFile, std::set<std::string>& out_macroNames) const noexcept
+{
+	std::string content;
+
+	if (!readFile(sourceFile, content))
+	{
+		return false;
+	}
+
+	foreachToken(content, false, [this, &out_macroNames](std::string const& token)
+				 {
+					 if (getSettings()->isClassFooterMacro(token))
+					 {
+						 out_macroNames.emplace(token);
+					 }
+				 });
+
+	out_macroNames.emplace(getSettings()->getHeaderFileFooterMacro(sourceFile));
+
+	return true;
+}
+
+bool MacroCodeGenUnit::collectClassFooterAccessSpecifiers(fs::path const&										sourceFile,
+														  std::unordered_map<std::string, EAccessSpecifier>&	out_accessSpecifiers) const noexcept
+{
+	std::string content;
+
+	if (!readFile(sourceFile, content))
+	{
+		return false;
+	}
+
+	//Scopes opened by braces, with the access in effect in the scope if it is a struct/class body (Invalid otherwise)
+	std::vector<EAccessSpecifier>	scopes;
+	EAccessSpecifier				declaredClassAccess	= EAccessSpecifier::Invalid;
+	std::string						previousToken;
+
+	foreachToken(content, true, [this, &out_accessSpecifiers, &scopes, &declaredClassAccess, &previousToken](std::string const& token)
+				 {
+					 if ((token == "class" || token == "struct" || token == "union") && previousToken != "enum")
+					 {
+						 //The next brace of the statement opens the struct/class body (or the body of a function template, which has no access specifier)
+						 declaredClassAccess = (token == "class") ? EAccessSpecifier::Private : EAccessSpecifier::Public;
+					 }
+					 else if (token == "{")
+					 {
+						 scopes.push_back(declaredClassAccess);
+						 declaredClassAccess = EAccessSpecifier::Invalid;
+					 }
+					 else if (token == "}" || token == ";")
+					 {
+						 if (token == "}" && !scopes.empty())
+						 {
+							 scopes.pop_back();
+						 }
+
+						 declaredClassAccess = EAccessSpecifier::Invalid;
+					 }
+					 else if (!scopes.empty() && scopes.back() != EAccessSpecifier::Invalid)
+					 {
+						 if (token == ":" && previousToken == "public")
+						 {
+							 scopes.back() = EAccessSpecifier::Public;
+						 }
+						 else if (token == ":" && previousToken == "protected")
+						 {
+							 scopes.back() = EAccessSpecifier::Protected;
+						 }
+						 else if (token == ":" && previousToken == "private")
+						 {
+							 scopes.back() = EAccessSpecifier::Private;
+						 }
+						 else if (getSettings()->isClassFooterMacro(token))
+						 {
+							 out_accessSpecifiers[token] = scopes.back();
+						 }
+					 }
+
+					 previousToken = token;
+				 });
+
+	return true;
+}
+
+bool MacroCodeGenUnit::generateProvisionalCode(fs::path const& sourceFile) const noexcept
+{
+	//Provisional files would be written next to the pack, defeating its purpose
+	if (getGeneratedFilePack() != nullptr)
+	{
+		return true;
+	}
+
+	std::set<std::string> macroNames;
+
+	if (!collectFooterMacroNames(sourceFile, macroNames))
+	{
+		return false;
+	}
+
+	fs::path generatedHeaderPath = getGeneratedHeaderFilePath(sourceFile);
+
+	//Keep the existing generated header if it already defines all macros: it is more complete than a provisional one
+	std::ifstream existingHeaderStream(generatedHeaderPath, std::ios::in | std::ios::binary);
+
+	if (existingHeaderStream.is_open())
+	{
+		std::ostringstream existingHeader;
+		existingHeader << existingHeaderStream.rdbuf();
+
+		std::string const existingContent = existingHeader.str();
+
+		for (auto it = macroNames.begin(); it != macroNames.end(); )
+		{
+			std::string	definition	= "#define " + *it;
+			size_t		position	= existingContent.find(definition);
+
+			while (position != std::string::npos &&
+				   position + definition.size() < existingContent.size() &&
+				   !std::isspace(static_cast<unsigned char>(existingContent[position + definition.size()])))
+			{
+				position = existingContent.find(definition, position + 1u);
+			}
+
+			it = (position != std::string::npos) ? macroNames.erase(it) : std::next(it);
+		}
+
+		existingHeaderStream.close();
+	}
+
+	if (!macroNames.empty())
+	{
+		GeneratedFile generatedHeader(std::move(generatedHeaderPath), sourceFile, getSettings()->shouldWriteGeneratedFilesOnlyIfChanged);
+
+		generatedHeader.writeLine(_provisionalFileMarker);
+
+		writeHeaderFilePreamble(generatedHeader);
+
+		for (std::string const& macroName : macroNames)
+		{
+			generatedHeader.writeMacro(std::string(macroName));
+		}
+	}
+
+	fs::path generatedSourcePath = getGeneratedSourceFilePath(sourceFile);
+
+	if (!fs::exists(generatedSourcePath))
+	{
+		GeneratedFile generatedSource(std::move(generatedSourcePath), sourceFile);
+
+		generatedSource.writeLine(_provisionalFileMarker);
+		generatedSource.writeLine("#pragma once\n");
+		generatedSource.writeLine("#include \"" + FilesystemHelpers::normalizeSeparator(sourceFile.lexically_relative(generatedSource.getPath().parent_path())).string() + "\"\n");
+	}
+
+	return true;
+}
+
+bool MacroCodeGenUnit::isProvisionalFile(fs::path const& generatedFile) const noexcept
+{
+	std::ifstream	stream(generatedFile, std::ios::in | std::ios::binary);
+	std::string		firstLine;
+
+	return stream.is_open() && std::getline(stream, firstLine) && firstLine.rfind(_provisionalFileMarker, 0u) == 0u;
+}
+
+void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
+{
+	MacroCodeGenUnitSettings const* castSettings = getSettings();
+
+	GeneratedFile generatedHeader(getGeneratedHeaderFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile, castSettings->shouldWriteGeneratedFilesOnlyIfChanged, getGeneratedFilePack());
+
+	writeHeaderFilePreamble(generatedHeader);
 
 	//Write header file header code
 	generatedHeader.writeLine(std::move(_generatedCodePerLocation[static_cast<int>(ECodeGenLocation::HeaderFileHeader)]));
@@ -157,7 +535,7 @@ void MacroCodeGenUnit::generateHeaderFile(MacroCodeGenEnv& env) noexcept
 
 void MacroCodeGenUnit::generateSourceFile(MacroCodeGenEnv& env) noexcept
 {
-	GeneratedFile generatedFile(getGeneratedSourceFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile);
+	GeneratedFile generatedFile(getGeneratedSourceFilePath(env.getFileParsingResult()->parsedFile), env.getFileParsingResult()->parsedFile, getSettings()->shouldWriteGeneratedFilesOnlyIfChanged, getGeneratedFilePack());
 
 	generatedFile.writeLine("#pragma once\n");
 
@@ -167,23 +545,220 @@ void MacroCodeGenUnit::generateSourceFile(MacroCodeGenEnv& env) noexcept
 	generatedFile.writeLine(std::move(_generatedCodePerLocation[static_cast<int>(ECodeGenLocation::SourceFileHeader)]));
 }
 
+/**
+*	@brief Check whether a function name is the name of an operator.
+* 
+*	@param name The function name.
+* 
+*	@return true if the name is operator followed by an operator symbol or keyword, else false.
+*/
+static bool isOperatorName(std::string const& name) noexcept
+{
+	return name.compare(0u, 8u, "operator") == 0 && name.size() > 8u && !(std::isalnum(static_cast<unsigned char>(name[8])) || name[8] == '_');
+}
+
+/**
+*	@brief	Append the using-declarations exporting the named entities declared directly in a scope, and recursively in its nested namespaces.
+*			Anonymous entities, anonymous namespaces and internal linkage (static) functions and variables are skipped since they can't be exported.
+*			Class templates are exported by their name without template arguments, which exports all their specializations.
+*			Operators are exported by their full name (operator<, operator<<).
+* 
+*	@param scope			File parsing result or namespace to export the entities of.
+*	@param qualifiedScope	Fully qualified name of the scope, followed by "::".
+*	@param indent			Indentation of the declarations.
+*	@param out_exports		String the declarations are appended to.
+*/
+template <typename ScopeType>
+static void appendModuleExports(ScopeType const& scope, std::string const& qualifiedScope, std::string const& indent, std::string& out_exports) noexcept
+{
+	//Overloaded functions are exported by a single using-declaration
+	std::set<std::string> exportedNames;
+
+	auto appendUsingDeclaration = [&](std::string const& name)
+	{
+		if (!name.empty() && exportedNames.emplace(name).second)
+		{
+			out_exports += indent + "using " + qualifiedScope + name + ";\n";
+		}
+	};
+
+	//Class templates display names contain their template parameters (Vector3<T>)
+	auto appendStructClassUsingDeclaration = [&](StructClassInfo const& struct_)
+	{
+		std::string name = struct_.name.substr(0u, struct_.name.find('<'));
+
+		if (name.find_first_of("( ") == std::string::npos)
+		{
+			appendUsingDeclaration(name);
+		}
+	};
+
+	for (StructClassInfo const& struct_ : scope.structs)
+	{
+		appendStructClassUsingDeclaration(struct_);
+	}
+
+	for (StructClassInfo const& class_ : scope.classes)
+	{
+		appendStructClassUsingDeclaration(class_);
+	}
+
+	for (EnumInfo const& enum_ : scope.enums)
+	{
+		if (enum_.name.find_first_of("( ") == std::string::npos)
+		{
+			appendUsingDeclaration(enum_.name);
+		}
+	}
+
+	//Operator names are kept intact, they may contain < and spaces (operator<<, operator new)
+	for (FunctionInfo const& function : scope.functions)
+	{
+		if (!function.isStatic && (isOperatorName(function.name) || function.name.find_first_of("<( ") == std::string::npos))
+		{
+			appendUsingDeclaration(function.name);
+		}
+	}
+
+	for (VariableInfo const& variable : scope.variables)
+	{
+		if (!variable.isStatic && variable.name.find_first_of("<( ") == std::string::npos)
+		{
+			appendUsingDeclaration(variable.name);
+		}
+	}
+
+	for (NamespaceInfo const& namespace_ : scope.namespaces)
+	{
+		std::string namespaceExports;
+
+		if (!namespace_.name.empty())
+		{
+			appendModuleExports(namespace_, qualifiedScope + namespace_.name + "::", indent + "\t", namespaceExports);
+		}
+
+		if (!namespaceExports.empty())
+		{
+			out_exports += indent + "namespace " + namespace_.name + "\n" + indent + "{\n" + namespaceExports + indent + "}\n";
+		}
+	}
+}
+
+void MacroCodeGenUnit::generateModuleInterfaceFile(MacroCodeGenEnv& env) noexcept
+{
+	fs::path generatedModuleInterfacePath = getGeneratedModuleInterfaceFilePath(env.getFileParsingResult()->parsedFile);
+
+	if (generatedModuleInterfacePath.empty())
+	{
+		return;
+	}
+
+	GeneratedFile	generatedFile(std::move(generatedModuleInterfacePath), env.getFileParsingResult()->parsedFile, getSettings()->shouldWriteGeneratedFilesOnlyIfChanged, getGeneratedFilePack());
+	std::string		exports;
+
+	appendModuleExports(*env.getFileParsingResult(), "::", "\t", exports);
+
+	//The parsed file and its generated header are included in the global module fragment so that the reflected entities
+	//keep their linkage: importers get them (with their expanded generated code) from the compiled module instead of preprocessing them
+	generatedFile.writeLine("module;\n");
+	generatedFile.writeLine("#include \"" + FilesystemHelpers::normalizeSeparator(generatedFile.getSourceFilePath().lexically_relative(generatedFile.getPath().parent_path())).string() + "\"\n");
+	generatedFile.writeLine("export module " + getSettings()->getModuleName(env.getFileParsingResult()->parsedFile) + ";");
+
+	//An export block must declare at least one name
+	if (!exports.empty())
+	{
+		generatedFile.writeLine("\nexport\n{\n" + exports + "}");
+	}
+}
+
 bool MacroCodeGenUnit::isUpToDate(fs::path const& sourceFile) const noexcept
 {
+	return explainIsUpToDate(sourceFile).reason == EFileProcessingReason::UpToDate;
+}
+
+FileProcessingExplanation MacroCodeGenUnit::explainIsUpToDate(fs::path const& sourceFile) const noexcept
+{
+	FileProcessingExplanation result;
+	result.file = sourceFile;
+
 	fs::path generatedHeaderPath = getGeneratedHeaderFilePath(sourceFile);
 
-	//If the generated header doesn't exist, create it and return false
-	if (!fs::exists(generatedHeaderPath))
+	if (!generatedFileExists(generatedHeaderPath))
+	{
+		result.reason			= EFileProcessingReason::MissingGeneratedFile;
+		result.generatedFile	= generatedHeaderPath;
+	}
+	else if (isGeneratedFileNewerThan(generatedHeaderPath, sourceFile))
 	{
-		GeneratedFile generatedHeader(fs::path(generatedHeaderPath), sourceFile);
+		fs::path	generatedSource			= getGeneratedSourceFilePath(sourceFile);
+		bool		checkProvisionalFiles	= areProvisionalFilesEnabled() && getGeneratedFilePack() == nullptr;
+
+		if (!generatedFileExists(generatedSource))
+		{
+			result.reason			= EFileProcessingReason::MissingGeneratedFile;
+			result.generatedFile	= std::move(generatedSource);
+		}
+		else if (!isGeneratedFileNewerThan(generatedSource, sourceFile))
+		{
+			result.reason			= EFileProcessingReason::OutdatedGeneratedFile;
+			result.generatedFile	= std::move(generatedSource);
+		}
+		else
+		{
+			fs::path generatedModuleInterface = getGeneratedModuleInterfaceFilePath(sourceFile);
+
+			if (!generatedModuleInterface.empty() && !generatedFileExists(generatedModuleInterface))
+			{
+				result.reason			= EFileProcessingReason::MissingGeneratedFile;
+				result.generatedFile	= std::move(generatedModuleInterface);
+			}
+			else if (!generatedModuleInterface.empty() && !isGeneratedFileNewerThan(generatedModuleInterface, sourceFile))
+			{
+				result.reason			= EFileProcessingReason::OutdatedGeneratedFile;
+				result.generatedFile	= std::move(generatedModuleInterface);
+			}
+			//Provisional files are newer than the source file but don't contain its generated code (the parsing may have failed)
+			//Packed files are never provisional (see generateProvisionalCode), and generated files are only read if provisional files are enabled
+			else if (checkProvisionalFiles && isProvisionalFile(generatedHeaderPath))
+			{
+				result.reason			= EFileProcessingReason::OutdatedGeneratedFile;
+				result.generatedFile	= generatedHeaderPath;
+			}
+			else if (checkProvisionalFiles && isProvisionalFile(generatedSource))
+			{
+				result.reason			= EFileProcessingReason::OutdatedGeneratedFile;
+				result.generatedFile	= std::move(generatedSource);
+			}
+			else
+			{
+				result.reason = EFileProcessingReason::UpToDate;
+			}
+		}
 	}
-	else if (isFileNewerThan(generatedHeaderPath, sourceFile))
+	else
 	{
-		fs::path generatedSource = getGeneratedSourceFilePath(sourceFile);
+		result.reason			= EFileProcessingReason::OutdatedGeneratedFile;
+		result.generatedFile	= generatedHeaderPath;
+	}
 
-		return fs::exists(generatedSource) && isFileNewerThan(generatedSource, sourceFile);
+	//The source file includes its generated header, create an empty one so that it can be parsed
+	if (result.reason != EFileProcessingReason::UpToDate)
+	{
+		if (getGeneratedFilePack() != nullptr)
+		{
+			//Packed files are provided to libclang from memory (see FileParser::generatedFilePack)
+			if (result.reason == EFileProcessingReason::MissingGeneratedFile && result.generatedFile == generatedHeaderPath)
+			{
+				getGeneratedFilePack()->appendToFile(generatedHeaderPath, sourceFile, "");
+			}
+		}
+		else if (!fs::exists(generatedHeaderPath))
+		{
+			GeneratedFile generatedHeader(fs::path(generatedHeaderPath), sourceFile);
+		}
 	}
 
-	return false;
+	return result;
 }
 
 void MacroCodeGenUnit::generateEntityClassFooterCode(EntityInfo const& entity, CodeGenEnv& env, std::function<void(EntityInfo const&, CodeGenEnv&, std::string&)> generate) noexcept
@@ -213,6 +788,13 @@ fs::path MacroCodeGenUnit::getGeneratedSourceFilePath(fs::path const& sourceFile
 	return settings->getOutputDirectory() / getSettings()->getGeneratedSourceFileName(sourceFile);
 }
 
+fs::path MacroCodeGenUnit::getGeneratedModuleInterfaceFilePath(fs::path const& sourceFile) const noexcept
+{
+	fs::path generatedModuleInterfaceFileName = getSettings()->getGeneratedModuleInterfaceFileName(sourceFile);
+
+	return (generatedModuleInterfaceFileName.empty()) ? fs::path() : settings->getOutputDirectory() / generatedModuleInterfaceFileName;
+}
+
 void MacroCodeGenUnit::addModule(MacroCodeGenModule& generationModule) noexcept
 {
 	CodeGenUnit::addModule(generationModule);
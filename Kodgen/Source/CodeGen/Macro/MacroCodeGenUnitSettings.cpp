@@ -16,6 +16,7 @@ bool MacroCodeGenUnitSettings::loadSettingsValues(toml::value const& tomlData, I
 		toml::value const& tomlMacroCGUSettings = toml::find(tomlData, tomlSectionName);
 
 		loadFileNamePatterns(tomlMacroCGUSettings, logger);
+		loadModuleNamePattern(tomlMacroCGUSettings, logger);
 		loadClassFooterMacroPattern(tomlMacroCGUSettings, logger);
 		loadHeaderFileFooterMacroPattern(tomlMacroCGUSettings, logger);
 		loadExportSymbolMacroName(tomlMacroCGUSettings, logger);
@@ -52,6 +53,32 @@ void MacroCodeGenUnitSettings::loadFileNamePatterns(toml::value const& generatio
 			logger->log("[TOML] Load generated source file name pattern: " + _generatedSourceFileNamePattern);
 		}
 	}
+
+	//Load generated module interface unit file name
+	if (TomlUtility::updateSetting(generationSettings, "generatedModuleInterfaceFileNamePattern", generatedFileNamePattern, logger))
+	{
+		setGeneratedModuleInterfaceFileNamePattern(generatedFileNamePattern);
+
+		if (logger != nullptr)
+		{
+			logger->log("[TOML] Load generated module interface file name pattern: " + _generatedModuleInterfaceFileNamePattern);
+		}
+	}
+}
+
+void MacroCodeGenUnitSettings::loadModuleNamePattern(toml::value const& generationSettings, ILogger* logger) noexcept
+{
+	std::string moduleNamePattern;
+
+	if (TomlUtility::updateSetting(generationSettings, "moduleNamePattern", moduleNamePattern, logger))
+	{
+		setModuleNamePattern(moduleNamePattern);
+
+		if (logger != nullptr)
+		{
+			logger->log("[TOML] Load module name pattern: " + _moduleNamePattern);
+		}
+	}
 }
 
 void MacroCodeGenUnitSettings::loadClassFooterMacroPattern(toml::value const& generationSettings, ILogger* logger) noexcept
@@ -133,6 +160,16 @@ void MacroCodeGenUnitSettings::setClassFooterMacroPattern(std::string const& cla
 	_classFooterMacroPattern = classFooterMacroPattern;
 }
 
+void MacroCodeGenUnitSettings::setGeneratedModuleInterfaceFileNamePattern(std::string const& generatedModuleInterfaceFileNamePattern) noexcept
+{
+	_generatedModuleInterfaceFileNamePattern = generatedModuleInterfaceFileNamePattern;
+}
+
+void MacroCodeGenUnitSettings::setModuleNamePattern(std::string const& moduleNamePattern) noexcept
+{
+	_moduleNamePattern = moduleNamePattern;
+}
+
 void MacroCodeGenUnitSettings::setHeaderFileFooterMacroPattern(std::string const& headerFileFooterMacroPattern) noexcept
 {
 	_headerFileFooterMacroPattern = headerFileFooterMacroPattern;
@@ -178,6 +215,54 @@ fs::path MacroCodeGenUnitSettings::getGeneratedSourceFileName(fs::path const& ta
 	return filename;
 }
 
+std::string const& MacroCodeGenUnitSettings::getGeneratedModuleInterfaceFileNamePattern() const noexcept
+{
+	return _generatedModuleInterfaceFileNamePattern;
+}
+
+fs::path MacroCodeGenUnitSettings::getGeneratedModuleInterfaceFileName(fs::path const& targetFile) const noexcept
+{
+	std::string	filename = _generatedModuleInterfaceFileNamePattern;
+
+	//Replace all occurences of ##FILENAME## by the targetFile name (without its extension)
+	replaceTags(filename, filenameTag, targetFile.filename().stem().string());
+
+	return filename;
+}
+
+std::string const& MacroCodeGenUnitSettings::getModuleNamePattern() const noexcept
+{
+	return _moduleNamePattern;
+}
+
+std::string MacroCodeGenUnitSettings::getModuleName(fs::path const& targetFile) const noexcept
+{
+	std::string moduleName = _moduleNamePattern;
+
+	replaceTags(moduleName, filenameTag, targetFile.filename().stem().string());
+
+	//A module name is a sequence of dot-separated identifiers, each following the same rules as a macro name
+	std::string	sanitizedModuleName;
+	size_t		partStart = 0u;
+
+	while (partStart <= moduleName.size())
+	{
+		size_t		partEnd	= std::min(moduleName.find('.', partStart), moduleName.size());
+		std::string	part	= moduleName.substr(partStart, partEnd - partStart);
+
+		if (!part.empty())
+		{
+			sanitizeMacroName(part);
+
+			sanitizedModuleName += (sanitizedModuleName.empty()) ? part : "." + part;
+		}
+
+		partStart = partEnd + 1u;
+	}
+
+	return sanitizedModuleName;
+}
+
 std::string const& MacroCodeGenUnitSettings::getClassFooterMacroPattern() const noexcept
 {
 	return _classFooterMacroPattern;
@@ -199,6 +284,35 @@ std::string MacroCodeGenUnitSettings::getClassFooterMacro(StructClassInfo const&
 	return classFooterMacroName;
 }
 
+bool MacroCodeGenUnitSettings::isClassFooterMacro(std::string const& identifier) const noexcept
+{
+	size_t firstTag		= std::string::npos;
+	size_t lastTagEnd	= 0u;
+
+	for (std::string_view tag : { classNameTag, classFullNameTag })
+	{
+		size_t position = _classFooterMacroPattern.find(tag);
+
+		if (position != std::string::npos)
+		{
+			firstTag	= std::min(firstTag, position);
+			lastTagEnd	= std::max(lastTagEnd, _classFooterMacroPattern.rfind(tag) + tag.size());
+		}
+	}
+
+	//The pattern doesn't contain any tag, so all classes share the same footer macro
+	if (firstTag == std::string::npos)
+	{
+		return identifier == _classFooterMacroPattern;
+	}
+
+	size_t suffixSize = _classFooterMacroPattern.size() - lastTagEnd;
+
+	return	identifier.size() > firstTag + suffixSize &&
+			identifier.compare(0u, firstTag, _classFooterMacroPattern, 0u, firstTag) == 0 &&
+			identifier.compare(identifier.size() - suffixSize, suffixSize, _classFooterMacroPattern, lastTagEnd, suffixSize) == 0;
+}
+
 std::string const& MacroCodeGenUnitSettings::getHeaderFileFooterMacroPattern() const noexcept
 {
 	return _headerFileFooterMacroPattern;
@@ -7,6 +7,7 @@ using namespace kodgen;
 FieldInfo::FieldInfo(CXCursor const& cursor, std::vector<Property>&& properties) noexcept:
 	VariableInfo(cursor, std::forward<std::vector<Property>>(properties), EEntityType::Field),
 	isMutable{clang_CXXField_isMutable(cursor) != 0u},
+	isBitField{clang_Cursor_isBitField(cursor) != 0u},
 	accessSpecifier{EAccessSpecifier::Invalid},
 	memoryOffset{0}
 {
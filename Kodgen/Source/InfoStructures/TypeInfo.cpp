@@ -9,7 +9,8 @@
 using namespace kodgen;
 
 TypeInfo::TypeInfo(CXType cursorType) noexcept:
-	sizeInBytes{0}
+	sizeInBytes{0},
+	alignment{0}
 {
 	assert(cursorType.kind != CXTypeKind::CXType_Invalid);
 
@@ -43,6 +44,11 @@ void TypeInfo::initialize(CXType cursorType) noexcept
 		sizeInBytes = static_cast<size_t>(size);
 	}
 
+	long long align		= clang_Type_getAlignOf(cursorType);
+
+	//Layout errors are all negative values
+	alignment = (align < 0) ? 0u : static_cast<size_t>(align);
+
 	//Remove class or struct keyword
 	removeForwardDeclaredClassQualifier(_fullName);
 
@@ -0,0 +1,123 @@
+#include "Kodgen/Misc/AllocationTracker.h"
+
+#include <atomic>
+
+#if KODGEN_ALLOCATION_TRACKING
+#include <new>		//std::bad_alloc, std::nothrow_t
+#include <cstdlib>	//std::malloc, std::free
+#endif
+
+using namespace kodgen;
+
+namespace
+{
+	struct AtomicAllocationStats
+	{
+		std::atomic<uint64>	allocationCount	{0u};
+		std::atomic<uint64>	allocatedBytes	{0u};
+	};
+
+	/** Stats are only written with relaxed atomics: they are read once the counted work is done. */
+	std::array<AtomicAllocationStats, static_cast<size_t>(EAllocationStage::Count)> allocationStats;
+}
+
+thread_local EAllocationStage AllocationTracker::_currentStage = EAllocationStage::Untagged;
+
+AllocationReport AllocationReport::since(AllocationReport const& previousReport) const noexcept
+{
+	AllocationReport result;
+
+	for (size_t i = 0u; i < stages.size(); i++)
+	{
+		result.stages[i].allocationCount	= stages[i].allocationCount - previousReport.stages[i].allocationCount;
+		result.stages[i].allocatedBytes		= stages[i].allocatedBytes - previousReport.stages[i].allocatedBytes;
+	}
+
+	return result;
+}
+
+bool AllocationReport::isEmpty() const noexcept
+{
+	for (AllocationStats const& stageStats : stages)
+	{
+		if (stageStats.allocationCount != 0u)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::string AllocationReport::toString() const noexcept
+{
+	std::string result;
+
+	for (size_t i = 0u; i < stages.size(); i++)
+	{
+		if (stages[i].allocationCount != 0u)
+		{
+			result += kodgen::toString(static_cast<EAllocationStage>(i)) + ": " + std::to_string(stages[i].allocationCount) + " allocations, " + std::to_string(stages[i].allocatedBytes) + " bytes\n";
+		}
+	}
+
+	return result;
+}
+
+void AllocationTracker::recordAllocation(size_t size) noexcept
+{
+	AtomicAllocationStats& stageStats = allocationStats[static_cast<size_t>(_currentStage)];
+
+	stageStats.allocationCount.fetch_add(1u, std::memory_order_relaxed);
+	stageStats.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+EAllocationStage AllocationTracker::setCurrentStage(EAllocationStage stage) noexcept
+{
+	EAllocationStage previousStage = _currentStage;
+
+	_currentStage = stage;
+
+	return previousStage;
+}
+
+AllocationReport AllocationTracker::getReport() noexcept
+{
+	AllocationReport result;
+
+	for (size_t i = 0u; i < result.stages.size(); i++)
+	{
+		result.stages[i].allocationCount	= allocationStats[i].allocationCount.load(std::memory_order_relaxed);
+		result.stages[i].allocatedBytes		= allocationStats[i].allocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	return result;
+}
+
+#if KODGEN_ALLOCATION_TRACKING
+
+//Replace the global allocation functions of the program to count allocations.
+//Array and nothrow versions call these ones by default. Over-aligned allocations are not counted.
+void* operator new(std::size_t size)
+{
+	AllocationTracker::recordAllocation(size);
+
+	if (void* result = std::malloc((size != 0u) ? size : 1u))
+	{
+		return result;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /* size */) noexcept
+{
+	std::free(ptr);
+}
+
+#endif
\ No newline at end of file
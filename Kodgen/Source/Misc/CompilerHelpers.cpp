@@ -4,6 +4,8 @@
 #include <cctype>		//std::tolower
 #include <sstream>		//std::stringstream
 #include <algorithm>	//std::transform
+#include <mutex>
+#include <unordered_map>
 
 #if _WIN32
 #include <Windows.h>	//GetModuleFileNameA, GetLastError, ERROR_INSUFFICIENT_BUFFER
@@ -104,14 +106,44 @@ bool CompilerHelpers::isGCC(std::string const& normalizedCompilerExeName) noexce
 }
 
 std::vector<fs::path> CompilerHelpers::getCompilerNativeIncludeDirectories(std::string const& compiler)
+{
+	//Launching the compiler is slow: probe each compiler once per process, even when several projects are processed
+	static std::mutex												cacheMutex;
+	static std::unordered_map<std::string, std::vector<fs::path>>	cache;
+
+	std::string normalizedCompilerExeName = normalizeCompilerExeName(compiler);
+
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		auto it = cache.find(normalizedCompilerExeName);
+
+		if (it != cache.cend())
+		{
+			return it->second;
+		}
+	}
+
+	std::vector<fs::path> result = probeCompilerNativeIncludeDirectories(normalizedCompilerExeName);
+
+	//Don't cache failed probes so that they are reported again
+	if (!result.empty())
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		cache.emplace(std::move(normalizedCompilerExeName), result);
+	}
+
+	return result;
+}
+
+std::vector<fs::path> CompilerHelpers::probeCompilerNativeIncludeDirectories(std::string const& normalizedCompilerExeName)
 {
 	std::vector<fs::path> result;
 	
 	//Don't do anything if the compiler is an empty string
-	if (compiler.size() > 0)
+	if (normalizedCompilerExeName.size() > 0)
 	{
-		std::string normalizedCompilerExeName = normalizeCompilerExeName(compiler);
-
 #if _WIN32
 		//Check MSVC on windows only
 		if (isMSVC(normalizedCompilerExeName))
@@ -0,0 +1,45 @@
+#include "Kodgen/Misc/EAllocationStage.h"
+
+using namespace kodgen;
+
+std::string kodgen::toString(EAllocationStage stage) noexcept
+{
+	std::string result;
+
+	switch (stage)
+	{
+		case EAllocationStage::Untagged:
+			result = "Untagged";
+			break;
+
+		case EAllocationStage::Discovery:
+			result = "Discovery";
+			break;
+
+		case EAllocationStage::ClangParsing:
+			result = "ClangParsing";
+			break;
+
+		case EAllocationStage::EntityParsing:
+			result = "EntityParsing";
+			break;
+
+		case EAllocationStage::PropertyParsing:
+			result = "PropertyParsing";
+			break;
+
+		case EAllocationStage::Generation:
+			result = "Generation";
+			break;
+
+		case EAllocationStage::FileWriting:
+			result = "FileWriting";
+			break;
+
+		case EAllocationStage::Count:
+			result = "Count";
+			break;
+	}
+
+	return result;
+}
\ No newline at end of file
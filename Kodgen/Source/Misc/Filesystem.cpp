@@ -4,6 +4,61 @@
 
 using namespace kodgen;
 
+namespace
+{
+	/**
+	*	@brief Check that a NUL terminated path matches a NUL terminated glob pattern.
+	*
+	*	@param path		Path to check, using / as separator.
+	*	@param pattern	Glob pattern.
+	*
+	*	@return true if path matches the pattern, else false.
+	*/
+	bool matchesGlobPattern(char const* path, char const* pattern) noexcept
+	{
+		while (*pattern != '\0')
+		{
+			if (*pattern == '*')
+			{
+				bool isRecursive = (pattern[1] == '*');
+
+				pattern += isRecursive ? 2 : 1;
+
+				//**/ also matches no directory at all, so it is only tried at the start of a path component
+				bool isDirectoryPrefix = isRecursive && *pattern == '/';
+
+				if (isDirectoryPrefix)
+				{
+					pattern++;
+				}
+
+				for (char const* current = path; ; current++)
+				{
+					if ((!isDirectoryPrefix || current == path || current[-1] == '/') && matchesGlobPattern(current, pattern))
+					{
+						return true;
+					}
+
+					if (*current == '\0' || (!isRecursive && *current == '/'))
+					{
+						return false;
+					}
+				}
+			}
+
+			if (*path == '\0' || (*pattern == '?' ? *path == '/' : *pattern != *path))
+			{
+				return false;
+			}
+
+			path++;
+			pattern++;
+		}
+
+		return *path == '\0';
+	}
+}
+
 fs::path FilesystemHelpers::sanitizePath(fs::path const& path) noexcept
 {
 	return (fs::exists(path)) ? fs::canonical(fs::path(path).make_preferred()) : fs::path();
@@ -39,4 +94,17 @@ bool FilesystemHelpers::isChildPath(fs::path const& child, fs::path const& other
 	}
 
 	return false;
+}
+
+bool FilesystemHelpers::matchesGlob(fs::path const& path, std::string const& pattern) noexcept
+{
+	std::string normalizedPath		= normalizeSeparator(path).string();
+	std::string normalizedPattern	= normalizeSeparator(pattern).string();
+
+	if (!fs::path(normalizedPattern).is_absolute() && normalizedPattern.compare(0, 1, "/") != 0)
+	{
+		normalizedPattern.insert(0, "**/");
+	}
+
+	return matchesGlobPattern(normalizedPath.data(), normalizedPattern.data());
 }
\ No newline at end of file
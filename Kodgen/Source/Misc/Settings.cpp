@@ -5,8 +5,17 @@
 
 using namespace kodgen;
 
+fs::path Settings::resolveSettingsPath(fs::path const& path) const noexcept
+{
+	return (path.is_relative() && !_settingsFileDirectory.empty()) ? _settingsFileDirectory / path : path;
+}
+
 bool Settings::loadFromFile(fs::path const& pathToSettingsFile, ILogger* logger) noexcept
 {
+	std::error_code errorCode;
+
+	_settingsFileDirectory = fs::absolute(pathToSettingsFile, errorCode).parent_path();
+
 	try
 	{
 		return loadSettingsValues(toml::parse(pathToSettingsFile.string()), logger);
@@ -4,6 +4,7 @@
 #include <array>
 #include <memory>	//std::unique_ptr
 #include <cstdio>	//std::fgets
+#include <cstdlib>	//setenv / _putenv_s
 
 using namespace kodgen;
 
@@ -31,4 +32,13 @@ std::string System::executeCommand(std::string const& cmd)
 	}
 
 	return result;
+}
+
+bool System::setEnvironmentVariable(std::string const& name, std::string const& value) noexcept
+{
+#if _WIN32
+	return _putenv_s(name.data(), value.data()) == 0;
+#else
+	return setenv(name.data(), value.data(), 1) == 0;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Kodgen/Parsing/EParseMode.h"
+
+using namespace kodgen;
+
+std::string kodgen::toString(EParseMode parseMode) noexcept
+{
+	std::string result;
+
+	switch (parseMode)
+	{
+		case EParseMode::Full:
+			result = "Full";
+			break;
+
+		case EParseMode::Shallow:
+			result = "Shallow";
+			break;
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -1,12 +1,75 @@
 #include "Kodgen/Parsing/FileParser.h"
 
 #include <cassert>
+#include <algorithm>	//std::none_of
+#include <unordered_set>
 #include "Kodgen/Misc/Helpers.h"
 #include "Kodgen/Misc/DisableWarningMacros.h"
 #include "Kodgen/Misc/TomlUtility.h"
+#include "Kodgen/Misc/AllocationTracker.h"
+#include "Kodgen/CodeGen/GeneratedFilePack.h"
 
 using namespace kodgen;
 
+namespace
+{
+	/**
+	*	Number of top-level entities of each kind in a translation unit.
+	*/
+	struct TopLevelEntityCounts
+	{
+		size_t namespaceCount	= 0u;
+		size_t structClassCount	= 0u;
+		size_t enumCount		= 0u;
+	};
+
+	/**
+	*	@brief Count the top-level entities of the main file, matching the entities added by FileParser::parseNestedEntity.
+	*
+	*	@param cursor		Current cursor.
+	*	@param parentCursor	Parent of the current cursor.
+	*	@param clientData	Pointer to the TopLevelEntityCounts to fill.
+	*
+	*	@return CXChildVisit_Continue, nested entities are not counted.
+	*/
+	CXChildVisitResult countTopLevelEntity(CXCursor cursor, CXCursor /* parentCursor */, CXClientData clientData) noexcept
+	{
+		TopLevelEntityCounts* counts = reinterpret_cast<TopLevelEntityCounts*>(clientData);
+
+		if (clang_Location_isFromMainFile(clang_getCursorLocation(cursor)))
+		{
+			switch (cursor.kind)
+			{
+				case CXCursorKind::CXCursor_Namespace:
+					counts->namespaceCount++;
+					break;
+
+				case CXCursorKind::CXCursor_StructDecl:
+					[[fallthrough]];
+				case CXCursorKind::CXCursor_ClassDecl:
+					[[fallthrough]];
+				case CXCursorKind::CXCursor_ClassTemplate:
+					counts->structClassCount++;
+					break;
+
+				case CXCursorKind::CXCursor_EnumDecl:
+					counts->enumCount++;
+					break;
+
+				default:
+					break;
+			}
+		}
+
+		DISABLE_WARNING_PUSH
+		DISABLE_WARNING_UNSCOPED_ENUM
+
+		return CXChildVisitResult::CXChildVisit_Continue;
+
+		DISABLE_WARNING_POP
+	}
+}
+
 FileParser::FileParser() noexcept:
 	_clangIndex{clang_createIndex(0, 0)},
 	_settings{std::make_shared<ParsingSettings>()},
@@ -18,16 +81,21 @@ FileParser::FileParser(FileParser const& other) noexcept:
 	NamespaceParser(other),
 	_clangIndex{clang_createIndex(0, 0)},	//Don't copy clang index, create a new one
 	_settings{other._settings},
-	logger{other.logger}
+	logger{other.logger},
+	topLevelEntityListener{other.topLevelEntityListener},
+	generatedFilePack{other.generatedFilePack}
 {
 }
 
 FileParser::FileParser(FileParser&& other) noexcept:
 	NamespaceParser(std::forward<NamespaceParser>(other)),
 	_clangIndex{std::forward<CXIndex>(other._clangIndex)},
+	_clangIndexGlobalOptions{other._clangIndexGlobalOptions},
 	_propertyParser(std::forward<PropertyParser>(other._propertyParser)),
 	_settings{other._settings},
-	logger{other.logger}
+	logger{other.logger},
+	topLevelEntityListener{std::move(other.topLevelEntityListener)},
+	generatedFilePack{other.generatedFilePack}
 {
 	other._clangIndex = nullptr;
 }
@@ -40,22 +108,107 @@ FileParser::~FileParser() noexcept
 	}
 }
 
+CXTranslationUnit FileParser::parseTranslationUnit(fs::path const& toParseFile, ParseProfile const* profile, bool isPreParsing, std::string& out_errorMessage) noexcept
+{
+	AllocationStageScope allocationStageScope(EAllocationStage::ClangParsing);
+
+	std::vector<char const*> const&	compilationArguments	= isPreParsing ? _settings->getPreParsingCompilationArguments(profile) : _settings->getCompilationArguments(profile);
+	uint32							parseOptions			= CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing;
+
+	if (profile != nullptr && profile->parseMode == EParseMode::Shallow)
+	{
+		parseOptions |= CXTranslationUnit_SingleFileParse;
+	}
+
+	//The index is created with no global option, they are set once unless the settings change
+	uint32 clangIndexGlobalOptions = _settings->shouldUseClangBackgroundPriority ? CXGlobalOpt_ThreadBackgroundPriorityForAll : CXGlobalOpt_None;
+
+	if (clangIndexGlobalOptions != _clangIndexGlobalOptions)
+	{
+		clang_CXIndex_setGlobalOptions(_clangIndex, clangIndexGlobalOptions);
+		_clangIndexGlobalOptions = clangIndexGlobalOptions;
+	}
+
+	//Packed generated files only exist in memory, libclang reads them as unsaved files
+	std::vector<std::pair<std::string, std::string>>	packedFiles;
+	std::vector<CXUnsavedFile>							unsavedFiles;
+
+	if (generatedFilePack != nullptr)
+	{
+		std::vector<fs::path> includeDirectories(_settings->getProjectIncludeDirectories().cbegin(), _settings->getProjectIncludeDirectories().cend());
+
+		if (profile != nullptr)
+		{
+			includeDirectories.insert(includeDirectories.begin(), profile->stubIncludeDirectories.cbegin(), profile->stubIncludeDirectories.cend());
+		}
+
+		packedFiles = generatedFilePack->getUnsavedFiles(toParseFile, includeDirectories);
+
+		unsavedFiles.reserve(packedFiles.size());
+
+		for (auto const& [path, content] : packedFiles)
+		{
+			unsavedFiles.push_back(CXUnsavedFile{ path.c_str(), content.data(), static_cast<unsigned long>(content.size()) });
+		}
+	}
+
+	CXTranslationUnit	translationUnit	= nullptr;
+	CXErrorCode			errorCode		= clang_parseTranslationUnit2(_clangIndex, toParseFile.string().c_str(), compilationArguments.data(), static_cast<int32>(compilationArguments.size()),
+																	  unsavedFiles.data(), static_cast<uint32>(unsavedFiles.size()), parseOptions, &translationUnit);
+
+	if (errorCode != CXError_Success)
+	{
+		char const* errorName;
+
+		switch (errorCode)
+		{
+			case CXError_Crashed:
+				errorName = "libclang crashed";
+				break;
+
+			case CXError_InvalidArguments:
+				errorName = "invalid arguments";
+				break;
+
+			case CXError_ASTReadError:
+				errorName = "AST read error";
+				break;
+
+			default:
+				errorName = "generic failure";
+				break;
+		}
+
+		out_errorMessage = "Failed to initialize translation unit for file: " + toParseFile.string() + " (" + errorName + ").";
+
+		return nullptr;
+	}
+
+	return translationUnit;
+}
+
 bool FileParser::prepareForParsing(fs::path const& toParseFile, const kodgen::MacroCodeGenUnitSettings* codeGenSettings, std::set<std::string>& notFoundGeneratedMacroNames) noexcept
 {
 	assert(_settings.use_count() != 0);
 
 	if (!fs::exists(toParseFile) || fs::is_directory(toParseFile)) return false;
 
+	notFoundGeneratedMacroNames.clear();
+
+	// Shallow parsing skips includes, so the generated header macros are never known and don't need to be defined.
+	ParseProfile const* profile = _settings->findParseProfile(toParseFile);
+	if (profile != nullptr && profile->parseMode == EParseMode::Shallow) return true;
+
 	// Do initial parsing.
-	CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex, toParseFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing);
+	std::string			errorMessage;
+	CXTranslationUnit	translationUnit = parseTranslationUnit(toParseFile, profile, true, errorMessage);
 	if (!translationUnit)
 	{ 
-		logger->log("Failed to initialize translation unit for file: " + toParseFile.string(), ILogger::ELogSeverity::Error);
+		logger->log(errorMessage, ILogger::ELogSeverity::Error);
 		return false;
 	}
 
 	// Process errors.
-	notFoundGeneratedMacroNames.clear();
 	const auto errors = getErrors(toParseFile, translationUnit, codeGenSettings, notFoundGeneratedMacroNames);
 	
 	clang_disposeTranslationUnit(translationUnit);
@@ -75,25 +228,38 @@ bool FileParser::parseFailOnErrors(fs::path const& toParseFile, FileParsingResul
 		out_result.parsedFile = FilesystemHelpers::sanitizePath(toParseFile);
 
 		// Parse the given file.
-		auto translationUnit = clang_parseTranslationUnit(_clangIndex, toParseFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing);
+		ParseProfile const*	profile = _settings->findParseProfile(toParseFile);
+		std::string			errorMessage;
+		auto				translationUnit = parseTranslationUnit(toParseFile, profile, false, errorMessage);
 		
 		if (translationUnit != nullptr)
 		{
-			std::set<std::string> notFoundGeneratedMacroNames;
-			const auto errors = getErrors(toParseFile, translationUnit, codeGenSettings, notFoundGeneratedMacroNames);
+			// Shallow parsing skips includes, errors are expected and don't make the parsing result incorrect.
+			std::set<std::string>		notFoundGeneratedMacroNames;
+			std::vector<std::string>	errors;
+			if (profile == nullptr || profile->parseMode != EParseMode::Shallow)
+			{
+				errors = getErrors(toParseFile, translationUnit, codeGenSettings, notFoundGeneratedMacroNames);
+			}
 			
 			if (errors.empty() && notFoundGeneratedMacroNames.empty())
 			{
+				AllocationStageScope allocationStageScope(EAllocationStage::EntityParsing);
+
 				ParsingContext& context = pushContext(translationUnit, out_result);
 
-				if (clang_visitChildren(context.rootCursor, &FileParser::parseNestedEntity, this) || !out_result.errors.empty())
+				if (!parseTopLevelEntities(translationUnit, context.rootCursor, out_result) || !out_result.errors.empty())
 				{
 					//ERROR
 				}
 				else
 				{
 					//Refresh all outer entities contained in the final result
-					refreshOuterEntity(out_result);
+					//Streamed entities have already been refreshed, and may be read by other threads
+					if (!topLevelEntityListener)
+					{
+						refreshOuterEntity(out_result);
+					}
 
 					isSuccess = true;
 				}
@@ -124,7 +290,7 @@ bool FileParser::parseFailOnErrors(fs::path const& toParseFile, FileParsingResul
 		}
 		else
 		{
-			out_result.errors.emplace_back("Failed to initialize translation unit for file: " + toParseFile.string());
+			out_result.errors.emplace_back(std::move(errorMessage));
 		}
 	}
 	else
@@ -157,20 +323,27 @@ bool FileParser::parseIgnoreErrors(fs::path const& toParseFile, FileParsingResul
 		out_result.parsedFile = FilesystemHelpers::sanitizePath(toParseFile);
 
 		//Parse the given file
-		CXTranslationUnit translationUnit = clang_parseTranslationUnit(_clangIndex, toParseFile.string().c_str(), _settings->getCompilationArguments().data(), static_cast<int32>(_settings->getCompilationArguments().size()), nullptr, 0, CXTranslationUnit_SkipFunctionBodies | CXTranslationUnit_Incomplete | CXTranslationUnit_KeepGoing);
+		std::string			errorMessage;
+		CXTranslationUnit	translationUnit = parseTranslationUnit(toParseFile, _settings->findParseProfile(toParseFile), false, errorMessage);
 
 		if (translationUnit != nullptr)
 		{
+			AllocationStageScope allocationStageScope(EAllocationStage::EntityParsing);
+
 			ParsingContext& context = pushContext(translationUnit, out_result);
 
-			if (clang_visitChildren(context.rootCursor, &FileParser::parseNestedEntity, this) || !out_result.errors.empty())
+			if (!parseTopLevelEntities(translationUnit, context.rootCursor, out_result) || !out_result.errors.empty())
 			{
 				//ERROR
 			}
 			else
 			{
 				//Refresh all outer entities contained in the final result
-				refreshOuterEntity(out_result);
+				//Streamed entities have already been refreshed, and may be read by other threads
+				if (!topLevelEntityListener)
+				{
+					refreshOuterEntity(out_result);
+				}
 
 				isSuccess = true;
 			}
@@ -189,7 +362,7 @@ bool FileParser::parseIgnoreErrors(fs::path const& toParseFile, FileParsingResul
 		}
 		else
 		{
-			out_result.errors.emplace_back("Failed to initialize translation unit for file: " + toParseFile.string());
+			out_result.errors.emplace_back(std::move(errorMessage));
 		}
 	}
 	else
@@ -252,6 +425,129 @@ CXChildVisitResult FileParser::parseNestedEntity(CXCursor cursor, CXCursor /* pa
 	return visitResult;
 }
 
+std::vector<CXCursor> FileParser::getMainFileTopLevelCursors(CXTranslationUnit const& translationUnit, CXCursor const& rootCursor) noexcept
+{
+	std::vector<CXCursor>	result;
+	CXToken*				tokens		= nullptr;
+	unsigned int			tokenCount	= 0u;
+
+	//The translation unit cursor extent covers the main file only
+	clang_tokenize(translationUnit, clang_getCursorExtent(rootCursor), &tokens, &tokenCount);
+
+	if (tokenCount == 0u)
+	{
+		return result;
+	}
+
+	//Annotating tokens only visits the declarations overlapping the main file
+	std::vector<CXCursor> tokenCursors(tokenCount);
+	clang_annotateTokens(translationUnit, tokens, tokenCount, tokenCursors.data());
+	clang_disposeTokens(translationUnit, tokens, tokenCount);
+
+	std::unordered_set<unsigned int> topLevelCursorHashes;
+
+	for (CXCursor cursor : tokenCursors)
+	{
+		//References and expressions have no lexical parent, but each declaration has at least one token annotated with itself or a nested declaration
+		if (!clang_isDeclaration(cursor.kind))
+		{
+			continue;
+		}
+
+		for (CXCursor parent = clang_getCursorLexicalParent(cursor); !clang_Cursor_isNull(parent) && parent.kind != CXCursorKind::CXCursor_TranslationUnit; parent = clang_getCursorLexicalParent(cursor))
+		{
+			cursor = parent;
+		}
+
+		//Tokens of a declaration are contiguous, so most tokens are rejected by the first comparison
+		if ((!result.empty() && clang_equalCursors(result.back(), cursor)) || !clang_Location_isFromMainFile(clang_getCursorLocation(cursor)))
+		{
+			continue;
+		}
+
+		unsigned int hash = clang_hashCursor(cursor);
+
+		if (topLevelCursorHashes.insert(hash).second ||
+			std::none_of(result.cbegin(), result.cend(), [&cursor](CXCursor const& topLevelCursor) { return clang_equalCursors(topLevelCursor, cursor); }))
+		{
+			result.push_back(cursor);
+		}
+	}
+
+	return result;
+}
+
+void FileParser::reserveTopLevelEntities(CXCursor const& rootCursor, std::vector<CXCursor> const* mainFileCursors, FileParsingResult& out_result) noexcept
+{
+	TopLevelEntityCounts counts;
+
+	if (mainFileCursors != nullptr)
+	{
+		for (CXCursor const& cursor : *mainFileCursors)
+		{
+			countTopLevelEntity(cursor, rootCursor, &counts);
+		}
+	}
+	else
+	{
+		clang_visitChildren(rootCursor, &countTopLevelEntity, &counts);
+	}
+
+	out_result.namespaces.reserve(counts.namespaceCount);
+	out_result.enums.reserve(counts.enumCount);
+
+	//The struct/class keyword is only known once parsed, so reserve space for all of them in both collections
+	out_result.structs.reserve(counts.structClassCount);
+	out_result.classes.reserve(counts.structClassCount);
+}
+
+bool FileParser::parseTopLevelEntities(CXTranslationUnit const& translationUnit, CXCursor const& rootCursor, FileParsingResult& out_result) noexcept
+{
+	if (!_settings->shouldVisitMainFileOnly)
+	{
+		if (topLevelEntityListener)
+		{
+			reserveTopLevelEntities(rootCursor, nullptr, out_result);
+		}
+
+		return clang_visitChildren(rootCursor, &FileParser::parseNestedEntity, this) == 0u;
+	}
+
+	std::vector<CXCursor> mainFileCursors = getMainFileTopLevelCursors(translationUnit, rootCursor);
+
+	if (topLevelEntityListener)
+	{
+		reserveTopLevelEntities(rootCursor, &mainFileCursors, out_result);
+	}
+
+	DISABLE_WARNING_PUSH
+	DISABLE_WARNING_UNSCOPED_ENUM
+
+	//Replicate clang_visitChildren behaviour for the visit results of each top-level cursor
+	for (CXCursor const& cursor : mainFileCursors)
+	{
+		switch (parseNestedEntity(cursor, rootCursor, this))
+		{
+			case CXChildVisitResult::CXChildVisit_Break:
+				return false;
+
+			case CXChildVisitResult::CXChildVisit_Recurse:
+				if (clang_visitChildren(cursor, &FileParser::parseNestedEntity, this) != 0u)
+				{
+					return false;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	DISABLE_WARNING_POP
+
+	return true;
+}
+
 ParsingContext& FileParser::pushContext(CXTranslationUnit const& translationUnit, FileParsingResult& out_result) noexcept
 {
 	_propertyParser.setup(_settings->propertyParsingSettings);
@@ -274,7 +570,7 @@ void FileParser::addNamespaceResult(NamespaceParsingResult&& result) noexcept
 {
 	if (result.parsedNamespace.has_value())
 	{
-		getParsingResult()->namespaces.emplace_back(std::move(result.parsedNamespace).value());
+		notifyTopLevelEntity(getParsingResult()->namespaces.emplace_back(std::move(result.parsedNamespace).value()));
 	}
 
 	getParsingResult()->appendResultErrors(result);
@@ -287,11 +583,11 @@ void FileParser::addClassResult(ClassParsingResult&& result) noexcept
 		switch (result.parsedClass->entityType)
 		{
 			case EEntityType::Struct:
-				getParsingResult()->structs.emplace_back(std::move(result.parsedClass).value());
+				notifyTopLevelEntity(getParsingResult()->structs.emplace_back(std::move(result.parsedClass).value()));
 				break;
 
 			case EEntityType::Class:
-				getParsingResult()->classes.emplace_back(std::move(result.parsedClass).value());
+				notifyTopLevelEntity(getParsingResult()->classes.emplace_back(std::move(result.parsedClass).value()));
 				break;
 
 			default:
@@ -307,7 +603,7 @@ void FileParser::addEnumResult(EnumParsingResult&& result) noexcept
 {
 	if (result.parsedEnum.has_value())
 	{
-		getParsingResult()->enums.emplace_back(std::move(result.parsedEnum).value());
+		notifyTopLevelEntity(getParsingResult()->enums.emplace_back(std::move(result.parsedEnum).value()));
 	}
 
 	getParsingResult()->appendResultErrors(result);
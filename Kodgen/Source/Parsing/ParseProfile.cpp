@@ -0,0 +1,10 @@
+#include "Kodgen/Parsing/ParseProfile.h"
+
+#include <algorithm>	//std::any_of
+
+using namespace kodgen;
+
+bool ParseProfile::matches(fs::path const& file) const noexcept
+{
+	return std::any_of(patterns.cbegin(), patterns.cend(), [&file](std::string const& pattern) { return FilesystemHelpers::matchesGlob(file, pattern); });
+}
\ No newline at end of file
@@ -0,0 +1,611 @@
+#include "Kodgen/Parsing/ParsingResults/ParsingResultSnapshot.h"
+
+#include <fstream>
+#include <cstring>		//std::memcpy
+#include <iterator>		//std::istreambuf_iterator
+#include <type_traits>
+
+using namespace kodgen;
+
+class ParsingResultSnapshot::Writer
+{
+	private:
+		std::string& _out;
+
+	public:
+		Writer(std::string& out) noexcept:
+			_out{out}
+		{
+		}
+
+		template <typename T>
+		void writeValue(T value) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written as raw bytes.");
+
+			_out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+		}
+
+		template <typename T>
+		void writeVector(std::vector<T> const& values) noexcept
+		{
+			writeValue<uint64>(values.size());
+
+			for (T const& value : values)
+			{
+				write(value);
+			}
+		}
+
+		void write(std::string const& value) noexcept
+		{
+			writeValue<uint64>(value.size());
+			_out.append(value);
+		}
+
+		void write(Property const& property) noexcept
+		{
+			write(property.name);
+			writeVector(property.arguments);
+		}
+
+		void writeEntity(EntityInfo const& entity) noexcept
+		{
+			writeValue(entity.entityType);
+			write(entity.name);
+			write(entity.id);
+			writeVector(entity.properties);
+		}
+
+		void write(TemplateParamInfo const& templateParam) noexcept
+		{
+			writeValue(templateParam.kind);
+			write(templateParam.name);
+			writeValue<bool>(templateParam.type != nullptr);
+
+			if (templateParam.type != nullptr)
+			{
+				write(*templateParam.type);
+			}
+		}
+
+		void write(TypePart const& typePart) noexcept
+		{
+			writeValue(typePart);
+		}
+
+		void write(TypeInfo const& type) noexcept
+		{
+			write(type._fullName);
+			write(type._canonicalFullName);
+			writeVector(type._templateParameters);
+			writeVector(type.typeParts);
+			writeValue<uint64>(type.sizeInBytes);
+			writeValue<uint64>(type.alignment);
+		}
+
+		void write(FunctionParamInfo const& param) noexcept
+		{
+			write(param.type);
+			write(param.name);
+		}
+
+		void write(VariableInfo const& variable) noexcept
+		{
+			writeEntity(variable);
+			writeValue<bool>(variable.isStatic);
+			write(variable.type);
+		}
+
+		void write(FieldInfo const& field) noexcept
+		{
+			write(static_cast<VariableInfo const&>(field));
+			writeValue<bool>(field.isMutable);
+			writeValue<bool>(field.isBitField);
+			writeValue(field.accessSpecifier);
+			writeValue(field.memoryOffset);
+		}
+
+		void write(FunctionInfo const& function) noexcept
+		{
+			writeEntity(function);
+			write(function.prototype);
+			write(function.returnType);
+			writeVector(function.parameters);
+			writeValue<bool>(function.isInline);
+			writeValue<bool>(function.isStatic);
+		}
+
+		void write(MethodInfo const& method) noexcept
+		{
+			write(static_cast<FunctionInfo const&>(method));
+			writeValue(method.accessSpecifier);
+			writeValue<bool>(method.isDefault);
+			writeValue<bool>(method.isVirtual);
+			writeValue<bool>(method.isPureVirtual);
+			writeValue<bool>(method.isOverride);
+			writeValue<bool>(method.isFinal);
+			writeValue<bool>(method.isConst);
+		}
+
+		void write(EnumValueInfo const& enumValue) noexcept
+		{
+			writeEntity(enumValue);
+			writeValue(enumValue.value);
+		}
+
+		void write(EnumInfo const& enum_) noexcept
+		{
+			writeEntity(enum_);
+			write(enum_.type);
+			write(enum_.underlyingType);
+			writeVector(enum_.enumValues);
+		}
+
+		void write(NestedEnumInfo const& nestedEnum) noexcept
+		{
+			write(static_cast<EnumInfo const&>(nestedEnum));
+			writeValue(nestedEnum.accessSpecifier);
+		}
+
+		void write(StructClassInfo::ParentInfo const& parent) noexcept
+		{
+			writeValue(parent.inheritanceAccess);
+			write(parent.type);
+		}
+
+		void write(std::shared_ptr<NestedStructClassInfo> const& nestedStruct) noexcept
+		{
+			write(static_cast<StructClassInfo const&>(*nestedStruct));
+			writeValue(nestedStruct->accessSpecifier);
+		}
+
+		void write(StructClassInfo const& struct_) noexcept
+		{
+			writeEntity(struct_);
+			writeValue<bool>(struct_.qualifiers.isFinal);
+			writeValue<bool>(struct_.isForwardDeclaration);
+			writeValue<bool>(struct_.isImportExport);
+			write(struct_.type);
+			writeVector(struct_.parents);
+			writeVector(struct_.nestedClasses);
+			writeVector(struct_.nestedStructs);
+			writeVector(struct_.nestedEnums);
+			writeVector(struct_.fields);
+			writeVector(struct_.methods);
+		}
+
+		void write(NamespaceInfo const& namespace_) noexcept
+		{
+			writeEntity(namespace_);
+			writeVector(namespace_.namespaces);
+			writeVector(namespace_.structs);
+			writeVector(namespace_.classes);
+			writeVector(namespace_.enums);
+			writeVector(namespace_.functions);
+			writeVector(namespace_.variables);
+		}
+
+		void write(FileParsingResult const& parsingResult) noexcept
+		{
+			write(parsingResult.parsedFile.string());
+			writeVector(parsingResult.namespaces);
+			writeVector(parsingResult.classes);
+			writeVector(parsingResult.structs);
+			writeVector(parsingResult.enums);
+			writeVector(parsingResult.functions);
+			writeVector(parsingResult.variables);
+
+			writeValue<uint64>(parsingResult.structClassTree.getEntries().size());
+
+			for (auto const& [childName, inheritanceLinks] : parsingResult.structClassTree.getEntries())
+			{
+				write(childName);
+				writeValue<uint64>(inheritanceLinks.size());
+
+				for (StructClassTree::InheritanceLink const& inheritanceLink : inheritanceLinks)
+				{
+					write(inheritanceLink.inheritedStructClassName);
+					writeValue(inheritanceLink.inheritanceAccess);
+				}
+			}
+		}
+};
+
+class ParsingResultSnapshot::Reader
+{
+	private:
+		char const*	_cursor;
+		char const*	_end;
+		bool		_isValid = true;
+
+	public:
+		Reader(char const* data, size_t size) noexcept:
+			_cursor{data},
+			_end{data + size}
+		{
+		}
+
+		bool isValid() const noexcept
+		{
+			return _isValid;
+		}
+
+		template <typename T>
+		T readValue() noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read as raw bytes.");
+
+			T result{};
+
+			if (static_cast<size_t>(_end - _cursor) < sizeof(T))
+			{
+				_isValid	= false;
+				_cursor		= _end;
+			}
+			else
+			{
+				std::memcpy(&result, _cursor, sizeof(T));
+				_cursor += sizeof(T);
+			}
+
+			return result;
+		}
+
+		/**
+		*	@brief Read a vector size, checking that it is not bigger than the remaining data to avoid huge allocations on corrupted data.
+		*/
+		size_t readSize() noexcept
+		{
+			uint64 size = readValue<uint64>();
+
+			if (size > static_cast<uint64>(_end - _cursor))
+			{
+				_isValid	= false;
+				_cursor		= _end;
+
+				return 0u;
+			}
+
+			return static_cast<size_t>(size);
+		}
+
+		template <typename T>
+		void readVector(std::vector<T>& out_values) noexcept
+		{
+			size_t size = readSize();
+
+			out_values.reserve(size);
+
+			for (size_t i = 0u; i < size && _isValid; i++)
+			{
+				T value;
+				read(value);
+
+				out_values.emplace_back(std::move(value));
+			}
+		}
+
+		void read(std::string& out_value) noexcept
+		{
+			size_t size = readSize();
+
+			out_value.assign(_cursor, size);
+			_cursor += size;
+		}
+
+		void read(Property& out_property) noexcept
+		{
+			read(out_property.name);
+			readVector(out_property.arguments);
+		}
+
+		void readEntity(EntityInfo& out_entity) noexcept
+		{
+			out_entity.entityType = readValue<EEntityType>();
+			read(out_entity.name);
+			read(out_entity.id);
+			readVector(out_entity.properties);
+		}
+
+		void read(TemplateParamInfo& out_templateParam) noexcept
+		{
+			out_templateParam.kind = readValue<ETemplateParameterKind>();
+			read(out_templateParam.name);
+
+			if (readValue<bool>())
+			{
+				out_templateParam.type = std::make_unique<TypeInfo>();
+				read(*out_templateParam.type);
+			}
+		}
+
+		void read(TypePart& out_typePart) noexcept
+		{
+			out_typePart = readValue<TypePart>();
+		}
+
+		void read(TypeInfo& out_type) noexcept
+		{
+			read(out_type._fullName);
+			read(out_type._canonicalFullName);
+			readVector(out_type._templateParameters);
+			readVector(out_type.typeParts);
+			out_type.sizeInBytes	= static_cast<size_t>(readValue<uint64>());
+			out_type.alignment		= static_cast<size_t>(readValue<uint64>());
+		}
+
+		void read(FunctionParamInfo& out_param) noexcept
+		{
+			read(out_param.type);
+			read(out_param.name);
+		}
+
+		void read(VariableInfo& out_variable) noexcept
+		{
+			readEntity(out_variable);
+			out_variable.isStatic = readValue<bool>();
+			read(out_variable.type);
+		}
+
+		void read(FieldInfo& out_field) noexcept
+		{
+			read(static_cast<VariableInfo&>(out_field));
+			out_field.isMutable			= readValue<bool>();
+			out_field.isBitField		= readValue<bool>();
+			out_field.accessSpecifier	= readValue<EAccessSpecifier>();
+			out_field.memoryOffset		= readValue<int64>();
+		}
+
+		void read(FunctionInfo& out_function) noexcept
+		{
+			readEntity(out_function);
+			read(out_function.prototype);
+			read(out_function.returnType);
+			readVector(out_function.parameters);
+			out_function.isInline	= readValue<bool>();
+			out_function.isStatic	= readValue<bool>();
+		}
+
+		void read(MethodInfo& out_method) noexcept
+		{
+			read(static_cast<FunctionInfo&>(out_method));
+			out_method.accessSpecifier	= readValue<EAccessSpecifier>();
+			out_method.isDefault		= readValue<bool>();
+			out_method.isVirtual		= readValue<bool>();
+			out_method.isPureVirtual	= readValue<bool>();
+			out_method.isOverride		= readValue<bool>();
+			out_method.isFinal			= readValue<bool>();
+			out_method.isConst			= readValue<bool>();
+		}
+
+		void read(EnumValueInfo& out_enumValue) noexcept
+		{
+			readEntity(out_enumValue);
+			out_enumValue.value = readValue<int64>();
+		}
+
+		void read(EnumInfo& out_enum) noexcept
+		{
+			readEntity(out_enum);
+			read(out_enum.type);
+			read(out_enum.underlyingType);
+			readVector(out_enum.enumValues);
+		}
+
+		void read(StructClassInfo& out_struct) noexcept
+		{
+			readEntity(out_struct);
+			out_struct.qualifiers.isFinal		= readValue<bool>();
+			out_struct.isForwardDeclaration		= readValue<bool>();
+			out_struct.isImportExport			= readValue<bool>();
+			read(out_struct.type);
+
+			size_t parentCount = readSize();
+
+			for (size_t i = 0u; i < parentCount && _isValid; i++)
+			{
+				EAccessSpecifier	inheritanceAccess = readValue<EAccessSpecifier>();
+				TypeInfo			parentType;
+
+				read(parentType);
+
+				out_struct.parents.emplace_back(inheritanceAccess, std::move(parentType));
+			}
+
+			readNestedStructs(out_struct.nestedClasses);
+			readNestedStructs(out_struct.nestedStructs);
+
+			size_t nestedEnumCount = readSize();
+
+			for (size_t i = 0u; i < nestedEnumCount && _isValid; i++)
+			{
+				EnumInfo nestedEnum;
+				read(nestedEnum);
+
+				out_struct.nestedEnums.emplace_back(std::move(nestedEnum), readValue<EAccessSpecifier>());
+			}
+
+			readVector(out_struct.fields);
+			readVector(out_struct.methods);
+		}
+
+		void readNestedStructs(std::vector<std::shared_ptr<NestedStructClassInfo>>& out_nestedStructs) noexcept
+		{
+			size_t size = readSize();
+
+			for (size_t i = 0u; i < size && _isValid; i++)
+			{
+				StructClassInfo nestedStruct;
+				read(nestedStruct);
+
+				out_nestedStructs.emplace_back(std::make_shared<NestedStructClassInfo>(std::move(nestedStruct), readValue<EAccessSpecifier>()));
+			}
+		}
+
+		void read(NamespaceInfo& out_namespace) noexcept
+		{
+			readEntity(out_namespace);
+			readVector(out_namespace.namespaces);
+			readVector(out_namespace.structs);
+			readVector(out_namespace.classes);
+			readVector(out_namespace.enums);
+			readVector(out_namespace.functions);
+			readVector(out_namespace.variables);
+		}
+
+		void read(FileParsingResult& out_parsingResult) noexcept
+		{
+			std::string parsedFile;
+			read(parsedFile);
+
+			out_parsingResult.parsedFile = parsedFile;
+			readVector(out_parsingResult.namespaces);
+			readVector(out_parsingResult.classes);
+			readVector(out_parsingResult.structs);
+			readVector(out_parsingResult.enums);
+			readVector(out_parsingResult.functions);
+			readVector(out_parsingResult.variables);
+
+			size_t entryCount = readSize();
+
+			for (size_t i = 0u; i < entryCount && _isValid; i++)
+			{
+				std::string childName;
+				read(childName);
+
+				size_t inheritanceLinkCount = readSize();
+
+				for (size_t j = 0u; j < inheritanceLinkCount && _isValid; j++)
+				{
+					std::string parentName;
+					read(parentName);
+
+					out_parsingResult.structClassTree.addInheritanceLink(childName, parentName, readValue<EAccessSpecifier>());
+				}
+			}
+		}
+};
+
+void ParsingResultSnapshot::add(FileParsingResult const& parsingResult) noexcept
+{
+	//Serialize outside of the lock, only the final copy is synchronized
+	std::string serializedResult;
+	Writer(serializedResult).write(parsingResult);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_resultOffsets.push_back(_data.size());
+
+	Writer(_data).writeValue<uint64>(serializedResult.size());
+	_data.append(serializedResult);
+}
+
+bool ParsingResultSnapshot::getResult(size_t index, FileParsingResult& out_result) const noexcept
+{
+	if (index >= _resultOffsets.size())
+	{
+		return false;
+	}
+
+	Reader sizeReader(_data.data() + _resultOffsets[index], sizeof(uint64));
+	Reader reader(_data.data() + _resultOffsets[index] + sizeof(uint64), static_cast<size_t>(sizeReader.readValue<uint64>()));
+
+	reader.read(out_result);
+
+	if (!reader.isValid())
+	{
+		return false;
+	}
+
+	//Outer entities are not serialized, they point to the entities containing them
+	for (NamespaceInfo& namespaceInfo : out_result.namespaces)
+	{
+		namespaceInfo.refreshOuterEntity();
+	}
+
+	for (StructClassInfo& structInfo : out_result.structs)
+	{
+		structInfo.refreshOuterEntity();
+	}
+
+	for (StructClassInfo& classInfo : out_result.classes)
+	{
+		classInfo.refreshOuterEntity();
+	}
+
+	for (EnumInfo& enumInfo : out_result.enums)
+	{
+		enumInfo.refreshOuterEntity();
+	}
+
+	return true;
+}
+
+size_t ParsingResultSnapshot::getResultCount() const noexcept
+{
+	return _resultOffsets.size();
+}
+
+void ParsingResultSnapshot::clear() noexcept
+{
+	_data.clear();
+	_resultOffsets.clear();
+}
+
+bool ParsingResultSnapshot::save(fs::path const& path) const noexcept
+{
+	std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << _fileHeader << _data;
+
+	return file.good();
+}
+
+bool ParsingResultSnapshot::load(fs::path const& path) noexcept
+{
+	clear();
+
+	std::ifstream	file(path, std::ios::in | std::ios::binary);
+	size_t			headerSize = std::strlen(_fileHeader);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	if (file.bad() || _data.compare(0u, headerSize, _fileHeader) != 0)
+	{
+		clear();
+
+		return false;
+	}
+
+	_data.erase(0u, headerSize);
+
+	//Index all results
+	for (size_t offset = 0u; offset < _data.size(); )
+	{
+		Reader	reader(_data.data() + offset, _data.size() - offset);
+		size_t	resultSize = reader.readSize();
+
+		if (!reader.isValid())
+		{
+			clear();
+
+			return false;
+		}
+
+		_resultOffsets.push_back(offset);
+		offset += sizeof(uint64) + resultSize;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -1,9 +1,16 @@
 #include "Kodgen/Parsing/ParsingSettings.h"
 
+#include <cstdlib>	//std::getenv
+#include <mutex>	//std::call_once
+#include <cctype>	//std::isspace
+
+#include <clang-c/Index.h>
+
 #include "Kodgen/Misc/CompilerHelpers.h"
 #include "Kodgen/Misc/TomlUtility.h"
 #include "Kodgen/Misc/ILogger.h"
 #include "Kodgen/Misc/Helpers.h"
+#include "Kodgen/Misc/System.h"
 
 using namespace kodgen;
 
@@ -22,9 +29,93 @@ opt::optional<ECppVersion> ParsingSettings::getMatchingCppVersion(uint8 cppVersi
 	}
 }
 
+std::vector<std::string> ParsingSettings::splitArguments(std::string const& commandLine) noexcept
+{
+	std::vector<std::string>	result;
+	std::string					currentArgument;
+	bool						isInArgument	= false;
+	char						quote			= '\0';
+
+	for (std::string::size_type i = 0u; i < commandLine.size(); i++)
+	{
+		char c = commandLine[i];
+
+		//Backslashes only escape quotes and whitespaces so that Windows paths are kept as is. Single quoted strings have no escapes.
+		if (c == '\\' && quote != '\'' && i + 1u < commandLine.size() &&
+			(commandLine[i + 1u] == '"' || (quote == '\0' && (commandLine[i + 1u] == '\'' || std::isspace(static_cast<unsigned char>(commandLine[i + 1u]))))))
+		{
+			currentArgument.push_back(commandLine[++i]);
+			isInArgument = true;
+		}
+		else if (quote != '\0')
+		{
+			if (c == quote)
+			{
+				quote = '\0';
+			}
+			else
+			{
+				currentArgument.push_back(c);
+			}
+		}
+		else if (c == '"' || c == '\'')
+		{
+			quote			= c;
+			isInArgument	= true;
+		}
+		else if (std::isspace(static_cast<unsigned char>(c)))
+		{
+			if (isInArgument)
+			{
+				result.emplace_back(std::move(currentArgument));
+				currentArgument.clear();
+				isInArgument = false;
+			}
+		}
+		else
+		{
+			currentArgument.push_back(c);
+			isInArgument = true;
+		}
+	}
+
+	if (isInArgument)
+	{
+		result.emplace_back(std::move(currentArgument));
+	}
+
+	return result;
+}
+
 void ParsingSettings::init(ILogger* logger) noexcept
 {
 	refreshCompilationArguments(logger);
+	applyClangExecutionSettings(logger);
+}
+
+void ParsingSettings::applyClangExecutionSettings(ILogger* logger) const noexcept
+{
+	clang_toggleCrashRecovery(shouldUseClangCrashRecovery ? 1u : 0u);
+
+	if (!shouldRunClangOnCallingThread)
+	{
+		return;
+	}
+
+	//libclang reads LIBCLANG_NOTHREADS with getenv on every parse, and writing the environment while another thread reads it is a data race.
+	//It is set once for the whole process, before the first parse since settings are initialized before their files are parsed, and never unset.
+	static std::once_flag	setNoThreadsFlag;
+	static bool				isNoThreadsSet = false;
+
+	std::call_once(setNoThreadsFlag, []()
+	{
+		isNoThreadsSet = std::getenv("LIBCLANG_NOTHREADS") != nullptr || System::setEnvironmentVariable("LIBCLANG_NOTHREADS", "1");
+	});
+
+	if (!isNoThreadsSet && logger != nullptr)
+	{
+		logger->log("Failed to set LIBCLANG_NOTHREADS, libclang will keep parsing on its own threads.", ILogger::ELogSeverity::Warning);
+	}
 }
 
 void ParsingSettings::refreshBuildCommandStrings(ILogger* logger) noexcept
@@ -99,15 +190,21 @@ void ParsingSettings::refreshCompilationArguments(ILogger* logger) noexcept
 													*	9 because we make an additional parameter per possible entity
 													*	Namespace, Class, Struct, Variable, Field, Function, Method, Enum, EnumValue
 													*/
-	_compilationArguments.reserve(baseCompilationArgCount + 9u + _projectIncludeDirs.size());
+	_additionalClangArgumentList = splitArguments(_additionalClangArguments);
+
+	_compilationArguments.reserve(baseCompilationArgCount + 9u + _additionalClangArgumentList.size() + _projectIncludeDirs.size());
 
 	//Parsing C++
 	_compilationArguments.emplace_back("-xc++");
 
-	// Disable error limit so our pre-parsing step will not skip anything.
-	_compilationArguments.emplace_back("-ferror-limit=0");
+	//Overridden by -ferror-limit=0 in the pre-parsing arguments
+	_errorLimitCommandLine = "-ferror-limit=" + std::to_string(clangErrorLimit);
+	_compilationArguments.emplace_back(_errorLimitCommandLine.data());
 
-	_compilationArguments.emplace_back(_additionalClangArguments.data());
+	for (std::string const& additionalClangArgument : _additionalClangArgumentList)
+	{
+		_compilationArguments.emplace_back(additionalClangArgument.data());
+	}
 
 #if KODGEN_DEV
 	_compilationArguments.emplace_back("-v");
@@ -129,10 +226,71 @@ void ParsingSettings::refreshCompilationArguments(ILogger* logger) noexcept
 	_compilationArguments.emplace_back(_enumPropertyMacro.data());
 	_compilationArguments.emplace_back(_enumValuePropertyMacro.data());
 
+	size_t includeDirsIndex = _compilationArguments.size();
+
 	for (std::string const& includeDir : _projectIncludeDirs)
 	{
 		_compilationArguments.emplace_back(includeDir.data());
 	}
+
+	//Disable error limit so our pre-parsing step will not skip anything
+	//It must be the last argument so that it overrides any -ferror-limit of the additional clang arguments (the last one wins)
+	_preParsingCompilationArguments = _compilationArguments;
+	_preParsingCompilationArguments.emplace_back("-ferror-limit=0");
+
+	//Profile arguments reference strings owned by the element itself, so the vector must not reallocate once filled
+	_parseProfilesCompilationArguments.clear();
+	_parseProfilesCompilationArguments.resize(parseProfiles.size());
+
+	for (size_t i = 0u; i < parseProfiles.size(); i++)
+	{
+		ParseProfile const&				profile		= parseProfiles[i];
+		ProfileCompilationArguments&	arguments	= _parseProfilesCompilationArguments[i];
+
+		arguments.ownedArguments.reserve(profile.stubIncludeDirectories.size() + profile.additionalClangArguments.size() + 2u);
+
+		for (fs::path const& stubIncludeDirectory : profile.stubIncludeDirectories)
+		{
+			fs::path sanitizedPath = FilesystemHelpers::sanitizePath(stubIncludeDirectory);
+
+			if (sanitizedPath.empty() && logger != nullptr)
+			{
+				logger->log("Stub include directory " + stubIncludeDirectory.string() + " of the parse profile " + profile.name + " doesn't exist.", ILogger::ELogSeverity::Warning);
+			}
+
+			arguments.ownedArguments.emplace_back("-I" + (sanitizedPath.empty() ? stubIncludeDirectory : sanitizedPath).string());
+		}
+
+		size_t stubIncludeDirsCount = arguments.ownedArguments.size();
+
+		arguments.ownedArguments.insert(arguments.ownedArguments.cend(), profile.additionalClangArguments.cbegin(), profile.additionalClangArguments.cend());
+
+		if (!profile.precompiledHeader.empty())
+		{
+			arguments.ownedArguments.emplace_back("-include-pch");
+			arguments.ownedArguments.emplace_back(profile.precompiledHeader.string());
+		}
+
+		//Stub include directories must be searched before the project include directories
+		arguments.compilationArguments.reserve(_compilationArguments.size() + arguments.ownedArguments.size());
+		arguments.compilationArguments.assign(_compilationArguments.cbegin(), _compilationArguments.cbegin() + includeDirsIndex);
+
+		for (size_t j = 0u; j < stubIncludeDirsCount; j++)
+		{
+			arguments.compilationArguments.emplace_back(arguments.ownedArguments[j].data());
+		}
+
+		arguments.compilationArguments.insert(arguments.compilationArguments.cend(), _compilationArguments.cbegin() + includeDirsIndex, _compilationArguments.cend());
+
+		for (size_t j = stubIncludeDirsCount; j < arguments.ownedArguments.size(); j++)
+		{
+			arguments.compilationArguments.emplace_back(arguments.ownedArguments[j].data());
+		}
+
+		//Appended after the profile additional clang arguments for the same reason as _preParsingCompilationArguments
+		arguments.preParsingCompilationArguments = arguments.compilationArguments;
+		arguments.preParsingCompilationArguments.emplace_back("-ferror-limit=0");
+	}
 }
 
 bool ParsingSettings::loadSettingsValues(toml::value const& tomlData, ILogger* logger) noexcept
@@ -145,10 +303,14 @@ bool ParsingSettings::loadSettingsValues(toml::value const& tomlData, ILogger* l
 		loadShouldParseAllEntities(tomlParsingSettings, logger);
 		loadShouldAbortParsingOnFirstError(tomlParsingSettings, logger);
 		loadShouldLogDiagnostic(tomlParsingSettings, logger);
+		loadShouldVisitMainFileOnly(tomlParsingSettings, logger);
 		loadShouldFailCodeGenerationOnClangErrors(tomlParsingSettings, logger);
+		loadClangErrorLimit(tomlParsingSettings, logger);
+		loadClangExecutionSettings(tomlParsingSettings, logger);
 		loadCompilerExeName(tomlParsingSettings, logger);
 		loadProjectIncludeDirectories(tomlParsingSettings, logger);
 		loadAdditionalClangArguments(tomlParsingSettings, logger);
+		loadParseProfiles(tomlParsingSettings, logger);
 
 		return propertyParsingSettings.loadSettingsValues(tomlParsingSettings, logger);
 	}
@@ -249,6 +411,67 @@ void ParsingSettings::loadAdditionalClangArguments(toml::value const& tomlFilePa
 	}
 }
 
+void ParsingSettings::loadParseProfiles(toml::value const& tomlFileParsingSettings, ILogger* logger) noexcept
+{
+	toml::array tomlParseProfiles;
+
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "parseProfiles", tomlParseProfiles, logger))
+	{
+		parseProfiles.clear();
+		parseProfiles.reserve(tomlParseProfiles.size());
+
+		for (toml::value const& tomlParseProfile : tomlParseProfiles)
+		{
+			ParseProfile				profile;
+			std::string					parseMode;
+			std::string					additionalClangArguments;
+			std::vector<std::string>	stubIncludeDirectories;
+
+			TomlUtility::updateSetting(tomlParseProfile, "name", profile.name, logger);
+			TomlUtility::updateSetting(tomlParseProfile, "patterns", profile.patterns, logger);
+
+			if (TomlUtility::updateSetting(tomlParseProfile, "precompiledHeader", profile.precompiledHeader, logger))
+			{
+				profile.precompiledHeader = resolveSettingsPath(profile.precompiledHeader);
+			}
+
+			if (TomlUtility::updateSetting(tomlParseProfile, "parseMode", parseMode, logger))
+			{
+				if (parseMode == toString(EParseMode::Shallow))
+				{
+					profile.parseMode = EParseMode::Shallow;
+				}
+				else if (parseMode != toString(EParseMode::Full) && logger != nullptr)
+				{
+					logger->log("[TOML] Unknown parseMode " + parseMode + " in the parse profile " + profile.name + ", use Full or Shallow.", ILogger::ELogSeverity::Warning);
+				}
+			}
+
+			if (TomlUtility::updateSetting(tomlParseProfile, "additionalClangArguments", additionalClangArguments, logger))
+			{
+				profile.additionalClangArguments = splitArguments(additionalClangArguments);
+			}
+
+			if (TomlUtility::updateSetting(tomlParseProfile, "stubIncludeDirectories", stubIncludeDirectories, logger))
+			{
+				profile.stubIncludeDirectories.clear();
+
+				for (std::string const& stubIncludeDirectory : stubIncludeDirectories)
+				{
+					profile.stubIncludeDirectories.push_back(resolveSettingsPath(stubIncludeDirectory));
+				}
+			}
+
+			if (logger != nullptr)
+			{
+				logger->log("[TOML] Load parse profile: " + profile.name + " (" + toString(profile.parseMode) + ", " + std::to_string(profile.patterns.size()) + " pattern(s))");
+			}
+
+			parseProfiles.emplace_back(std::move(profile));
+		}
+	}
+}
+
 void ParsingSettings::loadShouldFailCodeGenerationOnClangErrors(toml::value const& tomlFileParsingSettings, ILogger* logger) noexcept
 {
 	if (TomlUtility::updateSetting(tomlFileParsingSettings, "shouldFailCodeGenerationOnClangErrors", shouldFailCodeGenerationOnClangErrors, logger) && logger != nullptr)
@@ -265,6 +488,40 @@ void ParsingSettings::loadShouldLogDiagnostic(toml::value const& tomlFileParsing
 	}
 }
 
+void ParsingSettings::loadShouldVisitMainFileOnly(toml::value const& tomlFileParsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "shouldVisitMainFileOnly", shouldVisitMainFileOnly, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldVisitMainFileOnly: " + Helpers::toString(shouldVisitMainFileOnly));
+	}
+}
+
+void ParsingSettings::loadClangErrorLimit(toml::value const& tomlFileParsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "clangErrorLimit", clangErrorLimit, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load clangErrorLimit: " + std::to_string(clangErrorLimit));
+	}
+}
+
+void ParsingSettings::loadClangExecutionSettings(toml::value const& tomlFileParsingSettings, ILogger* logger) noexcept
+{
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "shouldUseClangCrashRecovery", shouldUseClangCrashRecovery, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUseClangCrashRecovery: " + Helpers::toString(shouldUseClangCrashRecovery));
+	}
+
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "shouldRunClangOnCallingThread", shouldRunClangOnCallingThread, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldRunClangOnCallingThread: " + Helpers::toString(shouldRunClangOnCallingThread));
+	}
+
+	if (TomlUtility::updateSetting(tomlFileParsingSettings, "shouldUseClangBackgroundPriority", shouldUseClangBackgroundPriority, logger) && logger != nullptr)
+	{
+		logger->log("[TOML] Load shouldUseClangBackgroundPriority: " + Helpers::toString(shouldUseClangBackgroundPriority));
+	}
+}
+
 void ParsingSettings::loadCompilerExeName(toml::value const& parsingSettings, ILogger* logger) noexcept
 {
 	std::string compilerExeName;
@@ -358,6 +615,34 @@ std::vector<char const*> const& ParsingSettings::getCompilationArguments() const
 	return _compilationArguments;
 }
 
+std::vector<char const*> const& ParsingSettings::getPreParsingCompilationArguments() const noexcept
+{
+	return _preParsingCompilationArguments;
+}
+
+ParseProfile const* ParsingSettings::findParseProfile(fs::path const& file) const noexcept
+{
+	for (ParseProfile const& profile : parseProfiles)
+	{
+		if (profile.matches(file))
+		{
+			return &profile;
+		}
+	}
+
+	return nullptr;
+}
+
+std::vector<char const*> const& ParsingSettings::getCompilationArguments(ParseProfile const* profile) const noexcept
+{
+	return (profile != nullptr) ? _parseProfilesCompilationArguments[profile - parseProfiles.data()].compilationArguments : _compilationArguments;
+}
+
+std::vector<char const*> const& ParsingSettings::getPreParsingCompilationArguments(ParseProfile const* profile) const noexcept
+{
+	return (profile != nullptr) ? _parseProfilesCompilationArguments[profile - parseProfiles.data()].preParsingCompilationArguments : _preParsingCompilationArguments;
+}
+
 bool ParsingSettings::setCompilerExeName(std::string const& compilerExeName) noexcept
 {
 	if (CompilerHelpers::isSupportedCompiler(compilerExeName))
@@ -3,11 +3,14 @@
 #include <cassert>
 
 #include "Kodgen/Properties/Property.h"
+#include "Kodgen/Misc/AllocationTracker.h"
 
 using namespace kodgen;
 
 opt::optional<std::vector<Property>> PropertyParser::getProperties(std::string&& annotateMessage, std::string const& annotationId) noexcept
 {
+	AllocationStageScope allocationStageScope(EAllocationStage::PropertyParsing);
+
 	if (annotateMessage.substr(0, annotationId.size()) == annotationId)
 	{
 		if (splitProperties(annotateMessage.substr(annotationId.size())))
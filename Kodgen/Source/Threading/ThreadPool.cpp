@@ -1,12 +1,38 @@
 #include "Kodgen/Threading/ThreadPool.h"
 
 #include <cassert>
+#include <algorithm>
 
 using namespace kodgen;
 
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	*	@brief Get the time elapsed between two time points, ignoring the time elapsed before the last statistics reset.
+	*
+	*	@param start		The first time point.
+	*	@param end			The second time point.
+	*	@param resetTime	Time of the last statistics reset.
+	*
+	*	@return The elapsed time in nanoseconds.
+	*/
+	uint64 getElapsedNanoseconds(Clock::time_point start, Clock::time_point end, std::atomic<Clock::time_point> const& resetTime) noexcept
+	{
+		start = std::max(start, resetTime.load(std::memory_order_relaxed));
+
+		return (end > start) ? static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) : 0u;
+	}
+}
+
+thread_local ThreadPool const*	ThreadPool::_currentThreadPool	= nullptr;
+thread_local uint32				ThreadPool::_currentWorkerIndex	= 0u;
+
 ThreadPool::ThreadPool(uint32 threadCount, ETerminationMode	terminationMode) noexcept:
 	_destructorCalled{false},
 	_workingWorkers{threadCount},
+	_workerCounters(threadCount),
 	terminationMode{terminationMode}
 {
 	assert(threadCount > 0u);
@@ -16,7 +42,7 @@ ThreadPool::ThreadPool(uint32 threadCount, ETerminationMode	terminationMode) noe
 
 	for (uint32 i = 0u; i < threadCount; i++)
 	{
-		_workers.emplace_back(std::thread(std::bind(&ThreadPool::workerRoutine, this)));
+		_workers.emplace_back(std::thread(std::bind(&ThreadPool::workerRoutine, this, i)));
 	}
 }
 
@@ -39,9 +65,16 @@ ThreadPool::~ThreadPool() noexcept
 	}
 }
 
-void ThreadPool::workerRoutine() noexcept
+void ThreadPool::workerRoutine(uint32 workerIndex) noexcept
 {
-	std::unique_lock lock(_taskMutex);
+	_currentThreadPool	= this;
+	_currentWorkerIndex	= workerIndex;
+
+	WorkerCounters&		counters	= _workerCounters[workerIndex];
+	Clock::time_point	lockStart	= Clock::now();
+	std::unique_lock	lock(_taskMutex);
+
+	counters.taskMutexWaitTime.fetch_add(getElapsedNanoseconds(lockStart, Clock::now(), _statisticsResetTime), std::memory_order_relaxed);
 
 	while (shouldKeepRunning())
 	{
@@ -55,9 +88,17 @@ void ThreadPool::workerRoutine() noexcept
 				//Release the mutex before executing the task to allow other workers to grab tasks during execution
 				lock.unlock();
 
+				Clock::time_point executionStart = Clock::now();
+
 				task->execute();
 
+				lockStart = Clock::now();
+				counters.executionTime.fetch_add(getElapsedNanoseconds(executionStart, lockStart, _statisticsResetTime), std::memory_order_relaxed);
+				counters.executedTaskCount.fetch_add(1u, std::memory_order_relaxed);
+
 				lock.lock();
+
+				counters.taskMutexWaitTime.fetch_add(getElapsedNanoseconds(lockStart, Clock::now(), _statisticsResetTime), std::memory_order_relaxed);
 			}
 		}
 
@@ -66,8 +107,12 @@ void ThreadPool::workerRoutine() noexcept
 			//A worker is about to sleep, decrement working workers count
 			_workingWorkers.fetch_sub(1u);
 
+			Clock::time_point idleStart = Clock::now();
+
 			_taskCondition.wait(lock);
 
+			counters.idleTime.fetch_add(getElapsedNanoseconds(idleStart, Clock::now(), _statisticsResetTime), std::memory_order_relaxed);
+
 			//A worker is resuming its activity, increment working workers count
 			_workingWorkers.fetch_add(1u);
 		}
@@ -76,9 +121,13 @@ void ThreadPool::workerRoutine() noexcept
 
 std::shared_ptr<TaskBase> ThreadPool::getTask() noexcept
 {
+	uint64 scannedTaskCount = 0u;
+
 	//Iterate over all tasks
 	for (decltype(_tasks)::iterator it = _tasks.begin(); it != _tasks.end(); it++)
 	{
+		scannedTaskCount++;
+
 		//Get the first ready task
 		if ((*it)->isReadyToExecute())
 		{
@@ -86,13 +135,45 @@ std::shared_ptr<TaskBase> ThreadPool::getTask() noexcept
 
 			_tasks.erase(it);
 
+			recordReadinessScan(scannedTaskCount);
+
 			return result;
 		}
 	}
 
+	recordReadinessScan(scannedTaskCount);
+
 	return nullptr;
 }
 
+void ThreadPool::recordSubmittedTask(size_t queueLength) noexcept
+{
+	if (_currentThreadPool == this)
+	{
+		_workerCounters[_currentWorkerIndex].submittedTaskCount.fetch_add(1u, std::memory_order_relaxed);
+	}
+	else
+	{
+		_externalSubmittedTaskCount.fetch_add(1u, std::memory_order_relaxed);
+	}
+
+	if (queueLength > _queueLengthHighWaterMark.load(std::memory_order_relaxed))
+	{
+		_queueLengthHighWaterMark.store(queueLength, std::memory_order_relaxed);
+	}
+}
+
+void ThreadPool::recordReadinessScan(uint64 scannedTaskCount) noexcept
+{
+	_readinessScanCount.fetch_add(1u, std::memory_order_relaxed);
+	_scannedTaskCount.fetch_add(scannedTaskCount, std::memory_order_relaxed);
+
+	if (scannedTaskCount > _longestReadinessScan.load(std::memory_order_relaxed))
+	{
+		_longestReadinessScan.store(scannedTaskCount, std::memory_order_relaxed);
+	}
+}
+
 void ThreadPool::joinWorkers() noexcept
 {
 	std::unique_lock lock(_taskMutex);
@@ -145,4 +226,53 @@ void ThreadPool::setIsRunning(bool isRunning) noexcept
 			_taskCondition.notify_all();
 		}
 	}
+}
+
+uint32 ThreadPool::getWorkerCount() const noexcept
+{
+	return static_cast<uint32>(_workers.size());
+}
+
+ThreadPoolStatistics ThreadPool::getStatistics() const noexcept
+{
+	ThreadPoolStatistics result;
+
+	result.workers.resize(_workerCounters.size());
+
+	for (size_t i = 0u; i < _workerCounters.size(); i++)
+	{
+		result.workers[i].submittedTaskCount	= _workerCounters[i].submittedTaskCount.load(std::memory_order_relaxed);
+		result.workers[i].executedTaskCount		= _workerCounters[i].executedTaskCount.load(std::memory_order_relaxed);
+		result.workers[i].executionTime			= _workerCounters[i].executionTime.load(std::memory_order_relaxed);
+		result.workers[i].idleTime				= _workerCounters[i].idleTime.load(std::memory_order_relaxed);
+		result.workers[i].taskMutexWaitTime		= _workerCounters[i].taskMutexWaitTime.load(std::memory_order_relaxed);
+	}
+
+	result.externalSubmittedTaskCount	= _externalSubmittedTaskCount.load(std::memory_order_relaxed);
+	result.queueLengthHighWaterMark		= _queueLengthHighWaterMark.load(std::memory_order_relaxed);
+	result.readinessScanCount			= _readinessScanCount.load(std::memory_order_relaxed);
+	result.scannedTaskCount				= _scannedTaskCount.load(std::memory_order_relaxed);
+	result.longestReadinessScan			= _longestReadinessScan.load(std::memory_order_relaxed);
+
+	return result;
+}
+
+void ThreadPool::resetStatistics() noexcept
+{
+	_statisticsResetTime.store(Clock::now(), std::memory_order_relaxed);
+
+	for (WorkerCounters& counters : _workerCounters)
+	{
+		counters.submittedTaskCount.store(0u, std::memory_order_relaxed);
+		counters.executedTaskCount.store(0u, std::memory_order_relaxed);
+		counters.executionTime.store(0u, std::memory_order_relaxed);
+		counters.idleTime.store(0u, std::memory_order_relaxed);
+		counters.taskMutexWaitTime.store(0u, std::memory_order_relaxed);
+	}
+
+	_externalSubmittedTaskCount.store(0u, std::memory_order_relaxed);
+	_queueLengthHighWaterMark.store(0u, std::memory_order_relaxed);
+	_readinessScanCount.store(0u, std::memory_order_relaxed);
+	_scannedTaskCount.store(0u, std::memory_order_relaxed);
+	_longestReadinessScan.store(0u, std::memory_order_relaxed);
 }
\ No newline at end of file
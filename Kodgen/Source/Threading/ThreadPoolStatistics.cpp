@@ -0,0 +1,61 @@
+#include "Kodgen/Threading/ThreadPoolStatistics.h"
+
+using namespace kodgen;
+
+namespace
+{
+	/**
+	*	@brief Format a duration in seconds with millisecond precision.
+	*
+	*	@param nanoseconds The duration in nanoseconds.
+	*
+	*	@return The formatted duration.
+	*/
+	std::string formatDuration(uint64 nanoseconds) noexcept
+	{
+		uint64		milliseconds	= nanoseconds / 1000000u;
+		std::string	fraction		= std::to_string(milliseconds % 1000u);
+
+		return std::to_string(milliseconds / 1000u) + "." + std::string(3u - fraction.size(), '0') + fraction + "s";
+	}
+}
+
+uint64 ThreadPoolStatistics::getSubmittedTaskCount() const noexcept
+{
+	uint64 result = externalSubmittedTaskCount;
+
+	for (WorkerStatistics const& worker : workers)
+	{
+		result += worker.submittedTaskCount;
+	}
+
+	return result;
+}
+
+uint64 ThreadPoolStatistics::getExecutedTaskCount() const noexcept
+{
+	uint64 result = 0u;
+
+	for (WorkerStatistics const& worker : workers)
+	{
+		result += worker.executedTaskCount;
+	}
+
+	return result;
+}
+
+std::string ThreadPoolStatistics::toString() const noexcept
+{
+	std::string result = std::to_string(getSubmittedTaskCount()) + " task(s) submitted (" + std::to_string(externalSubmittedTaskCount) + " from outside the pool), " +
+						 std::to_string(getExecutedTaskCount()) + " executed, queue high-water mark: " + std::to_string(queueLengthHighWaterMark) + "\n" +
+						 std::to_string(readinessScanCount) + " readiness scan(s), " + std::to_string(scannedTaskCount) + " task(s) checked, longest scan: " + std::to_string(longestReadinessScan) + "\n";
+
+	for (size_t i = 0u; i < workers.size(); i++)
+	{
+		result += "Worker " + std::to_string(i) + ": " + std::to_string(workers[i].executedTaskCount) + " task(s) executed, " +
+				  std::to_string(workers[i].submittedTaskCount) + " submitted, executing " + formatDuration(workers[i].executionTime) +
+				  ", idle " + formatDuration(workers[i].idleTime) + ", waiting for the task mutex " + formatDuration(workers[i].taskMutexWaitTime) + "\n";
+	}
+
+	return result;
+}
\ No newline at end of file
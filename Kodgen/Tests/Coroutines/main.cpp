@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <Kodgen/Threading/ThreadPool.h>
+#include <Kodgen/Threading/TaskHelper.h>
+#include <Kodgen/Threading/AsyncTask.h>
+
+using namespace kodgen;
+
+//Simulate a file pipeline: parse on a worker, wait for a task of the C++17 API, then generate on another worker
+AsyncTask<std::string> generate(ThreadPool& threadPool, int parsedValue)
+{
+	co_await threadPool.schedule("Generation");
+
+	co_return "Generated " + std::to_string(parsedValue);
+}
+
+AsyncTask<std::string> processFile(ThreadPool& threadPool, int fileIndex)
+{
+	co_await threadPool.schedule("Parsing " + std::to_string(fileIndex));
+
+	int parsedValue = fileIndex * 2;
+
+	std::shared_ptr<TaskBase> macrosTask = threadPool.submitTask("Define macros", [](TaskBase*) -> int
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		return 1;
+	});
+
+	//Suspend until the regular task is finished without blocking the worker
+	std::vector<std::shared_ptr<TaskBase>> dependencies{ macrosTask };
+
+	co_await threadPool.schedule("Wait macros", std::move(dependencies));
+
+	parsedValue += TaskHelper::getResult<int>(macrosTask.get());
+
+	co_return co_await generate(threadPool, parsedValue);
+}
+
+AsyncTask<> runPipelines(ThreadPool& threadPool, bool& out_success)
+{
+	std::vector<AsyncTask<std::string>> pipelines;
+
+	for (int i = 0; i < 64; i++)
+	{
+		pipelines.emplace_back(processFile(threadPool, i));
+	}
+
+	std::vector<std::string> results = co_await AsyncTaskHelper::whenAll(std::move(pipelines));
+
+	out_success = results.size() == 64u;
+
+	for (int i = 0; i < static_cast<int>(results.size()); i++)
+	{
+		out_success &= results[i] == "Generated " + std::to_string(i * 2 + 1);
+	}
+
+	std::vector<AsyncTask<>> voidTasks;
+
+	for (int i = 0; i < 8; i++)
+	{
+		voidTasks.emplace_back([](ThreadPool& pool) -> AsyncTask<> { co_await pool.schedule(); }(threadPool));
+	}
+
+	co_await AsyncTaskHelper::whenAll(std::move(voidTasks));
+}
+
+int main()
+{
+	ThreadPool	threadPool(4u);
+	bool		success = false;
+
+	AsyncTaskHelper::syncWait(runPipelines(threadPool, success));
+
+	std::cout << "Coroutine pipelines " << (success ? "succeeded" : "failed") << std::endl;
+
+	return (success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
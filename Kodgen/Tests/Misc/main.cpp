@@ -0,0 +1,48 @@
+#include <iostream>
+#include <string>
+
+#include <Kodgen/Misc/Filesystem.h>
+
+using namespace kodgen;
+
+bool checkGlob(std::string const& path, std::string const& pattern, bool expectedResult)
+{
+	if (FilesystemHelpers::matchesGlob(path, pattern) != expectedResult)
+	{
+		std::cout << "matchesGlob(" << path << ", " << pattern << ") should be " << (expectedResult ? "true" : "false") << std::endl;
+
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	bool result = true;
+
+	//* and ? don't cross directories
+	result &= checkGlob("/project/Gameplay/Player.h", "/project/Gameplay/*.h", true);
+	result &= checkGlob("/project/Gameplay/Sub/Player.h", "/project/Gameplay/*.h", false);
+	result &= checkGlob("/project/Gameplay/A.h", "/project/Gameplay/?.h", true);
+	result &= checkGlob("/project/Gameplay/AB.h", "/project/Gameplay/?.h", false);
+	result &= checkGlob("/project/Gameplay/A.h", "/project/Gameplay?A.h", false);
+
+	//** crosses directories, and **/ also matches no directory at all
+	result &= checkGlob("/project/Gameplay/Sub/Deep/Player.h", "/project/Gameplay/**", true);
+	result &= checkGlob("/project/Gameplay/Player.h", "/project/Gameplay/**/Player.h", true);
+	result &= checkGlob("/project/Gameplay/Sub/Deep/Player.h", "/project/Gameplay/**/Player.h", true);
+	result &= checkGlob("/project/Gameplay/MyPlayer.h", "/project/Gameplay/**/Player.h", false);
+	result &= checkGlob("/project/Gameplay/Sub/Player.cpp", "/project/**/*.h", false);
+
+	//Relative patterns match at any directory level
+	result &= checkGlob("/project/Gameplay/Player.h", "Gameplay/**", true);
+	result &= checkGlob("/project/Engine/Gameplay.h", "Gameplay/**", false);
+	result &= checkGlob("/project/Gameplay/Player.h", "*.h", true);
+
+	//Separators are normalized
+	result &= checkGlob("C:\\project\\Gameplay\\Player.h", "Gameplay/*.h", true);
+	result &= checkGlob("/project/Gameplay/Player.h", "Gameplay\\*.h", true);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
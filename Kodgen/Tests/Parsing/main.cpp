@@ -0,0 +1,79 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Kodgen/Parsing/ParsingSettings.h>
+
+using namespace kodgen;
+
+bool checkSplit(std::string const& commandLine, std::vector<std::string> const& expectedArguments)
+{
+	if (ParsingSettings::splitArguments(commandLine) != expectedArguments)
+	{
+		std::cout << "Unexpected arguments for: " << commandLine << std::endl;
+
+		for (std::string const& argument : ParsingSettings::splitArguments(commandLine))
+		{
+			std::cout << "[" << argument << "]" << std::endl;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+int main()
+{
+	bool result = true;
+
+	//Whitespaces
+	result &= checkSplit("", {});
+	result &= checkSplit("  -DA \t -DB\n", { "-DA", "-DB" });
+
+	//Quotes
+	result &= checkSplit("-I\"C:/Program Files/Include\" -DA", { "-IC:/Program Files/Include", "-DA" });
+	result &= checkSplit("'-DNAME=\"value\"' \"it's\"", { "-DNAME=\"value\"", "it's" });
+	result &= checkSplit("\"\" -DA", { "", "-DA" });
+
+	//Escapes
+	result &= checkSplit("-DNAME=\\\"value\\\"", { "-DNAME=\"value\"" });
+	result &= checkSplit("-IProgram\\ Files \\'a\\'", { "-IProgram Files", "'a'" });
+	result &= checkSplit("\"-DA=\\\"b c\\\"\"", { "-DA=\"b c\"" });
+	result &= checkSplit("'-DA=\\'", { "-DA=\\" });
+
+	//Backslashes which don't escape anything are kept
+	result &= checkSplit("-IC:\\Include\\Dir \\\\server\\share", { "-IC:\\Include\\Dir", "\\\\server\\share" });
+
+	//Relative profile paths are relative to the settings file, not to the working directory
+	fs::path settingsDirectory = fs::temp_directory_path() / "KodgenParsingTests";
+
+	fs::create_directories(settingsDirectory);
+
+	{
+		std::ofstream settingsFile(settingsDirectory / "Settings.toml", std::ios::trunc);
+
+		settingsFile << "[ParsingSettings]\n"
+						"[[ParsingSettings.parseProfiles]]\n"
+						"name = \"Profile\"\n"
+						"stubIncludeDirectories = [\"Stubs\"]\n"
+						"precompiledHeader = \"Build/Profile.pch\"\n";
+	}
+
+	ParsingSettings settings;
+
+	if (!settings.loadFromFile(settingsDirectory / "Settings.toml") || settings.parseProfiles.size() != 1u ||
+		settings.parseProfiles[0].stubIncludeDirectories != std::vector<fs::path>{ settingsDirectory / "Stubs" } ||
+		settings.parseProfiles[0].precompiledHeader != settingsDirectory / "Build/Profile.pch")
+	{
+		std::cout << "Parse profile paths are not relative to the settings file." << std::endl;
+
+		result = false;
+	}
+
+	std::error_code errorCode;
+	fs::remove_all(settingsDirectory, errorCode);
+
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
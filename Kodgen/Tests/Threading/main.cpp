@@ -1,4 +1,6 @@
 #include <iostream>
+#include <thread>
+#include <chrono>
 
 #include <Kodgen/Threading/ThreadPool.h>
 #include <Kodgen/Threading/TaskHelper.h>
@@ -42,5 +44,57 @@ int main()
 	//A is not callable, doesn't compile
 	//auto t4 = threadPool.submitTask(A());
 
+	threadPool.joinWorkers();
+
+	//All tasks have been submitted from the main thread and executed by the workers
+	ThreadPoolStatistics statistics = threadPool.getStatistics();
+
+	std::cout << statistics.toString();
+
+	if (statistics.externalSubmittedTaskCount != 3u || statistics.getExecutedTaskCount() != 3u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Let the workers accumulate idle time before the reset, it must not be reported after the reset
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	std::chrono::steady_clock::time_point resetStart = std::chrono::steady_clock::now();
+
+	threadPool.resetStatistics();
+
+	statistics = threadPool.getStatistics();
+
+	if (statistics.externalSubmittedTaskCount != 0u || statistics.getExecutedTaskCount() != 0u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Wake all workers up so that they record their idle time, then run a task
+	threadPool.setIsRunning(false);
+	threadPool.setIsRunning(true);
+
+	threadPool.submitTask("After reset", [](TaskBase*) {});
+
+	threadPool.joinWorkers();
+
+	statistics = threadPool.getStatistics();
+
+	//Anything recorded since the reset can't last longer than the time elapsed since the reset, whatever the machine speed
+	uint64 elapsedSinceReset = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - resetStart).count());
+
+	if (statistics.externalSubmittedTaskCount != 1u || statistics.getExecutedTaskCount() != 1u)
+	{
+		return EXIT_FAILURE;
+	}
+
+	for (WorkerStatistics const& worker : statistics.workers)
+	{
+		if (worker.idleTime > elapsedSinceReset || worker.executionTime > elapsedSinceReset || worker.taskMutexWaitTime > elapsedSinceReset)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}